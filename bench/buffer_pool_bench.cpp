@@ -0,0 +1,175 @@
+#include "reactor.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+extern "C" {
+#include <sys/resource.h>
+#include <sys/wait.h>
+}
+
+using namespace net;
+
+
+namespace {
+
+std::atomic<std::size_t> allocations(0);
+
+const auto port             = 22070;
+const auto rounds           = 10;
+const std::size_t msgLen    = 512;
+const std::size_t maxEvents = 1024;
+
+// Sends a message on every connection and reads back its echo, round after
+// round, then closes them all.
+void drive(const std::size_t _connections)
+{
+    std::vector<Socket> clients;
+    clients.reserve(_connections);
+    for (std::size_t i = 0; i < _connections; ++i) {
+        clients.emplace_back(Domain::IPv4, Type::TCP);
+        clients.back().connect("127.0.0.1", port);
+    }
+
+    const std::string msg(msgLen, 'a');
+    char buf[msgLen];
+    for (auto r = 0; r < rounds; ++r) {
+        for (auto &c : clients) {
+            c.send(msg, Send::NOSIGNAL);
+        }
+        for (auto &c : clients) {
+            c.recv(buf, msgLen, Recv::WAITALL);
+        }
+    }
+}
+
+// Echoes on every connection until the client closed them all, counting the
+// allocations made by _echo alone.
+template <typename Echo>
+void serve(const char *_name, const Socket &_server,
+           const std::size_t _connections, Echo &&_echo)
+{
+    const auto client = fork();
+    if (client == 0) {
+        try {
+            drive(_connections);
+        } catch (std::exception &e) {
+            std::cerr << e.what() << '\n';
+        }
+        _exit(0);
+    }
+
+    Reactor reactor(maxEvents);
+    std::unordered_map<int, Socket> peers;
+    std::vector<Socket> accepted;
+    std::size_t closed = 0;
+    std::size_t echoes = 0;
+    std::size_t allocs = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    reactor.add(_server, Event::READ, [&](Event) {
+        _server.acceptMany(accepted, false);
+        for (auto &peer : accepted) {
+            const auto fd = peer.getSocket();
+            peers.emplace(fd, std::move(peer));
+            reactor.add(fd, Event::READ, [&, fd](Event) {
+                const auto before = allocations.load();
+                const auto recvd  = _echo(peers.at(fd));
+                allocs += allocations.load() - before;
+
+                if (recvd > 0) {
+                    ++echoes;
+                } else if (recvd == 0) {
+                    reactor.remove(fd);
+                    peers.erase(fd);
+                    ++closed;
+                }
+            });
+        }
+        accepted.clear();
+    });
+
+    while (closed < _connections) {
+        reactor.poll();
+    }
+    waitpid(client, nullptr, 0);
+
+    const std::chrono::duration<double> secs
+      = std::chrono::steady_clock::now() - start;
+    std::cout << _name << ": " << static_cast<double>(allocs) / echoes
+              << " allocations/echo, " << allocs << " in " << echoes
+              << " echoes, " << secs.count() << " s\n";
+}
+}
+
+
+void *operator new(std::size_t _size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (auto ptr = std::malloc(_size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *_ptr) noexcept { std::free(_ptr); }
+void operator delete(void *_ptr, std::size_t) noexcept { std::free(_ptr); }
+
+
+// Echo server over many connections, receiving each message into a new
+// std::string, then into a buffer borrowed from a BufferPool.
+// Usage: buffer_pool_bench [connections]
+int main(int argc, char *argv[])
+{
+    const std::size_t connections = (argc > 1) ? std::atoi(argv[1]) : 10000;
+
+    rlimit limit;
+    getrlimit(RLIMIT_NOFILE, &limit);
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
+    if (limit.rlim_cur < connections + 64) {
+        std::cerr << "descriptor limit " << limit.rlim_cur << " too low\n";
+        return 1;
+    }
+
+    try {
+        Socket server(Domain::IPv4, Type::TCP);
+        server.setOpt(Opt::REUSEADDR, SockOpt(1));
+        server.start("127.0.0.1", port, 65535);
+        server.setNonBlocking();
+
+        serve("recv(int) -> string", server, connections, [](Socket &s) {
+            auto errorNB   = false;
+            const auto msg = s.recv(msgLen, Recv::NONE, &errorNB);
+            if (errorNB) {
+                return -1;
+            }
+            s.send(msg, Send::NOSIGNAL, &errorNB);
+            return static_cast<int>(msg.size());
+        });
+
+        BufferPool pool;
+        serve("recv(BufferPool &, size_t)", server, connections,
+              [&pool](Socket &s) {
+                  auto errorNB   = false;
+                  const auto buf = s.recv(pool, msgLen, Recv::NONE, &errorNB);
+                  if (errorNB) {
+                      return -1;
+                  }
+                  s.send(buf.view(), Send::NOSIGNAL, &errorNB);
+                  return static_cast<int>(buf.size());
+              });
+
+        const auto stats = pool.stats();
+        std::cout << "pool: " << stats.slabBytes / 1024 << " KiB of slabs, "
+                  << stats.buffers << " buffers, " << stats.cached
+                  << " cached, " << stats.shared << " shared\n";
+    } catch (std::exception &e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+}
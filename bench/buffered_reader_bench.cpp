@@ -0,0 +1,79 @@
+#include "buffered_reader.hpp"
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace net;
+
+
+namespace {
+
+const auto lines   = 200000;
+const auto lineLen = 32;
+
+// Writes the lines from another thread while the line reader made by
+// _makeReader for the accepted connection consumes them.
+template <typename Fn>
+void run(const char *_name, Fn &&_makeReader)
+{
+    Socket server(Domain::UNIX, Type::TCP);
+    server.start("/tmp/netBufferedReaderBench");
+
+    std::thread writer([] {
+        Socket client(Domain::UNIX, Type::TCP);
+        client.connect("/tmp/netBufferedReaderBench");
+
+        std::string batch;
+        for (auto i = 0; i < 64; ++i) {
+            batch += std::string(lineLen - 1, 'a') + '\n';
+        }
+        for (auto i = 0; i < lines / 64; ++i) {
+            client.send(batch);
+        }
+    });
+
+    const auto peer  = server.accept();
+    auto read        = _makeReader(peer);
+    const auto start = std::chrono::steady_clock::now();
+
+    std::size_t bytes = 0;
+    for (auto i = 0; i < lines / 64 * 64; ++i) {
+        bytes += read();
+    }
+
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start);
+    writer.join();
+
+    std::cout << _name << ": " << ns.count() / lines << " ns/line, " << bytes
+              << " bytes\n";
+}
+}
+
+
+int main()
+{
+    try {
+        run("recv byte by byte", [](const Socket &s) {
+            return [&s] {
+                std::string line;
+                char c = 0;
+                while (c != '\n' && s.recv(&c, 1) == 1) {
+                    line += c;
+                }
+                return line.size();
+            };
+        });
+
+        run("BufferedReader::readUntil", [](const Socket &s) {
+            return [r = std::make_unique<BufferedReader>(s)] {
+                return r->readUntil('\n').size();
+            };
+        });
+    } catch (std::exception &e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+}
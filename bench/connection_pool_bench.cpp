@@ -0,0 +1,130 @@
+#include "connection_pool.hpp"
+#include "reactor.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+extern "C" {
+#include <signal.h>
+#include <sys/wait.h>
+}
+
+using namespace net;
+
+
+namespace {
+
+const auto port     = 22040;
+const auto requests = 5000;
+const auto msgLen   = 64;
+
+// Echo server, the same loop as the Reactor example.
+void serve(Socket &_server)
+{
+    Reactor reactor;
+    std::unordered_map<int, Socket> peers;
+    _server.setNonBlocking();
+
+    std::vector<Socket> accepted;
+    reactor.add(_server, Event::READ, [&](Event) {
+        _server.acceptMany(accepted, false);
+        for (auto &peer : accepted) {
+            const auto fd = peer.getSocket();
+            peers.emplace(fd, std::move(peer));
+            reactor.add(fd, Event::READ, [&, fd](Event) {
+                char buf[msgLen];
+                auto errorNB     = false;
+                const auto recvd = peers.at(fd).recv(buf, sizeof(buf),
+                                                     Recv::NONE, &errorNB);
+                if (errorNB) {
+                    return;
+                }
+                if (recvd <= 0) {
+                    reactor.remove(fd);
+                    peers.erase(fd);
+                    return;
+                }
+                peers.at(fd).send(buf, recvd, Send::NOSIGNAL, &errorNB);
+            });
+        }
+        accepted.clear();
+    });
+
+    reactor.run();
+}
+
+// One request: send a message and wait for the whole echo.
+void request(const Socket &_sock)
+{
+    static const std::string msg(msgLen, 'a');
+    char buf[msgLen];
+
+    _sock.send(msg);
+    _sock.recv(buf, sizeof(buf), Recv::WAITALL);
+}
+
+template <typename Fn>
+void run(const char *_name, Fn &&_fn)
+{
+    std::vector<double> latencies;
+    latencies.reserve(requests);
+
+    for (auto i = 0; i < requests; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        _fn();
+        const std::chrono::duration<double, std::micro> elapsed
+          = std::chrono::steady_clock::now() - start;
+        latencies.push_back(elapsed.count());
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    auto sum = 0.0;
+    for (auto l : latencies) {
+        sum += l;
+    }
+
+    std::cout << _name << ": mean " << sum / requests << " us, p50 "
+              << latencies[requests / 2] << " us, p99 "
+              << latencies[requests * 99 / 100] << " us\n";
+}
+}
+
+
+int main()
+{
+    try {
+        Socket server(Domain::IPv4, Type::TCP);
+        server.start("127.0.0.1", port, 1024);
+
+        const auto child = fork();
+        if (child == 0) {
+            try {
+                serve(server);
+            } catch (std::exception &e) {
+                std::cerr << e.what() << '\n';
+            }
+            std::exit(1);
+        }
+
+        std::cout << requests << " requests of " << msgLen << " byte echoes\n";
+
+        run("connect per request", [] {
+            Socket s(Domain::IPv4, Type::TCP);
+            s.connect("127.0.0.1", port);
+            request(s);
+        });
+
+        ConnectionPool pool(Domain::IPv4, 1);
+        auto &ep = pool.endpoint("127.0.0.1", port);
+        run("ConnectionPool", [&] { request(pool.acquire(ep).socket()); });
+
+        kill(child, SIGTERM);
+        waitpid(child, nullptr, 0);
+    } catch (std::exception &e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+}
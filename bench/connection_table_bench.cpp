@@ -0,0 +1,193 @@
+#include "connection_table.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+extern "C" {
+#include <sys/resource.h>
+}
+
+using namespace net;
+
+
+namespace {
+
+using Clock = ConnectionTable::Clock;
+
+const auto dispatchRounds = 10;
+const auto scanRounds     = 100;
+
+volatile std::size_t sink;
+
+struct Entry {
+    Socket socket;
+    std::uint8_t state;
+    Clock::time_point lastActive;
+};
+
+template <typename Fn>
+double nsPer(const std::size_t _ops, Fn &&_fn)
+{
+    const auto start = std::chrono::steady_clock::now();
+    _fn();
+    const std::chrono::duration<double, std::nano> ns
+      = std::chrono::steady_clock::now() - start;
+
+    return ns.count() / _ops;
+}
+
+void report(const char *_name, const double _insert, const double _dispatch,
+            const double _scan, const double _erase)
+{
+    std::cout << _name << ": insert " << _insert << " ns, dispatch "
+              << _dispatch << " ns, idle scan " << _scan << " ns, erase "
+              << _erase << " ns per connection\n";
+}
+
+std::vector<Socket> open(const std::size_t _n)
+{
+    std::vector<Socket> sockets;
+    sockets.reserve(_n);
+    for (std::size_t i = 0; i < _n; ++i) {
+        sockets.emplace_back(Domain::IPv4, Type::UDP);
+    }
+
+    return sockets;
+}
+
+void benchTable(std::vector<Socket> _sockets, const std::vector<int> &_order)
+{
+    const auto n = _sockets.size();
+    ConnectionTable table;
+
+    const auto insert = nsPer(n, [&] {
+        const auto now = Clock::now();
+        for (auto &s : _sockets) {
+            table.insert(std::move(s), 0, now);
+        }
+    });
+
+    const auto dispatch = nsPer(n * dispatchRounds, [&] {
+        for (auto r = 0; r < dispatchRounds; ++r) {
+            const auto now = Clock::now();
+            for (const auto fd : _order) {
+                const auto id = table.lookup(fd);
+                table.touch(id, now);
+                table.setState(id, 1);
+            }
+        }
+    });
+
+    // Nothing is idle that long, so only the scan itself is measured.
+    const auto scan = nsPer(n * scanRounds, [&] {
+        const auto before = Clock::now() - std::chrono::hours(1);
+        for (auto r = 0; r < scanRounds; ++r) {
+            sink = table.expire(before);
+        }
+    });
+
+    std::vector<Connection> removed;
+    removed.reserve(n);
+    const auto erase = nsPer(n, [&] {
+        for (const auto fd : _order) {
+            removed.push_back(table.release(table.lookup(fd)));
+        }
+    });
+
+    report("ConnectionTable", insert, dispatch, scan, erase);
+}
+
+void benchMap(std::vector<Socket> _sockets, const std::vector<int> &_order)
+{
+    const auto n = _sockets.size();
+    std::unordered_map<int, Entry> map;
+
+    const auto insert = nsPer(n, [&] {
+        const auto now = Clock::now();
+        for (auto &s : _sockets) {
+            const auto fd = s.getSocket();
+            map.emplace(fd, Entry{std::move(s), 0, now});
+        }
+    });
+
+    const auto dispatch = nsPer(n * dispatchRounds, [&] {
+        for (auto r = 0; r < dispatchRounds; ++r) {
+            const auto now = Clock::now();
+            for (const auto fd : _order) {
+                auto &e      = map.find(fd)->second;
+                e.lastActive = now;
+                e.state      = 1;
+            }
+        }
+    });
+
+    const auto scan = nsPer(n * scanRounds, [&] {
+        const auto before = Clock::now() - std::chrono::hours(1);
+        for (auto r = 0; r < scanRounds; ++r) {
+            std::size_t idle = 0;
+            for (const auto &kv : map) {
+                idle += kv.second.lastActive < before;
+            }
+            sink = idle;
+        }
+    });
+
+    std::vector<Socket> removed;
+    removed.reserve(n);
+    const auto erase = nsPer(n, [&] {
+        for (const auto fd : _order) {
+            const auto it = map.find(fd);
+            removed.push_back(std::move(it->second.socket));
+            map.erase(it);
+        }
+    });
+
+    report("unordered_map<int, Socket>", insert, dispatch, scan, erase);
+}
+}
+
+
+// Connection table of an event loop, as a ConnectionTable and as a
+// std::unordered_map<int, Socket> keyed by descriptor with the state and
+// activity time beside each Socket: insertion, dispatch of readiness events
+// by descriptor in random order, scans for idle connections and removal.
+// Closing the descriptors is left out of the timings.
+// Usage: connection_table_bench [connections]
+int main(int argc, char *argv[])
+{
+    const std::size_t connections = (argc > 1) ? std::atoi(argv[1]) : 100000;
+
+    rlimit limit;
+    getrlimit(RLIMIT_NOFILE, &limit);
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
+    if (limit.rlim_cur < connections + 64) {
+        std::cerr << "descriptor limit " << limit.rlim_cur << " too low\n";
+        return 1;
+    }
+
+    try {
+        std::mt19937 rng(42);
+        for (auto pass = 0; pass < 2; ++pass) {
+            auto sockets = open(connections);
+            std::vector<int> order;
+            for (const auto &s : sockets) {
+                order.push_back(s.getSocket());
+            }
+            std::shuffle(order.begin(), order.end(), rng);
+
+            if (pass == 0) {
+                benchTable(std::move(sockets), order);
+            } else {
+                benchMap(std::move(sockets), order);
+            }
+        }
+    } catch (std::exception &e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+}
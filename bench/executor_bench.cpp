@@ -0,0 +1,54 @@
+#include "executor.hpp"
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+using namespace net;
+
+
+namespace {
+
+const auto jobs = 20000;
+
+// Short jobs, like handlers answering a single request.
+template <typename Submit>
+void run(const char *_name, Submit &&_submit)
+{
+    std::atomic<int> done(0);
+    const auto start = std::chrono::steady_clock::now();
+
+    for (auto i = 0; i < jobs; ++i) {
+        _submit([&done] { ++done; });
+    }
+    while (done < jobs) {
+        std::this_thread::yield();
+    }
+
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start);
+    std::cout << _name << ": " << ns.count() / jobs << " ns/job\n";
+}
+}
+
+
+int main()
+{
+    try {
+        run("std::thread per job, detached", [](auto &&_job) {
+            std::thread(std::move(_job)).detach();
+        });
+
+        Executor executor;
+        run("Executor", [&](auto &&_job) { executor.submit(std::move(_job)); });
+
+        // Jobs submitting jobs stay on the deque of their worker.
+        run("Executor, submitted from a job", [&](auto &&_job) {
+            executor.submit([&executor, job = std::move(_job) ]() mutable {
+                executor.submit(std::move(job));
+            });
+        });
+    } catch (std::exception &e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+}
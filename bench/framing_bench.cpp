@@ -0,0 +1,103 @@
+#include "framing.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include <arpa/inet.h>
+}
+
+using namespace net;
+
+
+namespace {
+
+const auto path       = "/tmp/netFramingBench";
+const auto totalBytes = std::size_t(1) << 28;
+const auto maxFrames  = std::size_t(1) << 20;
+
+// Two send calls per frame, the way callers frame messages without a codec.
+void writePlain(const Socket &_sock, const std::string &_payload,
+                const std::size_t _frames)
+{
+    const auto len = htonl(static_cast<std::uint32_t>(_payload.size()));
+    for (std::size_t i = 0; i < _frames; ++i) {
+        _sock.send(reinterpret_cast<const char *>(&len), sizeof(len));
+        _sock.send(_payload);
+    }
+}
+
+void readPlain(const Socket &_sock, const std::size_t _frames)
+{
+    std::vector<char> payload;
+    for (std::size_t i = 0; i < _frames; ++i) {
+        std::uint32_t len;
+        _sock.recv(reinterpret_cast<char *>(&len), sizeof(len), Recv::WAITALL);
+        payload.resize(ntohl(len));
+        _sock.recv(payload.data(), payload.size(), Recv::WAITALL);
+    }
+}
+
+void writeFramed(const Socket &_sock, const std::string &_payload,
+                 const std::size_t _frames)
+{
+    FrameWriter writer(_sock);
+    for (std::size_t i = 0; i < _frames; ++i) {
+        writer.write(_payload);
+    }
+    writer.flush();
+}
+
+void readFramed(const Socket &_sock, const std::size_t _frames)
+{
+    FrameReader reader(_sock);
+    StringView payload;
+    for (std::size_t i = 0; i < _frames; ++i) {
+        reader.read(payload);
+    }
+}
+
+template <typename W, typename R>
+double run(const std::size_t _size, W &&_write, R &&_read)
+{
+    const auto frames = std::min(totalBytes / _size, maxFrames);
+
+    Socket server(Domain::UNIX, Type::TCP);
+    server.start(path);
+
+    std::thread writer([&] {
+        Socket client(Domain::UNIX, Type::TCP);
+        client.connect(path);
+        _write(client, std::string(_size, 'a'), frames);
+    });
+
+    const auto peer  = server.accept();
+    const auto start = std::chrono::steady_clock::now();
+    _read(peer, frames);
+    const std::chrono::duration<double> elapsed
+      = std::chrono::steady_clock::now() - start;
+    writer.join();
+
+    return frames / elapsed.count();
+}
+}
+
+
+int main()
+{
+    try {
+        for (std::size_t size : {64, 1024, 65536}) {
+            std::cout << size << " byte frames: two sends "
+                      << static_cast<long>(run(size, writePlain, readPlain))
+                      << " msgs/s, FrameWriter/FrameReader "
+                      << static_cast<long>(run(size, writeFramed, readFramed))
+                      << " msgs/s\n";
+        }
+    } catch (std::exception &e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+}
@@ -0,0 +1,75 @@
+#include "hdr_histogram.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace net;
+
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const std::size_t samples = 10000000;
+
+template <typename Record, typename Report>
+void run(const char *_name, const std::vector<std::uint64_t> &_values,
+         Record &&_record, Report &&_report)
+{
+    const auto start = Clock::now();
+    for (const auto v : _values) {
+        _record(v);
+    }
+    const auto recorded = Clock::now();
+    const auto bytes    = _report();
+    const auto end      = Clock::now();
+
+    using ns = std::chrono::nanoseconds;
+    std::cout << _name << ": "
+              << std::chrono::duration_cast<ns>(recorded - start).count()
+                / static_cast<double>(_values.size())
+              << " ns/record, "
+              << std::chrono::duration_cast<ns>(end - recorded).count() / 1e6
+              << " ms for p50/p99/p99.9, " << bytes / 1024 << " KiB\n";
+}
+}
+
+
+// Latencies of requests, recorded as samples kept in a vector and as a
+// histogram.
+int main()
+{
+    std::mt19937_64 gen(42);
+    std::lognormal_distribution<double> latency(11, 1);
+
+    std::vector<std::uint64_t> values(samples);
+    for (auto &v : values) {
+        v = static_cast<std::uint64_t>(latency(gen));
+    }
+
+    std::vector<std::uint64_t> kept;
+    run("std::vector of samples", values,
+        [&](const std::uint64_t _v) { kept.push_back(_v); },
+        [&] {
+            for (const auto p : {50.0, 99.0, 99.9}) {
+                const auto nth = kept.begin() + p / 100 * (kept.size() - 1);
+                std::nth_element(kept.begin(), nth, kept.end());
+            }
+            return kept.capacity() * sizeof(std::uint64_t);
+        });
+
+    HdrHistogram hist;
+    run("HdrHistogram", values,
+        [&](const std::uint64_t _v) { hist.record(_v); },
+        [&] {
+            for (const auto p : {50.0, 99.0, 99.9}) {
+                static_cast<void>(hist.percentile(p));
+            }
+            return hist.bucketCount() * sizeof(std::uint64_t);
+        });
+
+    std::cout << "HdrHistogram serialized: " << hist.serialize().size()
+              << " bytes\n";
+}
@@ -0,0 +1,103 @@
+#include "socket.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using namespace net;
+
+
+namespace {
+
+// Counts the complete responses at the start of _buf and drops them, noting
+// in _close if the server announced it closes the connection.
+std::size_t takeResponses(std::string &_buf, bool &_close)
+{
+    std::size_t count = 0;
+    std::size_t pos   = 0;
+
+    while (true) {
+        const auto head = _buf.find("\r\n\r\n", pos);
+        if (head == std::string::npos) {
+            break;
+        }
+
+        const auto field = _buf.find("Content-Length: ", pos);
+        const auto body  = (field < head)
+          ? std::strtoul(&_buf[field + 16], nullptr, 10)
+          : 0;
+        if (_buf.size() < head + 4 + body) {
+            break;
+        }
+
+        _close = _close || _buf.find("Connection: close", pos) < head;
+        pos    = head + 4 + body;
+        ++count;
+    }
+
+    _buf.erase(0, pos);
+    return count;
+}
+}
+
+
+// Sends GET requests to a server on 127.0.0.1, _depth pipelined at a time,
+// reconnecting whenever the server closes the connection, and reports the
+// responses per second. Compare socket_http_fixed_server on port 8000 with
+// socket_http_keepalive_server on port 8001.
+int main(int argc, char *argv[])
+{
+    const auto port    = (argc > 1) ? std::atoi(argv[1]) : 8001;
+    const auto depth   = (argc > 2) ? std::atoi(argv[2]) : 1;
+    const auto seconds = (argc > 3) ? std::atoi(argv[3]) : 5;
+
+    std::string batch;
+    for (auto i = 0; i < depth; ++i) {
+        batch += "GET / HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+    }
+
+    try {
+        const auto start    = std::chrono::steady_clock::now();
+        const auto deadline = start + std::chrono::seconds(seconds);
+
+        std::size_t responses   = 0;
+        std::size_t connections = 0;
+        std::string buf;
+        char chunk[65536];
+
+        while (std::chrono::steady_clock::now() < deadline) {
+            Socket s(Domain::IPv4, Type::TCP);
+            s.connect("127.0.0.1", port);
+            ++connections;
+            buf.clear();
+
+            auto close = false;
+            while (!close && std::chrono::steady_clock::now() < deadline) {
+                if (s.trySend(batch, Send::NOSIGNAL).bytes() != batch.size()) {
+                    break;
+                }
+
+                std::size_t got = 0;
+                while (!close && got < static_cast<std::size_t>(depth)) {
+                    // A server closing early may reset the connection.
+                    const auto res = s.tryRecv(chunk, sizeof(chunk));
+                    if (res.bytes() == 0) {
+                        close = true;
+                        break;
+                    }
+                    buf.append(chunk, res.bytes());
+                    got += takeResponses(buf, close);
+                }
+                responses += got;
+            }
+        }
+
+        const std::chrono::duration<double> elapsed
+          = std::chrono::steady_clock::now() - start;
+        std::cout << static_cast<long>(responses / elapsed.count())
+                  << " requests/s over " << connections << " connections\n";
+    } catch (std::exception &e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+}
@@ -0,0 +1,195 @@
+#include "hdr_histogram.hpp"
+#include "socket.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include <pthread.h>
+#include <sched.h>
+}
+
+using namespace net;
+
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const char serverPath[] = "/tmp/netLatencyBenchServer";
+const char clientPath[] = "/tmp/netLatencyBenchClient";
+const auto serverPort   = 22060;
+const auto clientPort   = 22061;
+const auto warmup       = 1000;
+
+struct Transport {
+    const char *name;
+    Domain domain;
+    Type type;
+    const char *addr;
+};
+
+const Transport transports[] = {
+  {"IPv4 TCP", Domain::IPv4, Type::TCP, "127.0.0.1"},
+  {"IPv6 TCP", Domain::IPv6, Type::TCP, "::1"},
+  {"UNIX TCP", Domain::UNIX, Type::TCP, serverPath},
+  {"IPv4 UDP", Domain::IPv4, Type::UDP, "127.0.0.1"},
+  {"IPv6 UDP", Domain::IPv6, Type::UDP, "::1"},
+  {"UNIX UDP", Domain::UNIX, Type::UDP, serverPath},
+  {"IPv4 SEQPACKET", Domain::IPv4, Type::SEQPACKET, "127.0.0.1"},
+  {"IPv6 SEQPACKET", Domain::IPv6, Type::SEQPACKET, "::1"},
+  {"UNIX SEQPACKET", Domain::UNIX, Type::SEQPACKET, serverPath},
+};
+
+void pin(const int _cpu)
+{
+    if (_cpu < 0) {
+        return;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(_cpu, &set);
+    const auto res = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (res != 0) {
+        throw std::runtime_error(net::methods::getErrorMsg(res));
+    }
+}
+
+bool stream(const Transport &_t) { return _t.type != Type::UDP; }
+
+// Echoes messages until the client closes, or sends an empty datagram.
+void echo(const Socket &_server, const Transport &_t, const std::size_t _size,
+          const int _cpu)
+{
+    pin(_cpu);
+    std::vector<char> buf(_size);
+
+    if (!stream(_t)) {
+        while (_server.recv(buf.data(), _size) > 0) {
+            _server.send(buf.data(), _size);
+        }
+        return;
+    }
+
+    const auto peer = _server.accept();
+    while (peer.recv(buf.data(), _size, Recv::WAITALL) > 0) {
+        peer.send(buf.data(), _size, Send::NOSIGNAL);
+    }
+}
+
+HdrHistogram run(const Transport &_t, const std::size_t _size,
+              const int _iterations, const int _clientCpu, const int _serverCpu)
+{
+    if (_t.domain == Domain::UNIX) {
+        ::unlink(serverPath);
+        ::unlink(clientPath);
+    }
+
+    Socket server(_t.domain, _t.type);
+    server.setOpt(Opt::REUSEADDR, SockOpt(1));
+    server.start(_t.addr, serverPort);
+
+    // Datagram sockets are connected both ways, so the echo needs no
+    // address of the client.
+    Socket client(_t.domain, _t.type);
+    const auto clientAddr
+      = (_t.domain == Domain::UNIX) ? clientPath : _t.addr;
+    if (!stream(_t)) {
+        client.start(clientAddr, clientPort);
+        server.connect(clientAddr, clientPort);
+    }
+    client.connect(_t.addr, serverPort);
+
+    std::thread echoer([&] {
+        try {
+            echo(server, _t, _size, _serverCpu);
+        } catch (std::exception &e) {
+            std::cerr << e.what() << '\n';
+        }
+    });
+
+    auto finish = [&] {
+        if (stream(_t)) {
+            client.stop(Shut::WRITE);
+        } else {
+            client.send("");
+        }
+        echoer.join();
+    };
+
+    HdrHistogram hist;
+    const std::string msg(_size, 'a');
+    std::vector<char> buf(_size);
+    const auto flags = stream(_t) ? Recv::WAITALL : Recv::NONE;
+
+    // A datagram lost on the way would otherwise block forever.
+    client.setOpt(Opt::RCVTIMEO, SockOpt(1L, 0L));
+
+    try {
+        pin(_clientCpu);
+        for (auto i = -warmup; i < _iterations; ++i) {
+            const auto start = Clock::now();
+            client.send(msg, Send::NOSIGNAL);
+
+            auto errorNB = false;
+            if (client.recv(buf.data(), _size, flags, &errorNB)
+                  != static_cast<ssize_t>(_size)
+                || errorNB) {
+                throw std::runtime_error("Echo lost");
+            }
+            const auto rtt = Clock::now() - start;
+
+            if (i >= 0) {
+                hist.record(
+                  std::chrono::duration_cast<std::chrono::nanoseconds>(rtt)
+                    .count());
+            }
+        }
+    } catch (...) {
+        finish();
+        throw;
+    }
+
+    finish();
+    return hist;
+}
+}
+
+
+// Measures round trips of a message echoed over loopback, for every
+// transport. Usage: latency_bench [iterations] [size] [clientCpu serverCpu]
+// where the CPUs, if given, pin the client and the server threads.
+int main(int argc, char *argv[])
+{
+    const auto iterations = (argc > 1) ? std::atoi(argv[1]) : 100000;
+    const auto size
+      = static_cast<std::size_t>((argc > 2) ? std::atoi(argv[2]) : 64);
+    const auto clientCpu = (argc > 4) ? std::atoi(argv[3]) : -1;
+    const auto serverCpu = (argc > 4) ? std::atoi(argv[4]) : -1;
+
+    std::cout << iterations << " round trips of " << size
+              << " bytes, in microseconds\n"
+              << std::left << std::setw(16) << "transport" << std::right
+              << std::setw(10) << "p50" << std::setw(10) << "p99"
+              << std::setw(10) << "p99.9" << std::setw(10) << "max" << '\n'
+              << std::fixed << std::setprecision(2);
+
+    for (const auto &t : transports) {
+        std::cout << std::left << std::setw(16) << t.name << std::right;
+        try {
+            const auto h = run(t, size, iterations, clientCpu, serverCpu);
+            for (const auto p : {50.0, 99.0, 99.9}) {
+                std::cout << std::setw(10) << h.percentile(p) / 1e3;
+            }
+            std::cout << std::setw(10) << h.maximum() / 1e3 << '\n';
+        } catch (std::exception &e) {
+            std::cout << "  " << e.what() << '\n';
+        }
+    }
+}
@@ -0,0 +1,146 @@
+#include "reactor.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+extern "C" {
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+}
+
+using namespace net;
+
+
+namespace {
+
+const auto port   = 22020;
+const auto rounds = 10;
+const auto msgLen = 64;
+
+// Echo server holding every connection in one Reactor.
+void serve()
+{
+    Reactor reactor(1024);
+    std::unordered_map<int, Socket> peers;
+
+    Socket server(Domain::IPv4, Type::TCP);
+    server.start("127.0.0.1", port, 65535);
+    server.setNonBlocking();
+
+    std::vector<Socket> accepted;
+    reactor.add(server, Event::READ, [&](Event) {
+        server.acceptMany(accepted, false);
+        for (auto &peer : accepted) {
+            const auto fd = peer.getSocket();
+            peers.emplace(fd, std::move(peer));
+            reactor.add(fd, Event::READ, [&, fd](Event) {
+                char buf[msgLen];
+                auto errorNB     = false;
+                const auto recvd = peers.at(fd).recv(buf, sizeof(buf),
+                                                     Recv::NONE, &errorNB);
+                if (errorNB) {
+                    return;
+                }
+                if (recvd <= 0) {
+                    reactor.remove(fd);
+                    peers.erase(fd);
+                    return;
+                }
+                peers.at(fd).send(buf, recvd, Send::NOSIGNAL, &errorNB);
+            });
+        }
+        accepted.clear();
+    });
+
+    reactor.run();
+}
+
+double seconds(std::chrono::steady_clock::time_point _start)
+{
+    const std::chrono::duration<double> elapsed
+      = std::chrono::steady_clock::now() - _start;
+    return elapsed.count();
+}
+}
+
+
+int main(int argc, char *argv[])
+{
+    const std::size_t connections = (argc > 1) ? std::atoi(argv[1]) : 10000;
+
+    // Each process holds one descriptor per connection plus a few.
+    rlimit limit;
+    getrlimit(RLIMIT_NOFILE, &limit);
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
+    if (limit.rlim_cur < connections + 64) {
+        std::cerr << "descriptor limit " << limit.rlim_cur << " too low\n";
+        return 1;
+    }
+
+    const auto server = fork();
+    if (server == 0) {
+        try {
+            serve();
+        } catch (std::exception &e) {
+            std::cerr << e.what() << '\n';
+        }
+        return 1;
+    }
+
+    try {
+        std::vector<Socket> clients;
+        clients.reserve(connections);
+        usleep(200000);
+
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < connections; ++i) {
+            clients.emplace_back(Domain::IPv4, Type::TCP);
+            clients.back().connect("127.0.0.1", port);
+        }
+        std::cout << connections << " connections established in "
+                  << seconds(start) << " s\n";
+
+        Reactor reactor(1024);
+        std::size_t replies = 0;
+        for (auto &c : clients) {
+            c.setNonBlocking();
+            reactor.add(c, Event::READ, [&](Event) {
+                char buf[msgLen];
+                auto errorNB = false;
+                if (c.recv(buf, sizeof(buf), Recv::NONE, &errorNB) > 0) {
+                    ++replies;
+                }
+            });
+        }
+
+        const std::string msg(msgLen, 'a');
+        start = std::chrono::steady_clock::now();
+        for (auto r = 0; r < rounds; ++r) {
+            for (auto &c : clients) {
+                auto errorNB = false;
+                c.send(msg, Send::NOSIGNAL, &errorNB);
+            }
+            while (replies < connections * (r + 1)) {
+                reactor.poll();
+            }
+        }
+
+        const auto secs = seconds(start);
+        std::cout << rounds << " rounds of " << connections
+                  << " echoes: " << secs / rounds * 1000 << " ms/round, "
+                  << static_cast<long>(replies / secs) << " echoes/s\n";
+
+        // Close the client side first so the server port skips TIME_WAIT.
+        clients.clear();
+        usleep(500000);
+    } catch (std::exception &e) {
+        std::cerr << e.what() << '\n';
+    }
+
+    kill(server, SIGTERM);
+    waitpid(server, nullptr, 0);
+}
@@ -0,0 +1,68 @@
+#include "socket.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace net;
+
+
+namespace {
+
+const auto iterations = 100000;
+
+// Every thread receives on its own unconnected Socket, so each call fails
+// with ENOTCONN; the failure path is all that is measured.
+template <typename Fn>
+void run(const char *_name, const unsigned _threads, Fn &&_recv)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < _threads; ++t) {
+        workers.emplace_back([&] {
+            Socket s(Domain::IPv4, Type::TCP);
+            char buf[64];
+            for (auto i = 0; i < iterations; ++i) {
+                _recv(s, buf, sizeof(buf));
+            }
+        });
+    }
+    for (auto &w : workers) {
+        w.join();
+    }
+
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start);
+
+    std::cout << _name << ", " << _threads << " threads: "
+              << ns.count() / (iterations * _threads) << " ns/failed call\n";
+}
+}
+
+
+int main()
+{
+    try {
+        const auto cores = std::max(std::thread::hardware_concurrency(), 1u);
+
+        for (auto threads : {1u, cores}) {
+            run("recv throwing runtime_error", threads,
+                [](const Socket &s, char *b, std::size_t n) {
+                    try {
+                        s.recv(b, n);
+                    } catch (std::runtime_error &) {
+                    }
+                });
+
+            run("tryRecv returning IoResult", threads,
+                [](const Socket &s, char *b, std::size_t n) {
+                    return s.tryRecv(b, n).error();
+                });
+        }
+    } catch (std::exception &e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+}
@@ -0,0 +1,88 @@
+#include "socket.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+using namespace net;
+
+
+namespace {
+
+std::atomic<std::size_t> allocations(0);
+
+const auto iterations = 200000;
+const auto msgLen     = 64;
+const std::string msg(msgLen, 'a');
+
+template <typename Fn>
+void run(const char *_name, const Socket &_client, const Socket &_peer,
+         Fn &&_recv)
+{
+    std::size_t before = 0;
+    const auto start   = std::chrono::steady_clock::now();
+
+    for (auto i = 0; i < iterations; ++i) {
+        _client.write(msg);
+        if (i == 0) {
+            // The first call may grow a reusable buffer; count steady state.
+            _recv(_peer);
+            before = allocations.load();
+            continue;
+        }
+        _recv(_peer);
+    }
+
+    const auto end    = std::chrono::steady_clock::now();
+    const auto allocs = allocations.load() - before;
+    const auto ns
+      = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+
+    std::cout << _name << ": "
+              << static_cast<double>(allocs) / (iterations - 1)
+              << " allocations/call, " << ns.count() / iterations
+              << " ns/call (write + recv)\n";
+}
+}
+
+
+void *operator new(std::size_t _size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (auto ptr = std::malloc(_size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *_ptr) noexcept { std::free(_ptr); }
+void operator delete(void *_ptr, std::size_t) noexcept { std::free(_ptr); }
+
+
+int main()
+{
+    try {
+        Socket server(Domain::UNIX, Type::TCP);
+        server.start("/tmp/netRecvAllocBench");
+
+        Socket client(Domain::UNIX, Type::TCP);
+        client.connect("/tmp/netRecvAllocBench");
+        const auto peer = server.accept();
+
+        run("recv(int) -> string", client, peer,
+            [](const Socket &s) { return s.recv(msgLen).size(); });
+
+        char buf[msgLen];
+        run("recv(char *, size_t)", client, peer,
+            [&](const Socket &s) { return s.recv(buf, sizeof(buf)); });
+
+        std::string reused;
+        run("recv(string &, int)", client, peer,
+            [&](const Socket &s) { return s.recv(reused, msgLen); });
+
+    } catch (std::exception &e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+}
@@ -0,0 +1,116 @@
+#include "socket.hpp"
+#include <chrono>
+#include <iostream>
+
+using namespace net;
+
+
+namespace {
+
+const auto batchSize = 64u;
+const auto msgLen    = 64u;
+const auto numMsgs   = 500000u;
+const auto queued    = 256u;
+const std::string msg(msgLen, 'a');
+
+using Clock = std::chrono::steady_clock;
+
+auto addr(AddrIPv4 &s) { return methods::construct(s, "127.0.0.1", 22000); }
+
+void report(const char *_name, const std::size_t _pkts, Clock::duration _d)
+{
+    const auto secs = std::chrono::duration<double>(_d).count();
+    std::cout << _name << ": " << static_cast<std::size_t>(_pkts / secs)
+              << " packets/sec\n";
+}
+
+void benchSend(const Socket &_client)
+{
+    auto start = Clock::now();
+    for (auto i = 0u; i < numMsgs; ++i) {
+        _client.send(msg, addr);
+    }
+    report("send  sendto per datagram  ", numMsgs, Clock::now() - start);
+
+    DatagramBatch<AddrIPv4> batch(batchSize);
+    for (auto i = 0u; i < batchSize; ++i) {
+        batch.push(msg, addr);
+    }
+
+    start = Clock::now();
+    for (auto i = 0u; i < numMsgs; i += batchSize) {
+        _client.sendmmsg(batch);
+    }
+    report("send  sendmmsg batch of 64 ", numMsgs, Clock::now() - start);
+}
+
+/*
+ * Queues datagrams on the server socket and times only draining them, so
+ * the receive path is measured without being limited by the sender.
+ */
+template <typename Drain>
+void benchRecv(const char *_name, const Socket &_client, const Socket &_server,
+               Drain &&_drain)
+{
+    DatagramBatch<AddrIPv4> batch(batchSize);
+    for (auto i = 0u; i < batchSize; ++i) {
+        batch.push(msg, addr);
+    }
+
+    std::size_t pkts = 0;
+    Clock::duration elapsed(0);
+
+    while (pkts < numMsgs) {
+        for (auto i = 0u; i < queued; i += batchSize) {
+            _client.sendmmsg(batch);
+        }
+
+        const auto start = Clock::now();
+        pkts += _drain(_server);
+        elapsed += Clock::now() - start;
+    }
+
+    report(_name, pkts, elapsed);
+}
+}
+
+
+int main()
+{
+    try {
+        Socket server(Domain::IPv4, Type::UDP);
+        server.setOpt(Opt::RCVBUF, SockOpt(8 * 1024 * 1024));
+        server.start("127.0.0.1", 22000);
+
+        Socket client(Domain::IPv4, Type::UDP);
+
+        benchSend(client);
+
+        benchRecv("recv  recvfrom per datagram", client, server,
+                  [](const Socket &s) {
+                      char buf[msgLen];
+                      bool errorNB     = false;
+                      std::size_t pkts = 0;
+                      while (s.recv(buf, sizeof(buf), [](AddrIPv4 &) {},
+                                    Recv::DONTWAIT, &errorNB)
+                             >= 0) {
+                          ++pkts;
+                      }
+                      return pkts;
+                  });
+
+        DatagramBatch<AddrIPv4> batch(batchSize, msgLen);
+        benchRecv("recv  recvmmsg batch of 64 ", client, server,
+                  [&](const Socket &s) {
+                      bool errorNB     = false;
+                      std::size_t pkts = 0;
+                      while (!errorNB) {
+                          pkts += s.recvmmsg(batch, Recv::DONTWAIT, &errorNB);
+                      }
+                      return pkts;
+                  });
+    } catch (std::exception &e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+}
@@ -0,0 +1,96 @@
+#include "socket.hpp"
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace net;
+
+
+namespace {
+
+const auto port      = 22010;
+const auto totalSize = std::size_t(256) * 1024 * 1024;
+const auto inFlight  = 64;
+
+// Drains every connection accepted until the client closes it.
+void sink(Socket &_server)
+{
+    std::vector<char> buf(1 << 20);
+    while (true) {
+        const auto peer = _server.accept();
+        while (peer.read(buf.data(), buf.size()) > 0) {
+        }
+    }
+}
+
+double run(const std::size_t _size, const bool _zeroCopy, bool &_copied)
+{
+    Socket client(Domain::IPv4, Type::TCP);
+    client.connect("127.0.0.1", port);
+    client.setOpt(Opt::ZEROCOPY, SockOpt(1));
+    client.setOpt(Opt::NODELAY, SockOpt(1));
+
+    // Zero-copy buffers may only be reused once completed, so rotate
+    // through a few of them like a real sender would.
+    std::array<std::string, inFlight> bufs;
+    std::array<std::uint32_t, inFlight> ids;
+    bufs.fill(std::string(_size, 'z'));
+
+    // A threshold above every size makes sendZeroCopy a plain copying send.
+    ZeroCopy zc(_zeroCopy ? 0 : -1);
+    ids.fill(-1);
+
+    const auto count = totalSize / _size;
+    const auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto slot = i % inFlight;
+        while (_zeroCopy && !zc.isComplete(ids[slot])) {
+            client.pollZeroCopy(zc);
+        }
+        ids[slot] = client.sendZeroCopy(zc, bufs[slot]);
+    }
+    while (zc.pending() != 0) {
+        client.pollZeroCopy(zc);
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+    _copied        = zc.copied();
+    const auto secs
+      = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+    return count * _size / secs.count() / (1024 * 1024);
+}
+}
+
+
+int main()
+{
+    try {
+        Socket server(Domain::IPv4, Type::TCP);
+        server.start("127.0.0.1", port);
+        std::thread(sink, std::ref(server)).detach();
+
+        // On loopback the kernel copies anyway and reports it, so zero-copy
+        // only adds the cost of pinning pages and reading completions. Run
+        // across a real NIC to see the crossover.
+        std::cout << "size\tcopy MB/s\tzerocopy MB/s\n";
+        for (std::size_t size = 1024; size <= 1024 * 1024; size *= 4) {
+            auto copied     = false;
+            const auto copy = run(size, false, copied);
+            const auto zero = run(size, true, copied);
+            std::cout << size << '\t' << static_cast<long>(copy) << "\t\t"
+                      << static_cast<long>(zero)
+                      << (zero > copy ? "\t(zero-copy wins)" : "")
+                      << (copied ? "\t(kernel copied)" : "") << std::endl;
+        }
+
+        ZeroCopy zc;
+        std::cout << "ZeroCopy default threshold: " << zc.getThreshold()
+                  << " bytes\n";
+    } catch (std::exception &e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+}
@@ -0,0 +1,204 @@
+#include "socket.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace net;
+
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const char unixPath[] = "/tmp/netThroughputBench";
+const auto port       = 22050;
+
+struct Transport {
+    const char *domainName;
+    const char *typeName;
+    Domain domain;
+    Type type;
+    const char *addr;
+};
+
+const Transport transports[] = {
+  {"IPv4", "TCP", Domain::IPv4, Type::TCP, "127.0.0.1"},
+  {"IPv6", "TCP", Domain::IPv6, Type::TCP, "::1"},
+  {"UNIX", "TCP", Domain::UNIX, Type::TCP, unixPath},
+  {"IPv4", "UDP", Domain::IPv4, Type::UDP, "127.0.0.1"},
+  {"IPv6", "UDP", Domain::IPv6, Type::UDP, "::1"},
+  {"UNIX", "UDP", Domain::UNIX, Type::UDP, unixPath},
+  {"IPv4", "SEQPACKET", Domain::IPv4, Type::SEQPACKET, "127.0.0.1"},
+  {"IPv6", "SEQPACKET", Domain::IPv6, Type::SEQPACKET, "::1"},
+  {"UNIX", "SEQPACKET", Domain::UNIX, Type::SEQPACKET, unixPath},
+};
+
+// Datagrams of every transport fit the largest size.
+const std::size_t sizes[] = {64, 512, 4096, 32768};
+
+struct Result {
+    std::size_t sent     = 0;
+    std::size_t received = 0;
+    std::size_t bytes    = 0;
+    double seconds       = 0;
+};
+
+// _str as the contents of a JSON string: quotes, backslashes and control
+// characters escaped.
+std::string jsonEscape(const char *_str)
+{
+    static const char hex[] = "0123456789abcdef";
+    std::string out;
+
+    for (; *_str != '\0'; ++_str) {
+        const auto c = static_cast<unsigned char>(*_str);
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += *_str;
+        } else if (c < 0x20) {
+            out += "\\u00";
+            out += hex[c >> 4];
+            out += hex[c & 0xf];
+        } else {
+            out += *_str;
+        }
+    }
+
+    return out;
+}
+
+// Receives on the server side until the sender shuts down its connection,
+// or for datagrams, until it is done and nothing arrived for 200ms.
+void receive(const Socket &_server, const Transport &_t,
+             const std::size_t _size, const std::atomic<bool> &_done,
+             Result &_res)
+{
+    std::vector<char> buf(_size);
+
+    if (_t.type == Type::UDP) {
+        _server.setOpt(Opt::RCVTIMEO, SockOpt(0L, 200000L));
+        while (true) {
+            auto errorNB     = false;
+            const auto recvd = _server.recv(buf.data(), _size, Recv::NONE,
+                                            &errorNB);
+            if (errorNB) {
+                if (_done) {
+                    return;
+                }
+                continue;
+            }
+            _res.bytes += recvd;
+            ++_res.received;
+        }
+    }
+
+    const auto peer = _server.accept();
+    while (true) {
+        const auto recvd = peer.recv(buf.data(), _size);
+        if (recvd <= 0) {
+            break;
+        }
+        _res.bytes += recvd;
+    }
+}
+
+Result run(const Transport &_t, const std::size_t _size, const double _seconds)
+{
+    if (_t.domain == Domain::UNIX) {
+        ::unlink(unixPath);
+    }
+
+    Socket server(_t.domain, _t.type);
+    server.setOpt(Opt::REUSEADDR, SockOpt(1));
+    server.start(_t.addr, port);
+
+    // Connected before the receiver starts, so it never waits in accept
+    // for a client that failed.
+    Socket client(_t.domain, _t.type);
+    client.connect(_t.addr, port);
+
+    Result res;
+    std::atomic<bool> done(false);
+    std::thread receiver([&] {
+        try {
+            receive(server, _t, _size, done, res);
+        } catch (std::exception &e) {
+            std::cerr << e.what() << '\n';
+        }
+    });
+
+    const std::string msg(_size, 'a');
+    const auto duration = std::chrono::duration<double>(_seconds);
+    const auto start    = Clock::now();
+
+    try {
+        while (Clock::now() - start < duration) {
+            for (auto i = 0; i < 64; ++i) {
+                client.send(msg, Send::NOSIGNAL);
+            }
+            res.sent += 64;
+        }
+    } catch (...) {
+        client.stop(Shut::WRITE);
+        done = true;
+        receiver.join();
+        throw;
+    }
+
+    client.stop(Shut::WRITE);
+    done = true;
+    receiver.join();
+    res.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    // Stream receives may split and merge messages, so they are counted in
+    // bytes there.
+    if (_t.type != Type::UDP) {
+        res.received = res.bytes / _size;
+    }
+    return res;
+}
+}
+
+
+// Streams messages of every size over every transport on loopback for the
+// given seconds each, printing JSON with the throughput seen by the
+// receiver; datagrams the receiver dropped count as sent, not received.
+int main(int argc, char *argv[])
+{
+    const auto seconds = (argc > 1) ? std::atof(argv[1]) : 1.0;
+
+    std::cout << "{\n  \"seconds\": " << seconds << ",\n  \"results\": [";
+
+    auto first = true;
+    for (const auto &t : transports) {
+        for (const auto size : sizes) {
+            std::ostringstream entry;
+            entry << "\n    {\"domain\": \"" << t.domainName
+                  << "\", \"type\": \"" << t.typeName
+                  << "\", \"size\": " << size;
+
+            try {
+                const auto r = run(t, size, seconds);
+                entry << ", \"sent\": " << r.sent
+                      << ", \"received\": " << r.received
+                      << ", \"gbytes_per_sec\": "
+                      << r.bytes / r.seconds / 1e9
+                      << ", \"msgs_per_sec\": " << r.received / r.seconds
+                      << "}";
+            } catch (std::exception &e) {
+                // Such as IPv4 and IPv6 SEQPACKET, which need SCTP.
+                entry << ", \"error\": \"" << jsonEscape(e.what()) << "\"}";
+            }
+
+            std::cout << (first ? "" : ",") << entry.str() << std::flush;
+            first = false;
+        }
+    }
+
+    std::cout << "\n  ]\n}\n";
+}
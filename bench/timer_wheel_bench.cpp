@@ -0,0 +1,122 @@
+#include "timer_wheel.hpp"
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace net;
+
+
+namespace {
+
+const std::size_t connections = 1000000;
+const std::uint64_t idleTicks = 30000;
+
+// Idle timeouts of connections as they were kept before, ordered in a
+// multimap and found again through the iterator each connection keeps.
+struct MapTimers {
+    using Map = std::multimap<std::uint64_t, std::size_t>;
+
+    Map timers;
+    std::vector<Map::iterator> entries;
+    std::uint64_t now = 0;
+
+    MapTimers() : entries(connections, timers.end()) {}
+
+    void touch(const std::size_t _conn)
+    {
+        if (entries[_conn] != timers.end()) {
+            timers.erase(entries[_conn]);
+        }
+        entries[_conn] = timers.emplace(now + idleTicks, _conn);
+    }
+
+    std::size_t advance(const std::uint64_t _ticks)
+    {
+        now += _ticks;
+
+        std::size_t fired = 0;
+        while (!timers.empty() && timers.begin()->first <= now) {
+            entries[timers.begin()->second] = timers.end();
+            timers.erase(timers.begin());
+            ++fired;
+        }
+        return fired;
+    }
+};
+
+struct WheelTimers {
+    TimerWheel wheel;
+    std::unique_ptr<Timer[]> timers;
+
+    WheelTimers() : timers(new Timer[connections]) {}
+
+    void touch(const std::size_t _conn)
+    {
+        wheel.scheduleTicks(timers[_conn], idleTicks);
+    }
+
+    std::size_t advance(const std::uint64_t _ticks)
+    {
+        return wheel.advance(_ticks);
+    }
+};
+
+// Every connection is touched once when accepted, then on activity, in
+// random order while time passes, and finally all of them time out.
+template <typename Timers>
+void run(const char *_name, const std::vector<std::size_t> &_activity)
+{
+    using clock = std::chrono::steady_clock;
+    Timers timers;
+
+    const auto report = [&](const char *_op, clock::time_point _start,
+                            const std::size_t _ops) {
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          clock::now() - _start);
+        std::cout << _name << ' ' << _op << ": " << ns.count() / _ops
+                  << " ns/op\n";
+    };
+
+    auto start = clock::now();
+    for (std::size_t c = 0; c < connections; ++c) {
+        timers.touch(c);
+    }
+    report("schedule", start, connections);
+
+    start = clock::now();
+    for (std::size_t i = 0; i < _activity.size(); ++i) {
+        timers.touch(_activity[i]);
+        if (i % 1000 == 999) {
+            timers.advance(1);
+        }
+    }
+    report("reschedule", start, _activity.size());
+
+    start            = clock::now();
+    const auto fired = timers.advance(2 * idleTicks);
+    report("expire", start, fired);
+}
+}
+
+
+int main()
+{
+    try {
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<std::size_t> pick(0, connections - 1);
+
+        std::vector<std::size_t> activity(4 * connections);
+        for (auto &a : activity) {
+            a = pick(gen);
+        }
+
+        run<MapTimers>("std::multimap", activity);
+        run<WheelTimers>("TimerWheel", activity);
+    } catch (std::exception &e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+}
@@ -0,0 +1,178 @@
+#include "reactor.hpp"
+#include "uring.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+extern "C" {
+#include <signal.h>
+#include <sys/wait.h>
+}
+
+using namespace net;
+
+
+namespace {
+
+const auto port        = 22030;
+const auto rounds      = 200;
+const auto msgLen      = 64;
+const auto connections = 1000;
+
+// Echo server over epoll, the same loop as the Reactor example.
+void serveReactor(Socket &_server)
+{
+    Reactor reactor(1024);
+    std::unordered_map<int, Socket> peers;
+    _server.setNonBlocking();
+
+    reactor.add(_server, Event::READ, [&](Event) {
+        while (true) {
+            auto errorNB = false;
+            auto peer    = _server.accept(&errorNB);
+            if (errorNB) {
+                return;
+            }
+
+            const auto fd = peer.getSocket();
+            peer.setNonBlocking();
+            peers.emplace(fd, std::move(peer));
+            reactor.add(fd, Event::READ, [&, fd](Event) {
+                char buf[msgLen];
+                auto errorNB     = false;
+                const auto recvd = peers.at(fd).recv(buf, sizeof(buf),
+                                                     Recv::NONE, &errorNB);
+                if (errorNB) {
+                    return;
+                }
+                if (recvd <= 0) {
+                    reactor.remove(fd);
+                    peers.erase(fd);
+                    return;
+                }
+                peers.at(fd).send(buf, recvd, Send::NOSIGNAL, &errorNB);
+            });
+        }
+    });
+
+    reactor.run();
+}
+
+// Echo server over io_uring. User data packs the operation, the provided
+// buffer being sent back and the descriptor.
+void serveUring(Socket &_server)
+{
+    enum : std::uint64_t { ACCEPT, RECV, SEND, CLOSE };
+    const auto pack = [](std::uint64_t op, std::uint64_t bid, int fd) {
+        return op << 56 | bid << 32 | static_cast<std::uint32_t>(fd);
+    };
+
+    Uring ring(4096);
+    ring.provideBuffers(4096, msgLen);
+    ring.accept(_server, pack(ACCEPT, 0, 0));
+
+    while (true) {
+        ring.submit(1);
+        ring.complete([&](const Uring::Completion &c) {
+            const auto fd = static_cast<int>(c.data & 0xffffffff);
+            switch (c.data >> 56) {
+                case ACCEPT: ring.recv(c.res, pack(RECV, 0, c.res)); break;
+
+                case RECV:
+                    if (c.res <= 0) {
+                        ring.recycle(c);
+                        ring.close(fd, pack(CLOSE, 0, fd));
+                        break;
+                    }
+                    // Send straight from the provided buffer, recycle later.
+                    ring.send(fd, ring.buffer(c).data(), c.res,
+                              pack(SEND, c.buffer(), fd));
+                    if (!c.more()) {
+                        ring.recv(fd, pack(RECV, 0, fd));
+                    }
+                    break;
+
+                case SEND:
+                    ring.recycle(static_cast<std::uint16_t>(c.data >> 32));
+                    break;
+            }
+        });
+    }
+}
+
+double run(void (*_serve)(Socket &))
+{
+    Socket server(Domain::IPv4, Type::TCP);
+    server.start("127.0.0.1", port, connections);
+
+    const auto child = fork();
+    if (child == 0) {
+        try {
+            _serve(server);
+        } catch (std::exception &e) {
+            std::cerr << e.what() << '\n';
+        }
+        std::exit(1);
+    }
+
+    std::vector<Socket> clients;
+    clients.reserve(connections);
+    for (auto i = 0; i < connections; ++i) {
+        clients.emplace_back(Domain::IPv4, Type::TCP);
+        clients.back().connect("127.0.0.1", port);
+    }
+
+    Reactor reactor(1024);
+    std::size_t replies = 0;
+    for (auto &c : clients) {
+        c.setNonBlocking();
+        reactor.add(c, Event::READ, [&](Event) {
+            char buf[msgLen];
+            auto errorNB = false;
+            if (c.recv(buf, sizeof(buf), Recv::NONE, &errorNB) > 0) {
+                ++replies;
+            }
+        });
+    }
+
+    const std::string msg(msgLen, 'a');
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t r = 0; r < rounds; ++r) {
+        for (auto &c : clients) {
+            auto errorNB = false;
+            c.send(msg, Send::NOSIGNAL, &errorNB);
+        }
+        while (replies < connections * (r + 1)) {
+            reactor.poll();
+        }
+    }
+    const std::chrono::duration<double> elapsed
+      = std::chrono::steady_clock::now() - start;
+
+    // Close the client side first so the server port skips TIME_WAIT.
+    clients.clear();
+    usleep(500000);
+    kill(child, SIGTERM);
+    waitpid(child, nullptr, 0);
+
+    return replies / elapsed.count();
+}
+}
+
+
+int main()
+{
+    try {
+        std::cout << connections << " connections, " << rounds << " rounds of "
+                  << msgLen << " byte echoes\n";
+        std::cout << "epoll Reactor: " << static_cast<long>(run(serveReactor))
+                  << " echoes/s\n";
+        std::cout << "io_uring: " << static_cast<long>(run(serveUring))
+                  << " echoes/s\n";
+    } catch (std::exception &e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+}
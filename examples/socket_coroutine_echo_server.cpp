@@ -0,0 +1,57 @@
+#include "async_socket.hpp"
+#include <iostream>
+#include <memory>
+
+using namespace net;
+
+
+namespace {
+
+// Written like the handler of socket_tcp_mt_server, but every connection
+// is a coroutine on the one thread running the Reactor.
+Task echo(std::unique_ptr<AsyncSocket> _peer)
+{
+    try {
+        char buf[4096];
+        while (true) {
+            const auto recvd = co_await _peer->asyncRecv(buf, sizeof(buf));
+            if (recvd == 0) {
+                break;
+            }
+            co_await _peer->asyncSend(buf, recvd);
+        }
+    } catch (std::exception &e) {
+        std::cerr << e.what() << '\n';
+    }
+}
+
+Task serve(Reactor &_reactor, AsyncSocket &_server)
+{
+    try {
+        while (true) {
+            auto peer = co_await _server.asyncAccept();
+            echo(std::make_unique<AsyncSocket>(_reactor, std::move(peer)));
+        }
+    } catch (std::exception &e) {
+        std::cerr << e.what() << '\n';
+        _reactor.stop();
+    }
+}
+}
+
+
+int main()
+{
+    try {
+        Reactor reactor;
+
+        Socket s(Domain::IPv4, Type::TCP);
+        s.start("127.0.0.1", 24001);
+        AsyncSocket server(reactor, std::move(s));
+
+        serve(reactor, server);
+        reactor.run();
+    } catch (std::exception &e) {
+        std::cerr << e.what() << '\n';
+    }
+}
@@ -9,15 +9,17 @@ int main()
         Socket s(Domain::IPv4, Type::TCP);
         s.start("127.0.0.1", 8000);
 
-        std::string response = "HTTP/1.1 200 OK\r\n";
-        response += "Content-Type: text/plain\r\n";
-        response += "Content-Length: 11\r\n";
-        response += "Connection: close\r\n";
-        response += "\r\nHello World";
+        const std::string body = "Hello World";
+
+        std::string header = "HTTP/1.1 200 OK\r\n";
+        header += "Content-Type: text/plain\r\n";
+        header += "Content-Length: " + std::to_string(body.size()) + "\r\n";
+        header += "Connection: close\r\n";
+        header += "\r\n";
 
         while (1) {
             const auto peer = s.accept();
-            peer.send(response);
+            peer.sendmsg({ header, body });
         }
     } catch (std::exception &e) {
         std::cerr << e.what() << '\n';
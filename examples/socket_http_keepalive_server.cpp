@@ -0,0 +1,141 @@
+#include "buffered_reader.hpp"
+#include "http_parser.hpp"
+#include "reactor.hpp"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace net;
+
+
+namespace {
+
+// Requests are parsed in place from the receive buffer of their connection.
+struct Connection {
+    Socket sock;
+    BufferedReader reader;
+    HttpParser parser;
+
+    explicit Connection(Socket &&_sock)
+        : sock(std::move(_sock)), reader(sock, 16384)
+    {
+    }
+};
+
+std::string response(const std::string &_status, const std::string &_body,
+                     const bool _keepAlive)
+{
+    std::string r = "HTTP/1.1 " + _status + "\r\n";
+    r += "Content-Type: text/plain\r\n";
+    r += "Content-Length: " + std::to_string(_body.size()) + "\r\n";
+    r += _keepAlive ? "Connection: keep-alive\r\n" : "Connection: close\r\n";
+    r += "\r\n";
+    return r + _body;
+}
+}
+
+
+int main()
+{
+    try {
+        Reactor reactor;
+        std::unordered_map<int, std::unique_ptr<Connection>> conns;
+
+        Socket s(Domain::IPv4, Type::TCP);
+        s.start("127.0.0.1", 8001);
+        s.setNonBlocking();
+
+        const auto okKeepAlive = response("200 OK", "Hello World", true);
+        const auto okClose     = response("200 OK", "Hello World", false);
+        const auto badRequest  = response("400 Bad Request", "", false);
+        const auto unsupported = response("501 Not Implemented", "", false);
+        const auto tooLarge
+          = response("431 Request Header Fields Too Large", "", false);
+
+        auto drop = [&](const int fd) {
+            reactor.remove(fd);
+            conns.erase(fd);
+        };
+
+        HttpRequest req;
+        std::string out;
+
+        auto serve = [&](const int fd) {
+            auto &c  = *conns.at(fd);
+            auto end = false;
+            out.clear();
+
+            try {
+                auto errorNB = false;
+                if (!c.reader.receive(&errorNB)) {
+                    if (!errorNB) {
+                        drop(fd);
+                    }
+                    return;
+                }
+
+                // Answer every request received so far, pipelined or not,
+                // with a single send.
+                while (!end) {
+                    const auto status = c.parser.parse(c.reader.peek(), req);
+
+                    if (status == HttpStatus::INVALID
+                        || status == HttpStatus::UNSUPPORTED) {
+                        out += (status == HttpStatus::INVALID) ? badRequest
+                                                               : unsupported;
+                        end = true;
+                        break;
+                    }
+
+                    const auto len = req.headLength() + req.contentLength();
+                    if (status == HttpStatus::PARTIAL
+                        || c.reader.buffered() < len) {
+                        if (c.reader.buffered() == c.reader.capacity()
+                            || len > c.reader.capacity()) {
+                            out += tooLarge;
+                            end = true;
+                        }
+                        break;
+                    }
+
+                    end = !req.keepAlive();
+                    out += end ? okClose : okKeepAlive;
+                    c.reader.consume(len);
+                }
+
+                // out is shared by all connections and nothing is kept to
+                // finish a send later, so a send that would block ends the
+                // connection.
+                if (!out.empty()) {
+                    c.sock.send(out, Send::NOSIGNAL, &errorNB);
+                    end = end || errorNB;
+                }
+            } catch (std::exception &e) {
+                std::cerr << e.what() << '\n';
+                end = true;
+            }
+
+            if (end) {
+                drop(fd);
+            }
+        };
+
+        std::vector<Socket> accepted;
+        reactor.add(s, Event::READ, [&](Event) {
+            s.acceptMany(accepted, false);
+            for (auto &peer : accepted) {
+                const auto fd = peer.getSocket();
+                conns.emplace(fd,
+                              std::make_unique<Connection>(std::move(peer)));
+                reactor.add(fd, Event::READ, [&, fd](Event) { serve(fd); });
+            }
+            accepted.clear();
+        });
+
+        reactor.run();
+    } catch (std::exception &e) {
+        std::cerr << e.what() << '\n';
+    }
+}
@@ -0,0 +1,75 @@
+#include "reactor.hpp"
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+using namespace net;
+
+
+int main()
+{
+    try {
+        Reactor reactor;
+        std::unordered_map<int, Socket> peers;
+
+        Socket s(Domain::IPv4, Type::TCP);
+        s.start("127.0.0.1", 24001);
+        s.setNonBlocking();
+
+        auto drop = [&](const int fd) {
+            reactor.remove(fd);
+            peers.erase(fd);
+        };
+
+        auto echo = [&](const int fd, Event ev) {
+            if (hasEvent(ev, Event::HANGUP | Event::ERROR)) {
+                drop(fd);
+                return;
+            }
+
+            const auto &peer = peers.at(fd);
+            char buf[4096];
+
+            // Edge-triggered, so drain until the socket would block.
+            try {
+                while (true) {
+                    auto errorNB     = false;
+                    const auto recvd = peer.recv(buf, sizeof(buf), Recv::NONE,
+                                                 &errorNB);
+                    if (errorNB) {
+                        return;
+                    }
+                    if (recvd <= 0) {
+                        break;
+                    }
+
+                    // A peer not reading its replies fills the send buffer;
+                    // such a slow consumer is dropped, not buffered for.
+                    peer.send(buf, recvd, Send::NOSIGNAL, &errorNB);
+                    if (errorNB) {
+                        break;
+                    }
+                }
+            } catch (std::exception &e) {
+                std::cerr << e.what() << '\n';
+            }
+            drop(fd);
+        };
+
+        std::vector<Socket> accepted;
+        reactor.add(s, Event::READ, [&](Event) {
+            s.acceptMany(accepted, false);
+            for (auto &peer : accepted) {
+                const auto fd = peer.getSocket();
+                peers.emplace(fd, std::move(peer));
+                reactor.add(fd, Event::READ | Event::EDGE,
+                            [&, fd](Event ev) { echo(fd, ev); });
+            }
+            accepted.clear();
+        });
+
+        reactor.run();
+    } catch (std::exception &e) {
+        std::cerr << e.what() << '\n';
+    }
+}
@@ -0,0 +1,38 @@
+#include "socket.hpp"
+#include <iostream>
+
+extern "C" {
+#include <sys/stat.h>
+}
+
+using namespace net;
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <file>\n";
+        return 1;
+    }
+
+    try {
+        const auto fd = open(argv[1], O_RDONLY | O_CLOEXEC);
+        struct stat st;
+        if (fd < 0 || fstat(fd, &st) < 0) {
+            throw std::runtime_error(methods::getErrorMsg(errno));
+        }
+
+        Socket s(Domain::IPv4, Type::TCP);
+        s.start("127.0.0.1", 8000);
+
+        const auto header = "HTTP/1.1 200 OK\r\nContent-Length: "
+          + std::to_string(st.st_size) + "\r\nConnection: close\r\n\r\n";
+
+        while (1) {
+            const auto peer = s.accept();
+            peer.send(header, Send::NOSIGNAL);
+            peer.sendFile(fd, 0, st.st_size);
+        }
+    } catch (std::exception &e) {
+        std::cerr << e.what() << '\n';
+    }
+}
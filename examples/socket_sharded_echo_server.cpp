@@ -0,0 +1,59 @@
+#include "sharded_server.hpp"
+#include <iostream>
+#include <memory>
+#include <unordered_map>
+
+using namespace net;
+
+
+int main()
+{
+    try {
+        // One listener, loop and pinned thread per core.
+        ShardedServer server(Domain::IPv4, "127.0.0.1", 24001);
+        std::cout << "Running " << server.size() << " shards\n";
+
+        server.run([](Reactor &r, Socket &s, std::size_t) {
+            // Per shard state, only touched by the thread of the shard.
+            auto peers = std::make_shared<std::unordered_map<int, Socket>>();
+
+            r.add(s, Event::READ, [&r, &s, peers](Event) {
+                auto errorNB = false;
+                auto peer    = s.accept(&errorNB);
+                if (errorNB) {
+                    return;
+                }
+
+                const auto fd = peer.getSocket();
+                peer.setNonBlocking();
+                peers->emplace(fd, std::move(peer));
+
+                r.add(fd, Event::READ, [&r, peers, fd](Event) {
+                    char buf[4096];
+                    auto errorNB = false;
+                    auto recvd   = ssize_t(0);
+                    try {
+                        recvd = peers->at(fd).recv(buf, sizeof(buf),
+                                                   Recv::NONE, &errorNB);
+                        if (errorNB) {
+                            return;
+                        }
+                        if (recvd > 0) {
+                            peers->at(fd).send(buf, recvd, Send::NOSIGNAL,
+                                               &errorNB);
+                        }
+                    } catch (std::exception &) {
+                        recvd = -1;
+                    }
+
+                    if (recvd <= 0 || errorNB) {
+                        r.remove(fd);
+                        peers->erase(fd);
+                    }
+                });
+            });
+        });
+    } catch (std::exception &e) {
+        std::cerr << e.what() << '\n';
+    }
+}
@@ -1,25 +1,13 @@
-#include "socket.hpp"
+#include "executor.hpp"
 #include <iostream>
-#include <thread>
-#include <functional>
-#include <condition_variable>
 
 using namespace net;
 
-std::mutex m;
-std::condition_variable cv;
-bool accepted = false;
 
-
-void worker_thread(Socket &s)
+void handle(Socket &peer)
 {
     try {
-        const auto peer = s.accept();
-        std::unique_lock<std::mutex> lock(m);
-        accepted = true;
-        lock.unlock();
-        cv.notify_one();
-        std::cout << peer.recv(10) << '\n';
+        std::cout << peer.recv(10) + '\n';
     } catch (std::exception &e) {
         std::cerr << e.what() << '\n';
     }
@@ -32,11 +20,11 @@ int main()
         Socket s(Domain::IPv4, Type::TCP);
         s.start("127.0.0.1", 24001);
 
+        // The workers are started once; every accepted connection is handed
+        // over to one of them.
+        Executor executor;
         while (true) {
-            std::thread(worker_thread, std::ref(s)).detach();
-            std::unique_lock<std::mutex> lock(m);
-            cv.wait(lock, [] { return accepted; });
-            accepted = false;
+            executor.submit(s.accept(), handle);
         }
     } catch (std::exception &e) {
         std::cerr << e.what() << '\n';
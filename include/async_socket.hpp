@@ -0,0 +1,251 @@
+#ifndef ASYNC_SOCKET_HPP
+#define ASYNC_SOCKET_HPP
+
+#if __cplusplus < 202002L
+#error "async_socket.hpp needs C++20 coroutines, compile with -std=c++20"
+#endif
+
+#include "reactor.hpp"
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <optional>
+
+
+namespace net {
+
+/**
+* @class net::Task
+* @desc Return type of a coroutine started by calling it and left to run on
+* its own, such as a connection handler. It runs up to its first suspension
+* before the call returns and frees itself when it finishes. Like the
+* function of a std::thread, it must not let exceptions escape, which
+* terminate the program.
+*/
+class Task final {
+public:
+    struct promise_type {
+        Task get_return_object() const noexcept { return Task(); }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+
+/**
+* @class net::AsyncSocket
+* @desc Socket made non-blocking and registered with a Reactor, whose
+* accept, recv, send and connect are awaited by coroutines:
+* auto peer = co_await server.asyncAccept(). Every operation is tried
+* right away; only when it would block does the coroutine suspend, to be
+* resumed from Reactor::poll once the operation completed. One coroutine at
+* a time may wait for reading and one for writing. Errors throw
+* runtime_error exception from co_await, like the blocking calls.
+* The AsyncSocket must outlive the operations awaited on it and be
+* destroyed on the thread running its Reactor.
+*/
+class AsyncSocket final {
+    class Operation {
+        friend class AsyncSocket;
+
+    protected:
+        AsyncSocket &owner;
+        IoResult result;
+        std::coroutine_handle<> handle;
+
+        explicit Operation(AsyncSocket &_owner) noexcept : owner(_owner) {}
+        ~Operation() = default;
+
+        // Tries the system call, false if it would block.
+        virtual bool attempt() noexcept = 0;
+
+        void check() const;
+
+    public:
+        bool await_ready() noexcept { return attempt(); }
+    };
+
+    Reactor &reactor;
+    Socket sock;
+    Operation *reader = nullptr;
+    Operation *writer = nullptr;
+
+    AsyncSocket(const AsyncSocket &) = delete;
+    AsyncSocket &operator=(const AsyncSocket &) = delete;
+
+    void wait(Operation *&, Operation &, std::coroutine_handle<>);
+    void ready(Event) noexcept;
+
+
+public:
+    class AcceptOp final : public Operation {
+        friend class AsyncSocket;
+
+        std::optional<Socket> peer;
+
+        explicit AcceptOp(AsyncSocket &_owner) noexcept : Operation(_owner) {}
+        bool attempt() noexcept override;
+
+    public:
+        void await_suspend(std::coroutine_handle<> _h)
+        {
+            owner.wait(owner.reader, *this, _h);
+        }
+        Socket await_resume();
+    };
+
+    class RecvOp final : public Operation {
+        friend class AsyncSocket;
+
+        char *buf;
+        std::size_t len;
+
+        RecvOp(AsyncSocket &_owner, char *_buf, std::size_t _len) noexcept
+            : Operation(_owner), buf(_buf), len(_len)
+        {
+        }
+        bool attempt() noexcept override;
+
+    public:
+        void await_suspend(std::coroutine_handle<> _h)
+        {
+            owner.wait(owner.reader, *this, _h);
+        }
+        std::size_t await_resume() const;
+    };
+
+    class SendOp final : public Operation {
+        friend class AsyncSocket;
+
+        const char *msg;
+        std::size_t len;
+        std::size_t sent = 0;
+
+        SendOp(AsyncSocket &_owner, const char *_msg,
+               std::size_t _len) noexcept
+            : Operation(_owner), msg(_msg), len(_len)
+        {
+        }
+        bool attempt() noexcept override;
+
+    public:
+        void await_suspend(std::coroutine_handle<> _h)
+        {
+            owner.wait(owner.writer, *this, _h);
+        }
+        void await_resume() const { check(); }
+    };
+
+    class ConnectOp final : public Operation {
+        friend class AsyncSocket;
+
+        const char *addr;
+        int port;
+        bool started = false;
+
+        ConnectOp(AsyncSocket &_owner, const char _addr[], int _port) noexcept
+            : Operation(_owner), addr(_addr), port(_port)
+        {
+        }
+        bool attempt() noexcept override;
+
+    public:
+        void await_suspend(std::coroutine_handle<> _h)
+        {
+            owner.wait(owner.writer, *this, _h);
+        }
+        void await_resume() const { check(); }
+    };
+
+
+    /**
+    * @construct net::AsyncSocket
+    * @access public
+    * @desc Makes _sock non-blocking and registers it with _reactor if
+    * successful else throws runtime_error exception.
+    *
+    * @param {Reactor} _reactor Reactor resuming the awaiting coroutines.
+    * @param {Socket} _sock Socket to take over.
+    */
+    AsyncSocket(Reactor &, Socket &&);
+
+
+    /**
+    * @method socket
+    * @access public
+    * @desc Get the underlying Socket, for options and addresses.
+    *
+    * @returns {Socket}
+    */
+    const Socket &socket() const noexcept { return sock; }
+
+
+    /**
+    * @method asyncAccept
+    * @access public
+    * @desc Awaits the next connection on a listening Socket.
+    *
+    * @returns {AcceptOp} Awaitable yielding the accepted Socket.
+    */
+    AcceptOp asyncAccept() noexcept { return AcceptOp(*this); }
+
+
+    /**
+    * @method asyncRecv
+    * @access public
+    * @desc Awaits data, receiving at most _len bytes into _buf.
+    *
+    * @param {char *} _buf Buffer to receive into.
+    * @param {size_t} _len Capacity of _buf in bytes.
+    * @returns {RecvOp} Awaitable yielding the number of bytes received, 0
+    * when the peer closed the connection.
+    */
+    RecvOp asyncRecv(char *_buf, std::size_t _len) noexcept
+    {
+        return RecvOp(*this, _buf, _len);
+    }
+
+
+    /**
+    * @method asyncSend
+    * @access public
+    * @desc Awaits sending all of _msg, suspending as often as the send
+    * buffer fills up. _msg must stay valid until then.
+    *
+    * @param {StringView} _msg Msg to send.
+    * @returns {SendOp} Awaitable completing when all of _msg was sent.
+    */
+    SendOp asyncSend(StringView _msg) noexcept
+    {
+        return SendOp(*this, _msg.data(), _msg.size());
+    }
+
+    SendOp asyncSend(const char *_msg, std::size_t _len) noexcept
+    {
+        return SendOp(*this, _msg, _len);
+    }
+
+
+    /**
+    * @method asyncConnect
+    * @access public
+    * @desc Awaits connecting to the given address and port. _addr must stay
+    * valid until then.
+    *
+    * @param {char []} _addr Address to connect to.
+    * @param {int} _port Port to connect to, unused for UNIX sockets.
+    * @returns {ConnectOp} Awaitable completing once connected.
+    */
+    ConnectOp asyncConnect(const char _addr[], int _port = 0) noexcept
+    {
+        return ConnectOp(*this, _addr, _port);
+    }
+
+
+    ~AsyncSocket() noexcept;
+};
+}
+
+#endif
@@ -0,0 +1,265 @@
+#ifndef BUFFER_POOL_HPP
+#define BUFFER_POOL_HPP
+
+#include "string_view.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+namespace net {
+
+/**
+* @class net::BufferPool
+* @desc Pool of receive and send buffers in size classes, powers of 2 from
+* minSize to maxSize, carved out of 256 KiB slabs. Every thread borrows from
+* and returns to its own cache per class, taking no lock; a cache grown past
+* its limit spills half of it to the shared free list of the pool, and an
+* empty one refills from there, so in steady state no call allocates. Larger
+* buffers are allocated one by one. A thread exiting gives its caches back to
+* the shared lists. The pool must outlive its buffers.
+*/
+class BufferPool final {
+public:
+    static constexpr std::size_t minSize   = 256;
+    static constexpr std::size_t maxSize   = 64 * 1024;
+    static constexpr std::size_t classes   = 9;
+    static constexpr std::size_t slabBytes = 256 * 1024;
+
+    /**
+    * @class net::BufferPool::Buffer
+    * @desc Buffer borrowed from the pool, returned to it on destruction.
+    * Holds capacity bytes, of which the first size are in use.
+    */
+    class Buffer final {
+        friend class BufferPool;
+
+        BufferPool *pool;
+        char *ptr;
+        std::size_t cap;
+        std::size_t len;
+
+        Buffer(BufferPool *_pool, char *_ptr, const std::size_t _cap) noexcept
+            : pool(_pool), ptr(_ptr), cap(_cap), len(0)
+        {
+        }
+
+        Buffer(const Buffer &) = delete;
+        Buffer &operator=(const Buffer &) = delete;
+
+    public:
+        /**
+        * @construct net::BufferPool::Buffer
+        * @access public
+        * @desc Creates an empty buffer, holding nothing.
+        */
+        Buffer() noexcept : pool(nullptr), ptr(nullptr), cap(0), len(0) {}
+
+        Buffer(Buffer &&_other) noexcept
+            : pool(_other.pool), ptr(_other.ptr), cap(_other.cap),
+              len(_other.len)
+        {
+            _other.ptr = nullptr;
+        }
+
+        Buffer &operator=(Buffer &&_other) noexcept
+        {
+            if (this != &_other) {
+                release();
+                pool       = _other.pool;
+                ptr        = _other.ptr;
+                cap        = _other.cap;
+                len        = _other.len;
+                _other.ptr = nullptr;
+            }
+            return *this;
+        }
+
+
+        /**
+        * @method data
+        * @access public
+        * @desc Get the bytes of the buffer.
+        *
+        * @returns {char *}
+        */
+        char *data() noexcept { return ptr; }
+
+        const char *data() const noexcept { return ptr; }
+
+
+        /**
+        * @method capacity
+        * @access public
+        * @desc Get the number of bytes the buffer holds, at least the size
+        * asked for.
+        *
+        * @returns {size_t}
+        */
+        std::size_t capacity() const noexcept { return cap; }
+
+
+        /**
+        * @method size
+        * @access public
+        * @desc Get the number of bytes in use, as set by resize or by the
+        * Socket call which filled the buffer.
+        *
+        * @returns {size_t}
+        */
+        std::size_t size() const noexcept { return len; }
+
+
+        /**
+        * @method resize
+        * @access public
+        * @desc Sets the number of bytes in use, at most capacity.
+        *
+        * @param {size_t} _len Number of bytes.
+        */
+        void resize(const std::size_t _len) noexcept
+        {
+            len = (_len < cap) ? _len : cap;
+        }
+
+
+        /**
+        * @method view
+        * @access public
+        * @desc Get a view of the bytes in use, as passed to Socket::send.
+        *
+        * @returns {StringView}
+        */
+        StringView view() const noexcept { return StringView(ptr, len); }
+
+
+        /**
+        * @method release
+        * @access public
+        * @desc Returns the buffer to the pool before destruction, leaving it
+        * empty.
+        */
+        void release() noexcept
+        {
+            if (ptr != nullptr) {
+                pool->release(ptr, cap);
+                ptr = nullptr;
+                cap = len = 0;
+            }
+        }
+
+
+        ~Buffer() noexcept { release(); }
+    };
+
+
+    /**
+    * @class net::BufferPool::Stats
+    * @desc Occupancy of the pool, or of one of its size classes.
+    */
+    struct Stats {
+        // Bytes allocated for slabs.
+        std::size_t slabBytes = 0;
+        // Buffers carved out of the slabs.
+        std::size_t buffers = 0;
+        // Buffers borrowed at the moment.
+        std::size_t inUse = 0;
+        // Buffers free in the caches of threads.
+        std::size_t cached = 0;
+        // Buffers free in the shared lists.
+        std::size_t shared = 0;
+        // Buffers above maxSize borrowed at the moment, not counted above.
+        std::size_t oversized = 0;
+    };
+
+
+private:
+    struct LocalCache;
+    struct ThreadCaches;
+
+    struct SizeClass {
+        std::vector<char *> shared;
+        std::atomic<std::size_t> buffers;
+        std::atomic<std::size_t> inUse;
+
+        SizeClass() : buffers(0), inUse(0) {}
+    };
+
+    const std::uint64_t id;
+    const std::size_t cacheSize;
+    mutable std::mutex mutex;
+    SizeClass sizeClasses[classes];
+    std::vector<std::unique_ptr<char[]>> slabs;
+    std::atomic<std::size_t> oversized;
+
+    static thread_local ThreadCaches threadCaches;
+
+    BufferPool(const BufferPool &) = delete;
+    BufferPool &operator=(const BufferPool &) = delete;
+
+    static std::size_t classOf(const std::size_t _size) noexcept
+    {
+        return (_size <= minSize) ? 0 : 64 - __builtin_clzll(_size - 1) - 8;
+    }
+
+    LocalCache &localCache();
+    void refill(std::size_t, std::vector<char *> &);
+    void spill(std::size_t, std::vector<char *> &, std::size_t);
+    void release(char *, std::size_t) noexcept;
+    Stats classStats(std::size_t) const;
+
+
+public:
+    /**
+    * @construct net::BufferPool
+    * @access public
+    * @desc Creates an empty pool, allocating slabs as buffers are borrowed.
+    *
+    * @param {size_t} _cacheSize Free buffers each thread keeps per class
+    * before spilling half of them to the shared list.
+    */
+    explicit BufferPool(std::size_t = 64);
+
+
+    /**
+    * @method acquire
+    * @access public
+    * @desc Borrows a buffer of at least _size bytes, with size 0.
+    *
+    * @param {size_t} _size Number of bytes needed.
+    * @returns {net::BufferPool::Buffer}
+    */
+    Buffer acquire(std::size_t);
+
+
+    /**
+    * @method stats
+    * @access public
+    * @desc Get the occupancy of the whole pool.
+    *
+    * @returns {net::BufferPool::Stats}
+    */
+    Stats stats() const;
+
+
+    /**
+    * @method stats
+    * @access public
+    * @desc Get the occupancy of the size class serving buffers of _size
+    * bytes, with oversized always 0.
+    * Throws invalid_argument exception if _size is above maxSize.
+    *
+    * @param {size_t} _size Size of a buffer of the class.
+    * @returns {net::BufferPool::Stats}
+    */
+    Stats stats(std::size_t) const;
+
+
+    ~BufferPool() noexcept;
+};
+}
+
+#endif
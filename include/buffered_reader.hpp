@@ -0,0 +1,176 @@
+#ifndef BUFFERED_READER_HPP
+#define BUFFERED_READER_HPP
+
+#include "socket.hpp"
+#include "string_view.hpp"
+#include <cstddef>
+
+
+namespace net {
+
+/**
+* @class net::BufferedReader
+* @desc Reads delimited or fixed-length messages from a stream Socket through
+* a fixed ring buffer, receiving as much as fits per call instead of one
+* small read per message. The ring is mapped twice back to back in memory,
+* so buffered bytes are always contiguous even when they wrap around, and
+* messages are returned as views into it without copying or compacting.
+* A view stays valid until the next call reading from the Socket.
+* On a packet Socket every recv takes one whole packet, and one larger than
+* the room left in the ring throws instead of being silently truncated.
+*/
+class BufferedReader final {
+    const Socket &sock;
+    char *ring;
+    std::size_t cap;
+    std::size_t head    = 0;
+    std::size_t tail    = 0;
+    std::size_t scanned = 0;
+    bool closed         = false;
+
+    BufferedReader(const BufferedReader &) = delete;
+    BufferedReader &operator=(const BufferedReader &) = delete;
+
+    StringView take(const std::size_t) noexcept;
+
+
+public:
+    /**
+    * @construct net::BufferedReader
+    * @access public
+    * @desc Maps the ring buffer if successful else throws runtime_error
+    * exception.
+    *
+    * @param {Socket} _sock Socket to read from, which must outlive the reader.
+    * @param {size_t} _capacity Size of the ring, rounded up to whole pages.
+    * Also the longest message that can be read.
+    */
+    explicit BufferedReader(const Socket &, std::size_t = 65536);
+
+
+    /**
+    * @method readUntil
+    * @access public
+    * @desc Reads up to and including the first occurrence of _delim if
+    * successful else throws runtime_error exception, also when no _delim is
+    * found within the capacity. Returns an empty view, keeping the partial
+    * message buffered, if the peer closed the connection or, in case of a
+    * non-blocking Socket, on setting _errorNB.
+    * Throws invalid_argument exception in case of non-blocking net::Socket if
+    * _errorNB is missing.
+    *
+    * @param {StringView} _delim Delimiter ending the message.
+    * @param {bool *} _errorNB To signal error in case of non-blocking recv.
+    * @returns {StringView} Message, including _delim.
+    */
+    StringView readUntil(StringView, bool * = nullptr);
+
+
+    /**
+    * @method readUntil
+    * @access public
+    * @desc Reads up to and including the first _delim, as above.
+    *
+    * @param {char} _delim Delimiter ending the message.
+    * @param {bool *} _errorNB To signal error in case of non-blocking recv.
+    * @returns {StringView} Message, including _delim.
+    */
+    StringView readUntil(const char _delim, bool *_errorNB = nullptr)
+    {
+        return readUntil(StringView(&_delim, 1), _errorNB);
+    }
+
+
+    /**
+    * @method readExact
+    * @access public
+    * @desc Reads exactly _len bytes if successful else throws runtime_error
+    * exception. Returns an empty view, keeping the partial message buffered,
+    * if the peer closed the connection or, in case of a non-blocking Socket,
+    * on setting _errorNB.
+    * Throws invalid_argument exception if _len exceeds the capacity, and in
+    * case of non-blocking net::Socket if _errorNB is missing.
+    *
+    * @param {size_t} _len Number of bytes to read.
+    * @param {bool *} _errorNB To signal error in case of non-blocking recv.
+    * @returns {StringView} Message of _len bytes.
+    */
+    StringView readExact(const std::size_t, bool * = nullptr);
+
+
+    /**
+    * @method receive
+    * @access public
+    * @desc Receives once into the free space of the ring, for callers parsing
+    * the buffered bytes themselves through peek, if successful else throws
+    * runtime_error exception. Returns false if nothing was received because
+    * the peer closed the connection, the ring is full or, in case of a
+    * non-blocking Socket, on setting _errorNB.
+    * Throws invalid_argument exception in case of non-blocking net::Socket if
+    * _errorNB is missing.
+    *
+    * @param {bool *} _errorNB To signal error in case of non-blocking recv.
+    * @returns {bool} true if bytes were received.
+    */
+    bool receive(bool * = nullptr);
+
+
+    /**
+    * @method peek
+    * @access public
+    * @desc Get a view of all buffered bytes without consuming them.
+    *
+    * @returns {StringView}
+    */
+    StringView peek() const noexcept
+    {
+        return StringView(ring + head, tail - head);
+    }
+
+
+    /**
+    * @method consume
+    * @access public
+    * @desc Discards the first _len buffered bytes, at most all of them.
+    *
+    * @param {size_t} _len Number of bytes to discard.
+    */
+    void consume(const std::size_t _len) noexcept;
+
+
+    /**
+    * @method buffered
+    * @access public
+    * @desc Get the number of bytes received but not yet consumed.
+    *
+    * @returns {size_t}
+    */
+    std::size_t buffered() const noexcept { return tail - head; }
+
+
+    /**
+    * @method capacity
+    * @access public
+    * @desc Get the size of the ring buffer.
+    *
+    * @returns {size_t}
+    */
+    std::size_t capacity() const noexcept { return cap; }
+
+
+    /**
+    * @method eof
+    * @access public
+    * @desc Whether the peer closed the connection. Bytes may still be
+    * buffered.
+    *
+    * @returns {bool}
+    */
+    bool eof() const noexcept { return closed; }
+
+
+    ~BufferedReader() noexcept;
+};
+}
+
+#endif
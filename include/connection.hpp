@@ -0,0 +1,264 @@
+#ifndef CONNECTION_HPP
+#define CONNECTION_HPP
+
+#include "socket.hpp"
+#include <cstdint>
+
+
+namespace net {
+
+/**
+* @class net::Connection
+* @desc Owning handle of a connected socket descriptor in 8 bytes: the
+* descriptor with its domain and type packed beside it. A Socket also keeps
+* the peer address and takes 144 bytes, most of them never read again once
+* the connection is accepted; a Connection fetches the address only when
+* asked, so a million idle connections fit in a dense array. Move-only, and
+* closes the descriptor on destruction.
+* A Socket converts into a Connection, so acceptMany fills a container of
+* Connection too. The common calls are forwarded here; every other Socket
+* call is reached through view.
+*/
+class Connection final {
+    int fd;
+    std::uint8_t family;
+    std::uint8_t sockType;
+
+    Connection(const Connection &) = delete;
+    Connection &operator=(const Connection &) = delete;
+
+
+public:
+    /**
+    * @construct net::Connection
+    * @access public
+    * @desc Creates an empty handle, owning no descriptor.
+    */
+    Connection() noexcept : fd(-1), family(0), sockType(0) {}
+
+
+    /**
+    * @construct net::Connection
+    * @access public
+    * @desc Takes ownership of a connected descriptor.
+    *
+    * @param {int} _fd Descriptor of a connected socket.
+    * @param {Domain} _domain Domain of the socket.
+    * @param {Type} _type Type of the socket, flags like NONBLOCK dropped.
+    */
+    Connection(const int _fd, Domain _domain, Type _type) noexcept
+        : fd(_fd), family(static_cast<std::uint8_t>(_domain)),
+          sockType(static_cast<std::uint8_t>(static_cast<int>(_type) & 0xf))
+    {
+    }
+
+
+    /**
+    * @construct net::Connection
+    * @access public
+    * @desc Takes the descriptor of _s, which is left closed, dropping the
+    * peer address it holds.
+    *
+    * @param {Socket} _s Connected Socket.
+    */
+    Connection(Socket &&) noexcept;
+
+
+    Connection(Connection &&_other) noexcept
+        : fd(_other.fd), family(_other.family), sockType(_other.sockType)
+    {
+        _other.fd = -1;
+    }
+
+
+    Connection &operator=(Connection &&) noexcept;
+
+
+    /**
+    * @method getSocket
+    * @access public
+    * @desc Get the socket descriptor, -1 if empty.
+    *
+    * @returns {int}
+    */
+    int getSocket() const noexcept { return fd; }
+
+
+    /**
+    * @method domain
+    * @access public
+    * @desc Get the domain of the socket.
+    *
+    * @returns {net::Domain}
+    */
+    Domain domain() const noexcept { return static_cast<Domain>(family); }
+
+
+    /**
+    * @method type
+    * @access public
+    * @desc Get the type of the socket.
+    *
+    * @returns {net::Type}
+    */
+    Type type() const noexcept { return static_cast<Type>(sockType); }
+
+
+    /**
+    * @method peer
+    * @access public
+    * @desc Fetches the address of the peer with getpeername if successful
+    * else throws runtime_error exception.
+    *
+    * @returns {AddrStore}
+    */
+    AddrStore peer() const;
+
+
+    /**
+    * @method view
+    * @access public
+    * @desc Get a Socket on the same descriptor which does not own it, for
+    * the calls not forwarded by Connection. It must not outlive the
+    * Connection, and has no peer address.
+    *
+    * @returns {net::Socket}
+    */
+    Socket view() const noexcept;
+
+
+    /**
+    * @method toSocket
+    * @access public
+    * @desc Hands the descriptor over to a new Socket, with the peer address
+    * fetched if there is one, leaving the Connection empty.
+    *
+    * @returns {net::Socket}
+    */
+    Socket toSocket();
+
+
+    /**
+    * @method send
+    * @access public
+    * @desc As Socket::send.
+    *
+    * @param {StringView} _msg String to be sent.
+    * @param {Send} _flags Modify default behaviour of send.
+    * @param {bool *} _errorNB To signal error in case of non-blocking send.
+    */
+    void send(StringView _msg, Send _flags = Send::NONE,
+              bool *_errorNB = nullptr) const
+    {
+        view().send(_msg, _flags, _errorNB);
+    }
+
+
+    /**
+    * @method recv
+    * @access public
+    * @desc As Socket::recv into a caller owned buffer.
+    *
+    * @param {char *} _buf Buffer to store the data.
+    * @param {size_t} _len Capacity of _buf in bytes.
+    * @param {Recv} _flags Modify default behaviour of recv.
+    * @param {bool *} _errorNB To signal error in case of non-blocking recv.
+    * @returns {ssize_t} Number of bytes read, -1 on non-blocking error.
+    */
+    ssize_t recv(char *_buf, const std::size_t _len, Recv _flags = Recv::NONE,
+                 bool *_errorNB = nullptr) const
+    {
+        return view().recv(_buf, _len, _flags, _errorNB);
+    }
+
+
+    /**
+    * @method recv
+    * @access public
+    * @desc As Socket::recv into a buffer borrowed from _pool.
+    *
+    * @param {BufferPool} _pool Pool to borrow the buffer from.
+    * @param {size_t} _len Maximum number of bytes to read.
+    * @param {Recv} _flags Modify default behaviour of recv.
+    * @param {bool *} _errorNB To signal error in case of non-blocking recv.
+    * @returns {net::BufferPool::Buffer} Buffer of the bytes read.
+    */
+    BufferPool::Buffer recv(BufferPool &_pool, const std::size_t _len,
+                            Recv _flags    = Recv::NONE,
+                            bool *_errorNB = nullptr) const
+    {
+        return view().recv(_pool, _len, _flags, _errorNB);
+    }
+
+
+    /**
+    * @method trySend
+    * @access public
+    * @desc As Socket::trySend.
+    *
+    * @param {StringView} _msg String to be sent.
+    * @param {Send} _flags Modify default behaviour of send.
+    * @returns {IoResult}
+    */
+    IoResult trySend(StringView _msg, Send _flags = Send::NONE) const noexcept
+    {
+        return view().trySend(_msg, _flags);
+    }
+
+
+    /**
+    * @method tryRecv
+    * @access public
+    * @desc As Socket::tryRecv.
+    *
+    * @param {char *} _buf Buffer to store the data.
+    * @param {size_t} _len Capacity of _buf in bytes.
+    * @param {Recv} _flags Modify default behaviour of recv.
+    * @returns {IoResult}
+    */
+    IoResult tryRecv(char *_buf, const std::size_t _len,
+                     Recv _flags = Recv::NONE) const noexcept
+    {
+        return view().tryRecv(_buf, _len, _flags);
+    }
+
+
+    /**
+    * @method setNonBlocking
+    * @access public
+    * @desc As Socket::setNonBlocking.
+    *
+    * @param {bool} _nonBlocking false to make the socket blocking again.
+    */
+    void setNonBlocking(const bool _nonBlocking = true) const
+    {
+        view().setNonBlocking(_nonBlocking);
+    }
+
+
+    /**
+    * @method stop
+    * @access public
+    * @desc Shuts down the connection, as Socket::stop.
+    *
+    * @param {Shut} _s Which side of the connection to shut down.
+    */
+    void stop(Shut _s) const noexcept { shutdown(fd, static_cast<int>(_s)); }
+
+
+    /**
+    * @method close
+    * @access public
+    * @desc Closes the descriptor before destruction, leaving the Connection
+    * empty.
+    *
+    * @returns {bool} Whether close succeeded; false if empty.
+    */
+    bool close() noexcept;
+
+
+    ~Connection() noexcept { close(); }
+};
+}
+
+#endif
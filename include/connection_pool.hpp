@@ -0,0 +1,224 @@
+#ifndef CONNECTION_POOL_HPP
+#define CONNECTION_POOL_HPP
+
+#include "socket.hpp"
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+namespace net {
+
+/**
+* @class net::ConnectionPool
+* @desc Keeps idle connected stream Sockets per endpoint, so calls to a
+* backend reuse a connection instead of paying a handshake each. Every
+* endpoint is warmed up with a minimum of connections when registered, and
+* idle connections are checked before being handed out, so one closed or
+* reset by the peer meanwhile is dropped instead of returned.
+* Not thread-safe: keep one pool per thread, as with Reactor, so that
+* handing out a connection takes no lock.
+*/
+class ConnectionPool final {
+public:
+    /**
+    * @class net::ConnectionPool::Endpoint
+    * @desc Peer registered with the pool, with its idle connections. Stays
+    * valid as long as the pool, so it can be looked up once and kept.
+    */
+    class Endpoint final {
+        friend class ConnectionPool;
+
+        std::string addr;
+        int port;
+        std::vector<Socket> idleSockets;
+
+        Endpoint(std::string _addr, const int _port)
+            : addr(std::move(_addr)), port(_port)
+        {
+        }
+
+    public:
+        /**
+        * @method idle
+        * @access public
+        * @desc Get the number of idle connections to the endpoint.
+        *
+        * @returns {size_t}
+        */
+        std::size_t idle() const noexcept { return idleSockets.size(); }
+    };
+
+
+    /**
+    * @class net::ConnectionPool::Lease
+    * @desc Connection handed out by the pool. Returns it to its endpoint on
+    * destruction, unless discarded, so a connection left in an unknown
+    * state by a failed call is not reused.
+    */
+    class Lease final {
+        friend class ConnectionPool;
+
+        ConnectionPool *pool;
+        Endpoint *from;
+        Socket sock;
+        bool wasIdle;
+
+        Lease(ConnectionPool *_pool, Endpoint *_from, Socket &&_sock,
+              const bool _wasIdle) noexcept
+            : pool(_pool), from(_from), sock(std::move(_sock)),
+              wasIdle(_wasIdle)
+        {
+        }
+
+        Lease(const Lease &) = delete;
+        Lease &operator=(const Lease &) = delete;
+
+    public:
+        Lease(Lease &&_other) noexcept
+            : pool(_other.pool), from(_other.from),
+              sock(std::move(_other.sock)), wasIdle(_other.wasIdle)
+        {
+            _other.from = nullptr;
+        }
+
+
+        /**
+        * @method socket
+        * @access public
+        * @desc Get the connected Socket.
+        *
+        * @returns {net::Socket}
+        */
+        const Socket &socket() const noexcept { return sock; }
+
+        const Socket *operator->() const noexcept { return &sock; }
+
+
+        /**
+        * @method reused
+        * @access public
+        * @desc Whether the connection was idle in the pool rather than opened
+        * for this lease. A peer may close an idle connection just as it is
+        * reused, so a failed request on a reused one is worth one retry.
+        *
+        * @returns {bool}
+        */
+        bool reused() const noexcept { return wasIdle; }
+
+
+        /**
+        * @method discard
+        * @access public
+        * @desc Closes the connection on destruction instead of returning it.
+        */
+        void discard() noexcept { from = nullptr; }
+
+
+        ~Lease() noexcept
+        {
+            if (from != nullptr) {
+                pool->release(*from, std::move(sock));
+            }
+        }
+    };
+
+
+private:
+    Domain domain;
+    std::size_t minIdle;
+    std::size_t maxIdle;
+    std::unordered_map<std::string, Endpoint> endpoints;
+
+    ConnectionPool(const ConnectionPool &) = delete;
+    ConnectionPool &operator=(const ConnectionPool &) = delete;
+
+    Socket open(const Endpoint &) const;
+    void release(Endpoint &, Socket &&) noexcept;
+
+
+public:
+    /**
+    * @construct net::ConnectionPool
+    * @access public
+    * @param {Domain} _domain Domain of the endpoints.
+    * @param {size_t} _minIdle Connections opened to an endpoint when it is
+    * registered.
+    * @param {size_t} _maxIdle Idle connections kept per endpoint, beyond
+    * which returned ones are closed.
+    */
+    explicit ConnectionPool(Domain _domain, const std::size_t _minIdle = 0,
+                            const std::size_t _maxIdle = 16);
+
+
+    /**
+    * @method endpoint
+    * @access public
+    * @desc Get the endpoint for given address, registering and warming it up
+    * on first use. Throws runtime_error exception if the warm-up fails to
+    * connect.
+    *
+    * @param {char []} _addr Ip address in case of ipv4 or ipv6 domain, and Path
+    * in case of unix domain.
+    * @param {int} _port Port number in case of ipv4 or ipv6.
+    * @returns {Endpoint}
+    */
+    Endpoint &endpoint(const char[], const int = 0);
+
+
+    /**
+    * @method warmUp
+    * @access public
+    * @desc Opens connections to _ep until it has the minimum number idle, if
+    * successful else throws runtime_error exception.
+    *
+    * @param {Endpoint} _ep Endpoint to warm up.
+    */
+    void warmUp(Endpoint &);
+
+
+    /**
+    * @method acquire
+    * @access public
+    * @desc Hands out an idle connection to _ep that passes the health check,
+    * else opens a new one, if successful else throws runtime_error exception.
+    *
+    * @param {Endpoint} _ep Endpoint to connect to.
+    * @returns {Lease}
+    */
+    Lease acquire(Endpoint &);
+
+
+    /**
+    * @method acquire
+    * @access public
+    * @desc Hands out a connection to given address, as acquire(endpoint()).
+    *
+    * @param {char []} _addr Ip address in case of ipv4 or ipv6 domain, and Path
+    * in case of unix domain.
+    * @param {int} _port Port number in case of ipv4 or ipv6.
+    * @returns {Lease}
+    */
+    Lease acquire(const char _addr[], const int _port = 0)
+    {
+        return acquire(endpoint(_addr, _port));
+    }
+
+
+    /**
+    * @method healthy
+    * @access public
+    * @desc Checks without blocking that an idle connection can be reused: a
+    * pending error, a close by the peer or unexpected unread data all make
+    * it unusable. Costs one recv with MSG_PEEK, which also reports and
+    * clears SO_ERROR.
+    *
+    * @param {Socket} _sock Idle connection to check.
+    * @returns {bool}
+    */
+    static bool healthy(const Socket &) noexcept;
+};
+}
+
+#endif
@@ -0,0 +1,444 @@
+#ifndef CONNECTION_TABLE_HPP
+#define CONNECTION_TABLE_HPP
+
+#include "connection.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace net {
+
+/**
+* @class net::ConnectionTable
+* @desc Slot map of the connections of an event loop. Every connection gets
+* an Id naming its slot and the generation of the slot, so an Id kept past
+* the erasure of its connection is detected as stale instead of reaching the
+* connection that reused the slot. The entries are packed at the front of
+* parallel arrays, connections, states and last activity times, and erasure
+* moves the last entry into the hole, so a scan for idle connections reads
+* the activity times alone, back to back. Descriptors map to slots through
+* an array indexed by descriptor, so both the Id of a reactor callback and
+* a bare descriptor are looked up in O(1).
+* Not thread-safe: keep one table per thread, as with Reactor.
+*/
+class ConnectionTable final {
+public:
+    using Clock = std::chrono::steady_clock;
+
+
+    /**
+    * @class net::ConnectionTable::Id
+    * @desc Index of a slot with its generation, odd while the slot is in use.
+    * A default constructed Id is never valid. Packs into a 64-bit token, as
+    * carried by epoll_event or io_uring user data.
+    */
+    class Id final {
+        friend class ConnectionTable;
+
+        std::uint32_t index      = 0;
+        std::uint32_t generation = 0;
+
+        Id(std::uint32_t _index, std::uint32_t _generation) noexcept
+            : index(_index), generation(_generation)
+        {
+        }
+
+
+    public:
+        /**
+        * @construct net::ConnectionTable::Id
+        * @access public
+        * @desc Creates an Id matching no connection.
+        */
+        Id() noexcept = default;
+
+
+        /**
+        * @method token
+        * @access public
+        * @desc Packs the Id into 64 bits, generation in the high half.
+        *
+        * @returns {uint64_t}
+        */
+        std::uint64_t token() const noexcept
+        {
+            return (static_cast<std::uint64_t>(generation) << 32) | index;
+        }
+
+
+        /**
+        * @method fromToken
+        * @access public
+        * @desc Unpacks an Id from a token made by token.
+        *
+        * @param {uint64_t} _token Token to unpack.
+        * @returns {net::ConnectionTable::Id}
+        */
+        static Id fromToken(const std::uint64_t _token) noexcept
+        {
+            return Id(static_cast<std::uint32_t>(_token),
+                      static_cast<std::uint32_t>(_token >> 32));
+        }
+
+
+        bool operator==(const Id &_other) const noexcept
+        {
+            return index == _other.index && generation == _other.generation;
+        }
+
+
+        bool operator!=(const Id &_other) const noexcept
+        {
+            return !(*this == _other);
+        }
+    };
+
+
+private:
+    static constexpr std::uint32_t none = UINT32_MAX;
+
+    // Per slot: position of its entry while in use, else the next free slot.
+    std::vector<std::uint32_t> slotEntries;
+    std::vector<std::uint32_t> slotGenerations;
+    std::uint32_t freeSlots = none;
+
+    // Per descriptor: slot holding it plus one, 0 if none.
+    std::vector<std::uint32_t> fdSlots;
+
+    // Per entry, packed. The descriptor is kept apart from the Connection,
+    // which its owner may have closed or moved from by removal time.
+    std::vector<Connection> connections;
+    std::vector<int> descriptors;
+    std::vector<std::uint32_t> owners;
+    std::vector<std::uint8_t> states;
+    std::vector<Clock::time_point> activity;
+
+    ConnectionTable(const ConnectionTable &) = delete;
+    ConnectionTable &operator=(const ConnectionTable &) = delete;
+
+    std::uint32_t entry(Id _id) const noexcept
+    {
+        return contains(_id) ? slotEntries[_id.index] : none;
+    }
+
+
+public:
+    /**
+    * @construct net::ConnectionTable
+    * @access public
+    * @desc Creates a table, with room for _capacity connections before it
+    * has to grow.
+    *
+    * @param {size_t} _capacity Number of connections to reserve room for.
+    */
+    explicit ConnectionTable(const std::size_t _capacity = 0)
+    {
+        reserve(_capacity);
+    }
+
+
+    /**
+    * @method reserve
+    * @access public
+    * @desc Makes room for _capacity connections, so inserting up to that many
+    * never reallocates.
+    *
+    * @param {size_t} _capacity Number of connections to reserve room for.
+    */
+    void reserve(std::size_t);
+
+
+    /**
+    * @method insert
+    * @access public
+    * @desc Takes ownership of _conn if successful else throws
+    * invalid_argument exception, when _conn is empty or its descriptor is
+    * in the table already.
+    *
+    * @param {Connection} _conn Connection to insert.
+    * @param {uint8_t} _state Initial state, its meaning left to the caller.
+    * @param {time_point} _now Time of last activity.
+    * @returns {net::ConnectionTable::Id}
+    */
+    Id insert(Connection &&, std::uint8_t = 0,
+              Clock::time_point = Clock::now());
+
+
+    /**
+    * @method release
+    * @access public
+    * @desc Removes the connection of _id, handing it back open. Returns an
+    * empty Connection if _id is stale.
+    *
+    * @param {Id} _id Id of the connection.
+    * @returns {net::Connection}
+    */
+    Connection release(Id) noexcept;
+
+
+    /**
+    * @method erase
+    * @access public
+    * @desc Removes and closes the connection of _id.
+    *
+    * @param {Id} _id Id of the connection.
+    * @returns {bool} false if _id is stale.
+    */
+    bool erase(const Id _id) noexcept
+    {
+        if (!contains(_id)) {
+            return false;
+        }
+
+        release(_id).close();
+        return true;
+    }
+
+
+    /**
+    * @method clear
+    * @access public
+    * @desc Removes and closes every connection. Ids handed out so far become
+    * stale.
+    */
+    void clear() noexcept;
+
+
+    /**
+    * @method contains
+    * @access public
+    * @desc Whether _id names a connection in the table.
+    *
+    * @param {Id} _id Id to check.
+    * @returns {bool}
+    */
+    bool contains(const Id _id) const noexcept
+    {
+        return _id.index < slotGenerations.size()
+          && slotGenerations[_id.index] == _id.generation
+          && (_id.generation & 1) == 1;
+    }
+
+
+    /**
+    * @method lookup
+    * @access public
+    * @desc Get the Id of the connection on descriptor _fd, a default
+    * constructed Id if none.
+    *
+    * @param {int} _fd Socket descriptor.
+    * @returns {net::ConnectionTable::Id}
+    */
+    Id lookup(const int _fd) const noexcept
+    {
+        if (_fd < 0 || static_cast<std::size_t>(_fd) >= fdSlots.size()
+            || fdSlots[_fd] == 0) {
+            return Id();
+        }
+
+        const auto slot = fdSlots[_fd] - 1;
+        return Id(slot, slotGenerations[slot]);
+    }
+
+
+    /**
+    * @method get
+    * @access public
+    * @desc Get the connection of _id, nullptr if _id is stale. The pointer is
+    * invalidated by the next insert or removal. Close the connection with
+    * erase rather than through the pointer: until erased, its descriptor
+    * stays in the table, and a new socket reusing it cannot be inserted.
+    *
+    * @param {Id} _id Id of the connection.
+    * @returns {net::Connection *}
+    */
+    Connection *get(const Id _id) noexcept
+    {
+        const auto e = entry(_id);
+        return (e == none) ? nullptr : &connections[e];
+    }
+
+
+    /**
+    * @method state
+    * @access public
+    * @desc Get the state of the connection of _id if _id is valid else throws
+    * out_of_range exception.
+    *
+    * @param {Id} _id Id of the connection.
+    * @returns {uint8_t}
+    */
+    std::uint8_t state(Id) const;
+
+
+    /**
+    * @method setState
+    * @access public
+    * @desc Sets the state of the connection of _id.
+    *
+    * @param {Id} _id Id of the connection.
+    * @param {uint8_t} _state New state.
+    * @returns {bool} false if _id is stale.
+    */
+    bool setState(const Id _id, const std::uint8_t _state) noexcept
+    {
+        const auto e = entry(_id);
+        if (e == none) {
+            return false;
+        }
+
+        states[e] = _state;
+        return true;
+    }
+
+
+    /**
+    * @method touch
+    * @access public
+    * @desc Records activity on the connection of _id.
+    *
+    * @param {Id} _id Id of the connection.
+    * @param {time_point} _now Time of the activity.
+    * @returns {bool} false if _id is stale.
+    */
+    bool touch(const Id _id,
+               const Clock::time_point _now = Clock::now()) noexcept
+    {
+        const auto e = entry(_id);
+        if (e == none) {
+            return false;
+        }
+
+        activity[e] = _now;
+        return true;
+    }
+
+
+    /**
+    * @method expire
+    * @access public
+    * @desc Closes and removes every connection idle since before _before,
+    * handing each to _onExpire first. _onExpire may send on the connection
+    * but must not insert into or remove from the table.
+    *
+    * @param {time_point} _before Connections last active earlier expire.
+    * @param {Callback} _onExpire Invoked as
+    * _onExpire(Id, const Connection &).
+    * @returns {size_t} Number of connections expired.
+    */
+    template <typename Callback>
+    std::size_t expire(const Clock::time_point _before, Callback &&_onExpire)
+    {
+        std::size_t expired = 0;
+
+        // Backwards, so the entry moved into a hole has been looked at.
+        for (auto i = activity.size(); i-- > 0;) {
+            if (activity[i] < _before) {
+                const Id id(owners[i], slotGenerations[owners[i]]);
+                _onExpire(id, static_cast<const Connection &>(connections[i]));
+                erase(id);
+                ++expired;
+            }
+        }
+
+        return expired;
+    }
+
+
+    /**
+    * @method expire
+    * @access public
+    * @desc Closes and removes every connection idle since before _before.
+    *
+    * @param {time_point} _before Connections last active earlier expire.
+    * @returns {size_t} Number of connections expired.
+    */
+    std::size_t expire(const Clock::time_point _before)
+    {
+        return expire(_before, [](Id, const Connection &) {});
+    }
+
+
+    /**
+    * @method size
+    * @access public
+    * @desc Get the number of connections in the table.
+    *
+    * @returns {size_t}
+    */
+    std::size_t size() const noexcept { return connections.size(); }
+
+
+    /**
+    * @method empty
+    * @access public
+    * @desc Whether the table holds no connection.
+    *
+    * @returns {bool}
+    */
+    bool empty() const noexcept { return connections.empty(); }
+
+
+    /**
+    * @method idAt
+    * @access public
+    * @desc Get the Id of the _i-th packed entry, _i below size. With the
+    * other At accessors it walks every connection in storage order, which
+    * an insert or removal changes.
+    *
+    * @param {size_t} _i Position of the entry.
+    * @returns {net::ConnectionTable::Id}
+    */
+    Id idAt(const std::size_t _i) const noexcept
+    {
+        return Id(owners[_i], slotGenerations[owners[_i]]);
+    }
+
+
+    /**
+    * @method connectionAt
+    * @access public
+    * @desc Get the connection of the _i-th packed entry, _i below size.
+    *
+    * @param {size_t} _i Position of the entry.
+    * @returns {net::Connection &}
+    */
+    Connection &connectionAt(const std::size_t _i) noexcept
+    {
+        return connections[_i];
+    }
+
+
+    /**
+    * @method stateAt
+    * @access public
+    * @desc Get the state of the _i-th packed entry, _i below size.
+    *
+    * @param {size_t} _i Position of the entry.
+    * @returns {uint8_t}
+    */
+    std::uint8_t stateAt(const std::size_t _i) const noexcept
+    {
+        return states[_i];
+    }
+
+
+    /**
+    * @method lastActiveAt
+    * @access public
+    * @desc Get the time of last activity of the _i-th packed entry, _i below
+    * size.
+    *
+    * @param {size_t} _i Position of the entry.
+    * @returns {time_point}
+    */
+    Clock::time_point lastActiveAt(const std::size_t _i) const noexcept
+    {
+        return activity[_i];
+    }
+};
+}
+
+#endif
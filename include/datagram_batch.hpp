@@ -0,0 +1,179 @@
+#ifndef DATAGRAM_BATCH_HPP
+#define DATAGRAM_BATCH_HPP
+
+#include "socket_family.hpp"
+#include "string_view.hpp"
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+
+
+namespace net {
+
+class Socket;
+
+/**
+* @class net::DatagramBatch
+* @desc Fixed number of preallocated datagram slots, each one holding a
+* payload and the peer address of type Addr (AddrIPv4, AddrIPv6 or AddrUnix),
+* used by Socket::recvmmsg and Socket::sendmmsg to move many datagrams per
+* syscall. All memory is allocated once in the constructor.
+*/
+template <typename Addr>
+class DatagramBatch final {
+    friend class Socket;
+
+    std::size_t slots;
+    std::size_t slotSize;
+    std::size_t used = 0;
+
+    std::unique_ptr<char[]> storage;
+    std::unique_ptr<Addr[]> addrs;
+    std::unique_ptr<iovec[]> iovs;
+    std::unique_ptr<mmsghdr[]> hdrs;
+
+
+    /**
+    * @method prepareRecv
+    * @access private
+    * @desc Points every slot back at its own storage and address so the whole
+    * batch can be filled by recvmmsg.
+    *
+    * @returns {mmsghdr *} Array of slots headers.
+    */
+    mmsghdr *prepareRecv() noexcept
+    {
+        used = 0;
+        for (std::size_t i = 0; i < slots; ++i) {
+            iovs[i].iov_base = storage.get() + i * slotSize;
+            iovs[i].iov_len  = slotSize;
+
+            auto &hdr          = hdrs[i].msg_hdr;
+            hdr.msg_name       = &addrs[i];
+            hdr.msg_namelen    = sizeof(Addr);
+            hdr.msg_iov        = &iovs[i];
+            hdr.msg_iovlen     = 1;
+            hdr.msg_control    = nullptr;
+            hdr.msg_controllen = 0;
+            hdr.msg_flags      = 0;
+            hdrs[i].msg_len    = 0;
+        }
+        return hdrs.get();
+    }
+
+
+public:
+    /**
+    * @construct net::DatagramBatch
+    * @access public
+    * @param {size_t} _slots Maximum number of datagrams in the batch.
+    * @param {size_t} _slotSize Maximum size of each received datagram.
+    */
+    DatagramBatch(const std::size_t _slots, const std::size_t _slotSize = 2048)
+        : slots(_slots),
+          slotSize(_slotSize),
+          storage(std::make_unique<char[]>(_slots * _slotSize)),
+          addrs(std::make_unique<Addr[]>(_slots)),
+          iovs(std::make_unique<iovec[]>(_slots)),
+          hdrs(std::make_unique<mmsghdr[]>(_slots))
+    {
+        prepareRecv();
+    }
+
+    DatagramBatch(DatagramBatch &&) = default;
+    DatagramBatch &operator=(DatagramBatch &&) = default;
+
+
+    auto capacity() const noexcept { return slots; }
+    auto size() const noexcept { return used; }
+    auto empty() const noexcept { return used == 0; }
+    void clear() noexcept { used = 0; }
+
+
+    /**
+    * @method payload
+    * @access public
+    * @desc Get the payload of datagram at given index.
+    *
+    * @param {size_t} _i Index of datagram, less than size().
+    * @returns {StringView} View of the datagram, valid until next recvmmsg.
+    */
+    StringView payload(const std::size_t _i) const noexcept
+    {
+        return StringView(static_cast<const char *>(iovs[_i].iov_base),
+                          hdrs[_i].msg_len);
+    }
+
+
+    /**
+    * @method addr
+    * @access public
+    * @desc Get the source address of received datagram, or the destination
+    * address of datagram to send, at given index.
+    *
+    * @param {size_t} _i Index of datagram, less than size().
+    * @returns {Addr} Address of the datagram peer.
+    */
+    const Addr &addr(const std::size_t _i) const noexcept { return addrs[_i]; }
+
+
+    /**
+    * @method push
+    * @access public
+    * @desc Appends a datagram for Socket::sendmmsg. The payload is referenced,
+    * not copied, so it must outlive the send. Invokes the callable provided to
+    * fill Addr object.
+    * Throws invalid_argument exception if destination address given is invalid.
+    *
+    * @param {StringView} _msg Payload of the datagram.
+    * @param {callable} _fn Some callable that takes arg of type Addr.
+    * @returns {bool} false if the batch is full.
+    */
+    template <typename F>
+    auto push(StringView _msg, F _fn)
+      -> decltype(_fn(std::declval<Addr &>()), bool())
+    {
+        if (used == slots) {
+            return false;
+        }
+
+        if (_fn(addrs[used]) < 1) {
+            throw std::invalid_argument("Address argument invalid");
+        }
+
+        iovs[used].iov_base = const_cast<char *>(_msg.data());
+        iovs[used].iov_len  = _msg.size();
+
+        auto &hdr          = hdrs[used].msg_hdr;
+        hdr.msg_name       = &addrs[used];
+        hdr.msg_namelen    = sizeof(Addr);
+        hdr.msg_iov        = &iovs[used];
+        hdr.msg_iovlen     = 1;
+        hdrs[used].msg_len = _msg.size();
+
+        ++used;
+        return true;
+    }
+
+
+    /**
+    * @method push
+    * @access public
+    * @desc Appends a datagram for Socket::sendmmsg. The payload is referenced,
+    * not copied, so it must outlive the send.
+    *
+    * @param {StringView} _msg Payload of the datagram.
+    * @param {Addr} _to Destination address.
+    * @returns {bool} false if the batch is full.
+    */
+    bool push(StringView _msg, const Addr &_to)
+    {
+        return push(_msg, [&](Addr &s) {
+            s = _to;
+            return 1;
+        });
+    }
+};
+}
+
+#endif
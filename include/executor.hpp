@@ -0,0 +1,143 @@
+#ifndef EXECUTOR_HPP
+#define EXECUTOR_HPP
+
+#include "socket.hpp"
+#include "work_stealing_deque.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace net {
+
+/**
+* @class net::Executor
+* @desc Fixed pool of worker threads running submitted jobs, such as the
+* handlers of accepted connections, so no thread is created per job. Every
+* worker owns a WorkStealingDeque for the jobs submitted from its own jobs;
+* jobs submitted from other threads go through a shared queue. A worker out
+* of jobs steals from the others before it sleeps, and sleeping workers are
+* woken only when jobs are submitted. Destroying the Executor runs the jobs
+* still queued, then joins the workers. An exception escaping a job is
+* handed to the error handler of the Executor, on the worker that ran it,
+* and the worker goes on with the next job.
+*/
+class Executor final {
+public:
+    using ErrorHandler = std::function<void(std::exception_ptr)>;
+
+
+private:
+    struct Job {
+        virtual void run() = 0;
+        virtual ~Job() = default;
+    };
+
+    template <typename Fn>
+    struct FnJob final : Job {
+        Fn fn;
+
+        explicit FnJob(Fn &&_fn) : fn(std::move(_fn)) {}
+        void run() override { fn(); }
+    };
+
+    struct Worker {
+        WorkStealingDeque<Job> jobs;
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    std::mutex sharedMutex;
+    std::deque<Job *> shared;
+
+    std::mutex sleepMutex;
+    std::condition_variable wakeup;
+    std::atomic<std::size_t> sleepers;
+    std::atomic<bool> stopping;
+
+    ErrorHandler onError;
+
+    Executor(const Executor &) = delete;
+    Executor &operator=(const Executor &) = delete;
+
+    void enqueue(std::unique_ptr<Job>);
+    Job *find(std::size_t) noexcept;
+    void work(std::size_t) noexcept;
+
+
+public:
+    /**
+    * @construct net::Executor
+    * @access public
+    * @desc Starts the worker threads.
+    *
+    * @param {size_t} _threads Number of workers, 0 for one per core.
+    * @param {ErrorHandler} _onError Called with the exceptions escaping jobs,
+    * concurrently from any worker. It must not throw. If empty, such
+    * exceptions are dropped.
+    */
+    explicit Executor(std::size_t _threads = 0, ErrorHandler _onError = {});
+
+
+    /**
+    * @method submit
+    * @access public
+    * @desc Queues _fn to run on a worker. Any thread may submit, including
+    * the jobs themselves. Costs one allocation; move-only callables are
+    * accepted.
+    *
+    * @param {callable} _fn Callable taking no arguments.
+    */
+    template <typename Fn>
+    void submit(Fn &&_fn)
+    {
+        using Callable = typename std::decay<Fn>::type;
+        enqueue(std::make_unique<FnJob<Callable>>(
+          Callable(std::forward<Fn>(_fn))));
+    }
+
+
+    /**
+    * @method submit
+    * @access public
+    * @desc Hands _sock over to a worker which calls _fn with it, as is done
+    * with the Sockets a server accepts.
+    *
+    * @param {Socket} _sock Socket to hand over.
+    * @param {callable} _fn Callable taking a Socket &.
+    */
+    template <typename Fn>
+    void submit(Socket &&_sock, Fn _fn)
+    {
+        auto sock = std::make_unique<Socket>(std::move(_sock));
+        submit([ sock = std::move(sock), fn = std::move(_fn) ]() mutable {
+            fn(*sock);
+        });
+    }
+
+
+    /**
+    * @method size
+    * @access public
+    * @desc Get the number of worker threads.
+    *
+    * @returns {size_t}
+    */
+    std::size_t size() const noexcept { return workers.size(); }
+
+
+    ~Executor() noexcept;
+};
+}
+
+#endif
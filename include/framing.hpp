@@ -0,0 +1,150 @@
+#ifndef FRAMING_HPP
+#define FRAMING_HPP
+
+#include "buffered_reader.hpp"
+#include "socket.hpp"
+#include "string_view.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+
+namespace net {
+
+/**
+* @class net::FrameWriter
+* @desc Writes length-prefixed frames, each a 4 byte big-endian length
+* followed by the payload, to a stream Socket. Frames are encoded one after
+* the other into an outgoing buffer which is sent once it holds a batch, so
+* many small frames cost a single send call.
+* On a SEQPACKET Socket a flush sends the buffer as packets of whole frames,
+* each at most the size of one largest frame with its header, so a
+* FrameReader with a maximum frame size no smaller than the writer's always
+* has room for them.
+*/
+class FrameWriter final {
+    const Socket &sock;
+    std::size_t batch;
+    std::size_t maxFrame;
+    bool packets;
+    std::string buf;
+    std::size_t sent = 0;
+
+    FrameWriter(const FrameWriter &) = delete;
+    FrameWriter &operator=(const FrameWriter &) = delete;
+
+    std::size_t packetLen() const noexcept;
+
+
+public:
+    /**
+    * @construct net::FrameWriter
+    * @access public
+    * @param {Socket} _sock Socket to write to, which must outlive the writer.
+    * @param {size_t} _batch Buffered bytes from which write flushes.
+    * @param {size_t} _maxFrame Largest payload accepted.
+    */
+    explicit FrameWriter(const Socket &, const std::size_t = 65536,
+                         const std::size_t = 1 << 20);
+
+
+    /**
+    * @method write
+    * @access public
+    * @desc Appends a frame with given payload to the outgoing buffer, and
+    * flushes if it holds at least a batch.
+    * Throws invalid_argument exception if the payload exceeds the maximum
+    * frame size. See flush for the other errors.
+    *
+    * @param {StringView} _payload Payload of the frame.
+    * @param {bool *} _errorNB To signal error in case of non-blocking send.
+    */
+    void write(StringView, bool * = nullptr);
+
+
+    /**
+    * @method flush
+    * @access public
+    * @desc Sends all buffered frames if successful else throws runtime_error
+    * exception. On a non-blocking Socket the bytes not sent stay buffered
+    * for the next flush and _errorNB is set.
+    * Throws invalid_argument exception in case of non-blocking net::Socket if
+    * _errorNB is missing.
+    *
+    * @param {bool *} _errorNB To signal error in case of non-blocking send.
+    * @returns {bool} true if the buffer was emptied.
+    */
+    bool flush(bool * = nullptr);
+
+
+    /**
+    * @method pending
+    * @access public
+    * @desc Get the number of encoded bytes not sent yet.
+    *
+    * @returns {size_t}
+    */
+    std::size_t pending() const noexcept { return buf.size() - sent; }
+};
+
+
+/**
+* @class net::FrameReader
+* @desc Reads length-prefixed frames, as written by FrameWriter, from a stream
+* Socket. Frames are received through a BufferedReader, so a single recv
+* brings in as many frames as are available, and payloads are returned as
+* views into its buffer without copying. On a SEQPACKET Socket a packet too
+* large for the buffer is detected and throws instead of being truncated.
+*/
+class FrameReader final {
+    BufferedReader reader;
+    std::size_t maxFrame;
+    std::uint32_t frameLen = 0;
+    bool inFrame           = false;
+
+    FrameReader(const FrameReader &) = delete;
+    FrameReader &operator=(const FrameReader &) = delete;
+
+
+public:
+    /**
+    * @construct net::FrameReader
+    * @access public
+    * @param {Socket} _sock Socket to read from, which must outlive the reader.
+    * @param {size_t} _maxFrame Largest payload accepted, which also sizes the
+    * receive buffer.
+    */
+    explicit FrameReader(const Socket &, const std::size_t = 1 << 20);
+
+
+    /**
+    * @method read
+    * @access public
+    * @desc Reads the next frame if successful else throws runtime_error
+    * exception, also when the peer announces a payload larger than the
+    * maximum frame size or sends a packet larger than the buffer. Returns
+    * false, keeping the partial frame buffered, if the peer closed the
+    * connection or, in case of a non-blocking Socket, on setting _errorNB.
+    * The payload view stays valid until the next call.
+    * Throws invalid_argument exception in case of non-blocking net::Socket if
+    * _errorNB is missing.
+    *
+    * @param {StringView} _payload Set to the payload of the frame.
+    * @param {bool *} _errorNB To signal error in case of non-blocking recv.
+    * @returns {bool} true if a whole frame was read.
+    */
+    bool read(StringView &, bool * = nullptr);
+
+
+    /**
+    * @method eof
+    * @access public
+    * @desc Whether the peer closed the connection.
+    *
+    * @returns {bool}
+    */
+    bool eof() const noexcept { return reader.eof(); }
+};
+}
+
+#endif
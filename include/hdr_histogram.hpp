@@ -0,0 +1,199 @@
+#ifndef HDR_HISTOGRAM_HPP
+#define HDR_HISTOGRAM_HPP
+
+#include "string_view.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+
+namespace net {
+
+/**
+* @class net::HdrHistogram
+* @desc Log-linear histogram of unsigned values, in the manner of
+* HdrHistogram: every power of 2 is split into 2^subBits linear buckets, so
+* any value is kept within a relative error of 2^-subBits whatever its
+* magnitude, in a fixed array of (maxBits - subBits + 1) << subBits counters.
+* Values of maxBits bits or more count as the largest one below.
+*
+* Recording is wait-free: a thread records into its own histogram with a
+* relaxed load and store per counter, no read-modify-write, while any thread
+* may read it or merge it into another at the same time. Histograms of
+* several threads are summed with merge.
+*/
+class HdrHistogram final {
+    unsigned subBits;
+    unsigned maxBits;
+    std::uint64_t limit;
+    std::size_t buckets;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> counts;
+    std::atomic<std::uint64_t> total;
+    std::atomic<std::uint64_t> max;
+
+    HdrHistogram &operator=(const HdrHistogram &) = delete;
+
+    static void add(std::atomic<std::uint64_t> &_c, const std::uint64_t _n)
+    {
+        _c.store(_c.load(std::memory_order_relaxed) + _n,
+                 std::memory_order_relaxed);
+    }
+
+    std::size_t index(std::uint64_t _v) const noexcept
+    {
+        _v = (_v < limit) ? _v : limit;
+        if (_v < (std::uint64_t(1) << subBits)) {
+            return _v;
+        }
+
+        const unsigned top   = 63 - __builtin_clzll(_v);
+        const unsigned shift = top - subBits;
+        return ((std::size_t(shift) + 1) << subBits)
+          + ((_v >> shift) - (std::uint64_t(1) << subBits));
+    }
+
+    std::uint64_t highest(std::size_t) const noexcept;
+
+
+public:
+    /**
+    * @construct net::HdrHistogram
+    * @access public
+    * @desc Creates an empty histogram. The defaults keep nanoseconds up to
+    * 18 minutes within 1.6%, in 2240 counters.
+    * Throws invalid_argument exception if _subBits is above 16 or not below
+    * _maxBits, or if _maxBits is above 64.
+    *
+    * @param {unsigned} _subBits Linear buckets per power of 2, as a power of
+    * 2.
+    * @param {unsigned} _maxBits Bits of the largest value kept exactly.
+    */
+    explicit HdrHistogram(unsigned = 6, unsigned = 40);
+
+
+    /**
+    * @construct net::HdrHistogram
+    * @access public
+    * @desc Creates a snapshot of _other, which may still be recording.
+    *
+    * @param {HdrHistogram} _other Histogram to copy.
+    */
+    HdrHistogram(const HdrHistogram &);
+
+
+    /**
+    * @method record
+    * @access public
+    * @desc Counts _n occurrences of _v. Only one thread may record into a
+    * histogram at a time.
+    *
+    * @param {uint64_t} _v Value to count.
+    * @param {uint64_t} _n Number of occurrences.
+    */
+    void record(const std::uint64_t _v, const std::uint64_t _n = 1) noexcept
+    {
+        add(counts[index(_v)], _n);
+        add(total, _n);
+        if (_v > max.load(std::memory_order_relaxed)) {
+            max.store(_v, std::memory_order_relaxed);
+        }
+    }
+
+
+    /**
+    * @method count
+    * @access public
+    * @desc Number of values recorded.
+    *
+    * @returns {uint64_t}
+    */
+    std::uint64_t count() const noexcept
+    {
+        return total.load(std::memory_order_relaxed);
+    }
+
+
+    /**
+    * @method maximum
+    * @access public
+    * @desc Largest value recorded, exact.
+    *
+    * @returns {uint64_t}
+    */
+    std::uint64_t maximum() const noexcept
+    {
+        return max.load(std::memory_order_relaxed);
+    }
+
+
+    /**
+    * @method bucketCount
+    * @access public
+    * @desc Number of buckets of the layout, each a 64-bit counter.
+    *
+    * @returns {size_t}
+    */
+    std::size_t bucketCount() const noexcept { return buckets; }
+
+
+    /**
+    * @method percentile
+    * @access public
+    * @desc Highest value of the bucket holding the _p-th percentile, never
+    * above maximum.
+    *
+    * @param {double} _p Percentile, from 0 to 100.
+    * @returns {uint64_t} 0 if nothing was recorded.
+    */
+    std::uint64_t percentile(double) const noexcept;
+
+
+    /**
+    * @method merge
+    * @access public
+    * @desc Adds the counts of _other, which may still be recording. Only the
+    * thread recording into this histogram may merge into it.
+    * Throws invalid_argument exception if the bucket layouts differ.
+    *
+    * @param {HdrHistogram} _other Histogram to add.
+    */
+    void merge(const HdrHistogram &);
+
+
+    /**
+    * @method reset
+    * @access public
+    * @desc Forgets every value. Only the thread recording into this histogram
+    * may reset it.
+    */
+    void reset() noexcept;
+
+
+    /**
+    * @method serialize
+    * @access public
+    * @desc Encodes the histogram compactly: its layout and maximum, then the
+    * non-zero counters only, each as the number of zero counters skipped and
+    * its count, in LEB128 varints.
+    *
+    * @returns {std::string}
+    */
+    std::string serialize() const;
+
+
+    /**
+    * @method deserialize
+    * @access public
+    * @desc Decodes a histogram encoded by serialize.
+    * Throws invalid_argument exception if _data is not such an encoding.
+    *
+    * @param {StringView} _data Encoded histogram.
+    * @returns {net::HdrHistogram}
+    */
+    static HdrHistogram deserialize(StringView);
+};
+}
+
+#endif
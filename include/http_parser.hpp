@@ -0,0 +1,171 @@
+#ifndef HTTP_PARSER_HPP
+#define HTTP_PARSER_HPP
+
+#include "string_view.hpp"
+#include <cstddef>
+
+
+namespace net {
+
+/**
+* @class net::HttpHeader
+* @desc Header field of an HttpRequest, as views into the parsed buffer.
+*/
+struct HttpHeader {
+    StringView name;
+    StringView value;
+};
+
+
+/**
+* @class net::HttpRequest
+* @desc Request line and header fields of an HTTP/1.x request, as filled by
+* HttpParser. All views point into the parsed buffer, nothing is copied, so
+* they stay valid as long as its bytes.
+*/
+class HttpRequest final {
+    friend class HttpParser;
+
+public:
+    static constexpr std::size_t maxHeaders = 64;
+
+private:
+    StringView methodView;
+    StringView targetView;
+    int minor           = 1;
+    std::size_t count   = 0;
+    std::size_t headLen = 0;
+    std::size_t bodyLen = 0;
+    HttpHeader fields[maxHeaders];
+
+
+public:
+    /**
+    * @method method
+    * @access public
+    * @desc Get the request method, such as GET.
+    *
+    * @returns {StringView}
+    */
+    StringView method() const noexcept { return methodView; }
+
+
+    /**
+    * @method target
+    * @access public
+    * @desc Get the request target, usually the path and query.
+    *
+    * @returns {StringView}
+    */
+    StringView target() const noexcept { return targetView; }
+
+
+    /**
+    * @method version
+    * @access public
+    * @desc Get the minor version, 0 for HTTP/1.0 and 1 for HTTP/1.1.
+    *
+    * @returns {int}
+    */
+    int version() const noexcept { return minor; }
+
+
+    /**
+    * @method header
+    * @access public
+    * @desc Get the value of the first header field named _name, compared
+    * case-insensitively, or an empty view if there is none.
+    *
+    * @param {StringView} _name Name of the header field.
+    * @returns {StringView}
+    */
+    StringView header(StringView) const noexcept;
+
+
+    /**
+    * @method keepAlive
+    * @access public
+    * @desc Whether the connection persists after this request: by default for
+    * HTTP/1.1 unless Connection is close, and for HTTP/1.0 only if
+    * Connection is keep-alive.
+    *
+    * @returns {bool}
+    */
+    bool keepAlive() const noexcept;
+
+
+    /**
+    * @method headLength
+    * @access public
+    * @desc Get the length of the request line and header fields, including
+    * the empty line ending them. The body, if any, follows.
+    *
+    * @returns {size_t}
+    */
+    std::size_t headLength() const noexcept { return headLen; }
+
+
+    /**
+    * @method contentLength
+    * @access public
+    * @desc Get the length of the body from Content-Length, 0 if absent.
+    * Requests with a Transfer-Encoding are never COMPLETE, so this always
+    * frames the body.
+    *
+    * @returns {size_t}
+    */
+    std::size_t contentLength() const noexcept { return bodyLen; }
+
+
+    const HttpHeader *begin() const noexcept { return fields; }
+    const HttpHeader *end() const noexcept { return fields + count; }
+    std::size_t size() const noexcept { return count; }
+};
+
+
+enum class HttpStatus { COMPLETE, PARTIAL, INVALID, UNSUPPORTED };
+
+
+/**
+* @class net::HttpParser
+* @desc Incremental HTTP/1.x request parser. It is called on the bytes
+* received so far, again with the same start once more have arrived, and
+* reports PARTIAL until the whole head is there. Each call only searches the
+* new bytes for the end of the head, and the head is parsed once, scanning
+* header fields with SSE4.2 or AVX2 when the CPU has them. Nothing is
+* allocated. Requests pipelined after the returned one are parsed from
+* headLength() + contentLength() on.
+*/
+class HttpParser final {
+    std::size_t scanned = 0;
+
+public:
+    /**
+    * @method parse
+    * @access public
+    * @desc Parses the request at the start of _buf into _req. INVALID means
+    * the request is malformed or has too many header fields, and the
+    * connection should be answered with 400 and closed. Transfer-Encoding
+    * together with Content-Length is INVALID too, since peers disagreeing
+    * on which one frames the body is how requests are smuggled.
+    * UNSUPPORTED means a body in a Transfer-Encoding such as chunked, which
+    * is not decoded; answer with 501 and close, as the end of the body is
+    * unknown.
+    *
+    * @param {StringView} _buf Bytes received so far.
+    * @param {HttpRequest} _req Request to fill on COMPLETE.
+    * @returns {HttpStatus}
+    */
+    HttpStatus parse(StringView, HttpRequest &) noexcept;
+
+
+    /**
+    * @method reset
+    * @access public
+    * @desc Forgets a partial request, to parse an unrelated buffer.
+    */
+    void reset() noexcept { scanned = 0; }
+};
+}
+
+#endif
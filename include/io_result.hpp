@@ -0,0 +1,133 @@
+#ifndef IO_RESULT_HPP
+#define IO_RESULT_HPP
+
+#include <cstddef>
+#include <system_error>
+
+extern "C" {
+#include <sys/types.h>
+#include <errno.h>
+}
+
+
+namespace net {
+
+/**
+* @class net::IoResult
+* @desc Outcome of a non-throwing Socket call, as returned by Socket::tryRecv
+* and friends. Holds either the number of bytes transferred or the errno of
+* the failure, packed in a single word the way the system calls report it,
+* so returning it costs nothing compared to throwing.
+*/
+class IoResult final {
+    ssize_t value;
+
+public:
+    /**
+    * @construct net::IoResult
+    * @access public
+    * @param {ssize_t} _value Number of bytes, or minus the errno of the
+    * failure.
+    */
+    constexpr explicit IoResult(const ssize_t _value = 0) noexcept
+        : value(_value)
+    {
+    }
+
+
+    /**
+    * @method fromErrno
+    * @access public
+    * @desc Failed result carrying the given errno.
+    *
+    * @param {int} _errno Error number of the failure.
+    * @returns {IoResult}
+    */
+    static constexpr IoResult fromErrno(const int _errno) noexcept
+    {
+        return IoResult(-static_cast<ssize_t>(_errno));
+    }
+
+
+    /**
+    * @method ok
+    * @access public
+    * @desc Whether the call succeeded. A successful recv of 0 bytes on a
+    * stream Socket means the peer closed the connection.
+    *
+    * @returns {bool}
+    */
+    constexpr bool ok() const noexcept { return value >= 0; }
+
+    constexpr explicit operator bool() const noexcept { return ok(); }
+
+
+    /**
+    * @method bytes
+    * @access public
+    * @desc Get the number of bytes transferred, 0 for a failed call.
+    *
+    * @returns {size_t}
+    */
+    constexpr std::size_t bytes() const noexcept
+    {
+        return ok() ? static_cast<std::size_t>(value) : 0;
+    }
+
+
+    /**
+    * @method errorNumber
+    * @access public
+    * @desc Get the errno of the failure, 0 for a successful call.
+    *
+    * @returns {int}
+    */
+    constexpr int errorNumber() const noexcept
+    {
+        return ok() ? 0 : static_cast<int>(-value);
+    }
+
+
+    /**
+    * @method wouldBlock
+    * @access public
+    * @desc Whether the call failed only because the non-blocking Socket was
+    * not ready, the case signalled through _errorNB by the throwing calls.
+    *
+    * @returns {bool}
+    */
+    constexpr bool wouldBlock() const noexcept
+    {
+        return errorNumber() == EAGAIN || errorNumber() == EWOULDBLOCK;
+    }
+
+
+    /**
+    * @method inProgress
+    * @access public
+    * @desc Whether a non-blocking connect was started and completes later.
+    *
+    * @returns {bool}
+    */
+    constexpr bool inProgress() const noexcept
+    {
+        return errorNumber() == EINPROGRESS;
+    }
+
+
+    /**
+    * @method error
+    * @access public
+    * @desc Get the failure as std::error_code of the system category, empty
+    * for a successful call. Compares equal to the matching std::errc.
+    *
+    * @returns {std::error_code}
+    */
+    std::error_code error() const noexcept
+    {
+        return std::error_code(errorNumber(), std::system_category());
+    }
+};
+}
+
+#endif
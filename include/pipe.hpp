@@ -0,0 +1,92 @@
+#ifndef PIPE_HPP
+#define PIPE_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include "socket_family.hpp"
+
+extern "C" {
+#include <fcntl.h>
+}
+
+
+namespace net {
+
+class Socket;
+
+/**
+* @class net::Pipe
+* @desc Kernel pipe used by Socket::splice to move bytes between descriptors
+* without copying them to user space. Keeps track of bytes spliced in but not
+* yet spliced out, so a transfer interrupted by a non-blocking destination
+* resumes without losing data. One Pipe per connection being spliced.
+*/
+class Pipe final {
+    friend class Socket;
+
+    int fds[2];
+    std::size_t used = 0;
+    std::size_t size = 0;
+
+    Pipe(const Pipe &) = delete;
+    Pipe &operator=(const Pipe &) = delete;
+
+public:
+    /**
+    * @construct net::Pipe
+    * @access public
+    * @desc Creates the pipe if successful else throws runtime_error exception.
+    */
+    Pipe()
+    {
+        if (pipe2(fds, O_CLOEXEC) < 0) {
+            const auto currErrno = errno;
+            throw std::runtime_error(net::methods::getErrorMsg(currErrno));
+        }
+
+        const auto res = fcntl(fds[0], F_GETPIPE_SZ);
+        size           = (res > 0) ? res : 65536;
+    }
+
+
+    Pipe(Pipe &&p) noexcept : used(p.used), size(p.size)
+    {
+        fds[0] = p.fds[0];
+        fds[1] = p.fds[1];
+
+        p.fds[0] = p.fds[1] = -1;
+        p.used              = 0;
+    }
+
+
+    /**
+    * @method pending
+    * @access public
+    * @desc Get the number of bytes inside the pipe waiting to be spliced out.
+    *
+    * @returns {size_t} Bytes pending in the pipe.
+    */
+    auto pending() const noexcept { return used; }
+
+
+    /**
+    * @method capacity
+    * @access public
+    * @desc Get the capacity of the pipe.
+    *
+    * @returns {size_t} Capacity of the pipe in bytes.
+    */
+    auto capacity() const noexcept { return size; }
+
+
+    ~Pipe() noexcept
+    {
+        if (fds[0] != -1) {
+            ::close(fds[0]);
+            ::close(fds[1]);
+        }
+    }
+};
+}
+
+#endif
@@ -0,0 +1,212 @@
+#ifndef REACTOR_HPP
+#define REACTOR_HPP
+
+#include "socket.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+extern "C" {
+#include <sys/epoll.h>
+}
+
+
+namespace net {
+
+enum class Event : std::uint32_t {
+    NONE      = 0,
+    READ      = EPOLLIN,
+    WRITE     = EPOLLOUT,
+    PRIORITY  = EPOLLPRI,
+    PEERCLOSE = EPOLLRDHUP,
+    HANGUP    = EPOLLHUP,
+    ERROR     = EPOLLERR,
+    EDGE      = EPOLLET,
+    ONESHOT   = EPOLLONESHOT
+};
+inline constexpr Event operator|(Event a, Event b) noexcept
+{
+    return static_cast<Event>(static_cast<std::uint32_t>(a)
+                              | static_cast<std::uint32_t>(b));
+}
+
+/**
+* @function hasEvent
+* @desc Check if any of the events in _mask is set in _events.
+*
+* @param {Event} _events Events received by a Reactor callback.
+* @param {Event} _mask Events to look for.
+* @returns {bool} true if at least one event of _mask is set.
+*/
+inline constexpr bool hasEvent(Event _events, Event _mask) noexcept
+{
+    return (static_cast<std::uint32_t>(_events)
+            & static_cast<std::uint32_t>(_mask))
+      != 0;
+}
+
+
+/**
+* @class net::Reactor
+* @desc Readiness event loop over epoll. Descriptors, usually those of
+* non-blocking net::Socket objects, are registered with the events they are
+* interested in and a callback, which the loop invokes with the events that
+* occurred. Interest is level-triggered unless Event::EDGE is given, in which
+* case the callback must drain the descriptor until _errorNB is set.
+* All methods but stop must be called from the thread running the loop.
+*/
+class Reactor final {
+public:
+    using Callback = std::function<void(Event)>;
+
+private:
+    int epfd;
+    int wakefd;
+    std::atomic<bool> stopped;
+    std::size_t registered = 0;
+    bool dispatching       = false;
+
+    std::vector<epoll_event> events;
+    std::vector<std::unique_ptr<Callback>> handlers;
+    std::vector<std::unique_ptr<Callback>> retired;
+
+    // Per descriptor, bumped by every add. Events carry it beside the
+    // descriptor, so an event of a descriptor closed and registered again
+    // by a callback earlier in the same batch is told apart and dropped.
+    std::vector<std::uint32_t> generations;
+
+    Reactor(const Reactor &) = delete;
+    Reactor &operator=(const Reactor &) = delete;
+
+    std::uint64_t token(const int _fd) const noexcept
+    {
+        const auto index = static_cast<std::size_t>(_fd);
+        const std::uint64_t generation
+          = (index < generations.size()) ? generations[index] : 0;
+        return (generation << 32) | static_cast<std::uint32_t>(_fd);
+    }
+
+
+public:
+    /**
+    * @construct net::Reactor
+    * @access public
+    * @desc Creates the epoll instance if successful else throws runtime_error
+    * exception.
+    *
+    * @param {size_t} _maxEvents Maximum number of events handled per poll.
+    */
+    explicit Reactor(const std::size_t _maxEvents = 256);
+
+    ~Reactor() noexcept;
+
+
+    /**
+    * @method add
+    * @access public
+    * @desc Registers descriptor _fd for _events with callback _fn if
+    * successful else throws runtime_error exception. Event::HANGUP and
+    * Event::ERROR are always reported.
+    *
+    * @param {int} _fd Descriptor to watch.
+    * @param {Event} _events Bitwise OR of events of interest.
+    * @param {Callback} _fn Callable invoked with the events that occurred.
+    */
+    void add(const int, Event, Callback);
+
+
+    /**
+    * @method add
+    * @access public
+    * @desc Registers Socket _s for _events with callback _fn if successful
+    * else throws runtime_error exception. _s must outlive its registration.
+    *
+    * @param {Socket} _s Socket to watch.
+    * @param {Event} _events Bitwise OR of events of interest.
+    * @param {Callback} _fn Callable invoked with the events that occurred.
+    */
+    void add(const Socket &_s, Event _events, Callback _fn)
+    {
+        add(_s.getSocket(), _events, std::move(_fn));
+    }
+
+
+    /**
+    * @method modify
+    * @access public
+    * @desc Replaces the events of interest of registered descriptor _fd if
+    * successful else throws runtime_error exception. Also rearms a descriptor
+    * registered with Event::ONESHOT.
+    *
+    * @param {int} _fd Registered descriptor.
+    * @param {Event} _events Bitwise OR of events of interest.
+    */
+    void modify(const int, Event);
+
+    void modify(const Socket &_s, Event _events)
+    {
+        modify(_s.getSocket(), _events);
+    }
+
+
+    /**
+    * @method remove
+    * @access public
+    * @desc Unregisters descriptor _fd if successful else throws runtime_error
+    * exception. May be called from any callback, including the one of _fd,
+    * which stays alive until it returns. Events of _fd still pending in the
+    * current poll are dropped, even if _fd is closed and a descriptor reusing
+    * its number is added meanwhile.
+    *
+    * @param {int} _fd Registered descriptor.
+    */
+    void remove(const int);
+
+    void remove(const Socket &_s) { remove(_s.getSocket()); }
+
+
+    /**
+    * @method poll
+    * @access public
+    * @desc Waits for events for at most _timeout milliseconds and invokes the
+    * callbacks of ready descriptors if successful else throws runtime_error
+    * exception.
+    *
+    * @param {int} _timeout Milliseconds to wait, -1 to wait indefinitely.
+    * @returns {size_t} Number of callbacks invoked.
+    */
+    std::size_t poll(const int = -1);
+
+
+    /**
+    * @method run
+    * @access public
+    * @desc Polls until stop is called.
+    */
+    void run();
+
+
+    /**
+    * @method stop
+    * @access public
+    * @desc Makes run return after the current poll, or right away if it is
+    * not running yet. Safe to call from any thread or callback.
+    */
+    void stop() noexcept;
+
+
+    /**
+    * @method size
+    * @access public
+    * @desc Get the number of registered descriptors.
+    *
+    * @returns {size_t} Number of registered descriptors.
+    */
+    auto size() const noexcept { return registered; }
+};
+}
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef SHARDED_SERVER_HPP
+#define SHARDED_SERVER_HPP
+
+#include "reactor.hpp"
+#include "socket.hpp"
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+
+namespace net {
+
+/**
+* @class net::ShardedServer
+* @desc Server bootstrap running one shard per worker thread. Every shard
+* owns a non-blocking listening Socket bound to the same address and port
+* with Opt::REUSEPORT, so the kernel spreads incoming connections over the
+* shards and no accept lock is shared, and a private Reactor driving it.
+* Workers are pinned to distinct cores, so a connection is handled on the
+* core that accepted it.
+*/
+class ShardedServer final {
+public:
+    /**
+    * Invoked on the worker thread of every shard before its loop starts;
+    * registers the listener, typically to accept in a callback.
+    */
+    using Setup = std::function<void(Reactor &, Socket &, std::size_t)>;
+
+private:
+    bool pin;
+    std::vector<Socket> listeners;
+    std::vector<std::unique_ptr<Reactor>> reactors;
+
+    ShardedServer(const ShardedServer &) = delete;
+    ShardedServer &operator=(const ShardedServer &) = delete;
+
+
+public:
+    /**
+    * @construct net::ShardedServer
+    * @access public
+    * @desc Binds and listens on all shards if successful else throws
+    * runtime_error exception.
+    *
+    * @param {Domain} _domain Domain::IPv4 or Domain::IPv6.
+    * @param {char []} _addr Address to listen on.
+    * @param {int} _port Port to listen on.
+    * @param {size_t} _shards Number of shards, 0 for one per usable core.
+    * @param {bool} _pin Pin each worker to its own core.
+    */
+    ShardedServer(Domain, const char[], const int, std::size_t = 0,
+                  const bool = true);
+
+
+    /**
+    * @method run
+    * @access public
+    * @desc Starts one worker per shard, calls _setup on it and runs its loop
+    * until stop is called. Blocks until all workers returned. Rethrows the
+    * first exception thrown by a worker, which also stops the others.
+    *
+    * @param {Setup} _setup Callable preparing each shard.
+    */
+    void run(Setup);
+
+
+    /**
+    * @method stop
+    * @access public
+    * @desc Stops the loops of all shards. Safe to call from any thread.
+    */
+    void stop() noexcept;
+
+
+    /**
+    * @method size
+    * @access public
+    * @desc Get the number of shards.
+    *
+    * @returns {size_t} Number of shards.
+    */
+    auto size() const noexcept { return listeners.size(); }
+};
+}
+
+#endif
@@ -2,6 +2,15 @@
 #define SOCKET_HPP
 
 #include "socket_family.hpp"
+#include "buffer_pool.hpp"
+#include "datagram_batch.hpp"
+#include "io_result.hpp"
+#include "pipe.hpp"
+#include "socket_stats.hpp"
+#include "string_view.hpp"
+#include "zero_copy.hpp"
+#include <cstddef>
+#include <initializer_list>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -17,6 +26,8 @@ namespace net {
 */
 class Socket {
 private:
+    friend class Connection;
+
     union {
         AddrStore store;
         AddrIPv4 ipv4;
@@ -27,6 +38,24 @@ private:
     Domain sock_domain;
     Type sock_type;
     bool isClosed = false;
+#ifdef NET_SOCKET_STATS
+    SocketStats *stats = nullptr;
+
+    SocketStats *attachedStats() const noexcept { return stats; }
+#else
+    SocketStats *attachedStats() const noexcept { return nullptr; }
+#endif
+
+    // Bytes in the first _n datagrams of a batch for StatsProbe, or -1 as
+    // returned by a failed recvmmsg or sendmmsg.
+    static ssize_t batchBytes(const mmsghdr *_hdrs, const int _n) noexcept
+    {
+        ssize_t bytes = (_n == -1) ? -1 : 0;
+        for (auto i = 0; i < _n; ++i) {
+            bytes += _hdrs[i].msg_len;
+        }
+        return bytes;
+    }
 
 
     /**
@@ -36,23 +65,26 @@ private:
     * flags and destination socket address.
     *
     * @param {callable} _fn Some callable that writes using socket descriptor.
-    * @param {string} _msg Msg to write on sockfd.
+    * @param {char *} _msg Msg to write on sockfd.
+    * @param {size_t} _len Number of bytes of _msg to write.
     * @param {parameter_pack} args Flags, destination sockaddr objects and their
     * lengths.
     * @returns {ssize_t} Status of writing _msg using socket descriptor / Number
     * of bytes written using socket descriptor.
     */
     template <typename Fn, typename... Args>
-    auto low_write(Fn &&_fn, const std::string &_msg, Args &&... args) const
+    auto low_write(Fn &&_fn, const char *_msg, const std::size_t _len,
+                   Args &&... args) const
     {
-        ssize_t written              = 0;
-        std::string::size_type count = 0;
+        ssize_t written   = 0;
+        std::size_t count = 0;
         do {
-            written = std::forward<Fn>(_fn)(sockfd, _msg.c_str() + count,
-                                            _msg.length() - count,
+            StatsProbe probe(StatOp::WRITE, attachedStats());
+            written = std::forward<Fn>(_fn)(sockfd, _msg + count, _len - count,
                                             std::forward<Args>(args)...);
             count += written;
-        } while (count < _msg.length() && written > 0);
+            probe.done(written, written > 0 && count < _len);
+        } while (count < _len && written > 0);
 
         return written;
     }
@@ -62,28 +94,193 @@ private:
     * @method low_read
     * @access private
     * @desc Reads using sockfd by calling _fn  with args having flags and
-    * destination socket address.
+    * destination socket address, directly into the given buffer.
     *
     * @param {callable} _fn Some callable that reads using socket descriptor.
-    * @param {string} _str String to store the data.
+    * @param {char *} _buf Buffer to store the data.
+    * @param {size_t} _len Capacity of _buf in bytes.
     * @param {parameter_pack} args Flags, destination sockaddr objects and their
     * lengths.
     * @returns {ssize_t} Status of reading data using socket descriptor / Number
     * of bytes read using socket descriptor.
     */
     template <typename Fn, typename... Args>
-    auto low_read(Fn &&_fn, std::string &_str, Args &&... args) const
+    auto low_read(Fn &&_fn, char *_buf, const std::size_t _len,
+                  Args &&... args) const
+    {
+        StatsProbe probe(StatOp::READ, attachedStats());
+        const auto res = std::forward<Fn>(_fn)(sockfd, _buf, _len,
+                                               std::forward<Args>(args)...);
+        probe.done(res);
+        return res;
+    }
+
+
+    /**
+    * @method low_writev
+    * @access private
+    * @desc Writes all the given buffers using sockfd by calling _fn with an
+    * iovec array, continuing after partial writes from the exact byte where
+    * the previous call stopped even if it falls inside some buffer. Buffers
+    * are gathered in chunks of at most 64 per call.
+    *
+    * @param {callable} _fn Some callable taking sockfd, iovec * and count.
+    * @param {StringView *} _bufs Buffers to write on sockfd.
+    * @param {size_t} _count Number of buffers.
+    * @param {size_t} _total Set to the number of bytes written by all calls.
+    * @returns {ssize_t} Status of last call of _fn / Number of bytes written
+    * by it.
+    */
+    template <typename Fn>
+    auto low_writev(Fn &&_fn, const StringView *_bufs, std::size_t _count,
+                    std::size_t &_total) const
+    {
+        constexpr std::size_t maxIov = 64;
+        iovec iov[maxIov];
+        ssize_t written = 0;
+        _total          = 0;
+
+        while (_count > 0) {
+            std::size_t left = 0;
+            for (; left < _count && left < maxIov; ++left) {
+                iov[left].iov_base = const_cast<char *>(_bufs[left].data());
+                iov[left].iov_len  = _bufs[left].size();
+            }
+            _bufs += left;
+            _count -= left;
+
+            auto curr = iov;
+            while (true) {
+                while (left > 0 && curr->iov_len == 0) {
+                    ++curr;
+                    --left;
+                }
+                if (left == 0) {
+                    break;
+                }
+
+                StatsProbe probe(StatOp::WRITE, attachedStats());
+                written = _fn(sockfd, curr, static_cast<int>(left));
+                if (written <= 0) {
+                    probe.done(written);
+                    return written;
+                }
+
+                auto done = static_cast<std::size_t>(written);
+                _total += done;
+                while (left > 0 && done >= curr->iov_len) {
+                    done -= curr->iov_len;
+                    ++curr;
+                    --left;
+                }
+                if (left > 0) {
+                    curr->iov_base = static_cast<char *>(curr->iov_base) + done;
+                    curr->iov_len -= done;
+                }
+                probe.done(written, left > 0);
+            }
+        }
+
+        return written;
+    }
+
+
+    /**
+    * @method low_recvfrom
+    * @access private
+    * @desc Receives into _buf using recvfrom and invokes _fn with the Addr
+    * object from where msg has been received, if successful else throws
+    * runtime_error exception.
+    * Throws invalid_argument exception in case of non-blocking net::Socket if
+    * _errorNB is missing.
+    *
+    * @param {char *} _buf Buffer to store the data.
+    * @param {size_t} _len Capacity of _buf in bytes.
+    * @param {callable} _fn Some callable that takes arg of type Addr.
+    * @param {recv} _flags Modify default behaviour of recv.
+    * @param {bool *} _errorNB To signal error in case of non-blocking recv.
+    * @returns {ssize_t} Number of bytes received, -1 on non-blocking error.
+    */
+    template <typename Addr, typename F>
+    ssize_t low_recvfrom(char *_buf, const std::size_t _len, F &_fn,
+                         Recv _flags, bool *_errorNB) const
     {
-        const auto bufSize = _str.capacity();
-        const auto buffer  = std::make_unique<char[]>(bufSize);
+        Addr addr;
+
+        const auto flags = static_cast<int>(_flags);
+        socklen_t length = sizeof(addr);
+
+        const auto recvd = low_read(::recvfrom, _buf, _len, flags,
+                                    (sockaddr *) &addr, &length);
+
+        const auto currErrno = errno;
+        if (recvd == -1) {
+            if (currErrno == EAGAIN || currErrno == EWOULDBLOCK) {
+                if (_errorNB != nullptr) {
+                    *_errorNB = true;
+                } else {
+                    throw std::invalid_argument("errorNB argument missing");
+                }
+            } else {
+                throw std::runtime_error(net::methods::getErrorMsg(currErrno));
+            }
+        } else {
+            _fn(addr);
+        }
 
-        const auto recvd = std::forward<Fn>(_fn)(sockfd, buffer.get(), bufSize,
-                                                 std::forward<Args>(args)...);
-        _str.append(buffer.get(), (recvd > 0) ? recvd : 0);
         return recvd;
     }
 
 
+    /**
+    * @method low_sendto
+    * @access private
+    * @desc Sends _msg using sendto to the Addr object filled by _fn if
+    * successful else throws runtime_error exception.
+    * Throws invalid_argument exception in case of non-blocking net::Socket if
+    * _errorNB is missing.
+    * Throws invalid_argument exception if destination address given is invalid.
+    *
+    * @param {char *} _msg Msg to send.
+    * @param {size_t} _len Number of bytes of _msg to send.
+    * @param {callable} _fn Some callable that takes arg of type Addr.
+    * @param {send} _flags Modify default behaviour of send.
+    * @param {bool *} _errorNB To signal error in case of non-blocking send.
+    */
+    template <typename Addr, typename F>
+    void low_sendto(const char *_msg, const std::size_t _len, F &_fn,
+                    Send _flags, bool *_errorNB) const
+    {
+        Addr addr;
+
+        const auto flags = static_cast<int>(_flags);
+        const auto res   = _fn(addr);
+
+        if (res == 0) {
+            throw std::invalid_argument("Address argument invalid");
+        }
+
+        ssize_t sent = -1;
+        if (res >= 1) {
+            sent = low_write(::sendto, _msg, _len, flags, (sockaddr *) &addr,
+                             sizeof(addr));
+        }
+
+        const auto currErrno = errno;
+        if (res == -1 || sent == -1) {
+            if (currErrno == EAGAIN || currErrno == EWOULDBLOCK) {
+                if (_errorNB != nullptr) {
+                    *_errorNB = true;
+                } else {
+                    throw std::invalid_argument("errorNB argument missing");
+                }
+            } else {
+                throw std::runtime_error(net::methods::getErrorMsg(currErrno));
+            }
+        }
+    }
+
+
     /**
     * @construct Socket
     * @access private
@@ -98,6 +295,29 @@ private:
     Socket(const Socket &) = delete;
     Socket &operator=(const Socket &) = delete;
 
+    void take(Socket &s) noexcept
+    {
+        sockfd      = s.sockfd;
+        sock_domain = s.sock_domain;
+        sock_type   = s.sock_type;
+        isClosed    = s.isClosed;
+
+        // The moved-from Socket must neither close nor unlink anything.
+        s.sockfd   = -1;
+        s.isClosed = true;
+#ifdef NET_SOCKET_STATS
+        stats = s.stats;
+#endif
+
+        switch (s.sock_domain) {
+            case Domain::IPv4: ipv4 = s.ipv4; break;
+            case Domain::IPv6: ipv6 = s.ipv6; break;
+            case Domain::UNIX: unix = s.unix; break;
+
+            default: store = s.store;
+        }
+    }
+
 
 public:
     /**
@@ -134,21 +354,27 @@ public:
     * @access public
     * @param {Socket} s Rvalue of type socket.
     */
-    Socket(Socket &&s)
-    {
-        sockfd      = s.sockfd;
-        sock_domain = s.sock_domain;
-        sock_type   = s.sock_type;
+    Socket(Socket &&s) noexcept { take(s); }
 
-        s.sockfd = -1;
-
-        switch (s.sock_domain) {
-            case Domain::IPv4: ipv4 = s.ipv4; break;
-            case Domain::IPv6: ipv6 = s.ipv6; break;
-            case Domain::UNIX: unix = s.unix; break;
 
-            default: store = s.store;
+    /**
+    * @method operator=
+    * @access public
+    * @desc Closes the socket held, unlinking its unix path, then takes over
+    * the one of s, which is left closed.
+    *
+    * @param {Socket} s Rvalue of type socket.
+    * @returns {Socket &}
+    */
+    Socket &operator=(Socket &&s) noexcept
+    {
+        if (this != &s) {
+            unlink();
+            close();
+            take(s);
         }
+
+        return *this;
     }
 
 
@@ -292,6 +518,22 @@ public:
     void connect(const char[], const int = 0, bool * = nullptr);
 
 
+    /**
+    * @method tryConnect
+    * @access public
+    * @desc Connects net::Socket to given peer like connect, but reports
+    * failures through the result instead of throwing. An invalid address is
+    * reported as EINVAL, and a non-blocking connect that was started as
+    * EINPROGRESS.
+    *
+    * @param {char []} _addr Ip address in case of ipv4 or ipv6 domain, and Path
+    * in case of unix domain.
+    * @param {int} _port Port number in case of ipv4 or ipv6.
+    * @returns {IoResult} Empty result if connected, else the failure.
+    */
+    IoResult tryConnect(const char[], const int = 0) const noexcept;
+
+
     /**
     * @method connect
     * @access public
@@ -312,7 +554,9 @@ public:
 
         auto res = _fn(addr);
         if (res >= 1) {
+            StatsProbe probe(StatOp::CONNECT, attachedStats());
             res = ::connect(sockfd, (sockaddr *) &addr, sizeof(addr));
+            probe.done(res);
             res = (res == 0) ? 1 : res;
         }
 
@@ -354,7 +598,9 @@ public:
 
         auto res = _fn(addr);
         if (res >= 1) {
+            StatsProbe probe(StatOp::CONNECT, attachedStats());
             res = ::connect(sockfd, (sockaddr *) &addr, sizeof(addr));
+            probe.done(res);
             res = (res == 0) ? 1 : res;
         }
 
@@ -396,7 +642,9 @@ public:
 
         auto res = _fn(addr);
         if (res >= 1) {
+            StatsProbe probe(StatOp::CONNECT, attachedStats());
             res = ::connect(sockfd, (sockaddr *) &addr, sizeof(addr));
+            probe.done(res);
             res = (res == 0) ? 1 : res;
         }
 
@@ -447,6 +695,71 @@ public:
     Socket accept(bool * = nullptr) const;
 
 
+    /**
+    * @method tryAccept
+    * @access public
+    * @desc Returns Socket object from connected sockets queue like accept,
+    * but reports failures through _res instead of throwing. If _res is not
+    * ok the returned Socket is already closed and must be discarded.
+    *
+    * @param {IoResult} _res Set to the outcome of the accept.
+    * @returns {net::Socket}
+    */
+    Socket tryAccept(IoResult &) const noexcept;
+
+
+    /**
+    * @method acceptMany
+    * @access public
+    * @desc Accepts connections from connected sockets queue until it is empty
+    * or _max were accepted, appending them to _peers, if successful else
+    * throws runtime_error exception. Accepted Sockets are already
+    * non-blocking and close-on-exec, saving the fcntl calls per connection.
+    * Meant for a non-blocking Socket, since a blocking one waits once the
+    * queue is empty. Connections accepted before an error stay in _peers.
+    *
+    * @param {Container} _peers Container of Socket with push_back.
+    * @param {bool} _peerAddr false to skip capturing the peer addresses.
+    * @param {size_t} _max Maximum number of connections to accept.
+    * @returns {size_t} Number of connections accepted.
+    */
+    template <typename Container>
+    std::size_t acceptMany(Container &_peers, const bool _peerAddr = true,
+                           const std::size_t _max = -1) const
+    {
+        std::size_t count = 0;
+        AddrStore addr;
+
+        while (count < _max) {
+            socklen_t len  = sizeof(addr);
+            const auto ptr = reinterpret_cast<sockaddr *>(&addr);
+
+            StatsProbe probe(StatOp::ACCEPT, attachedStats());
+            const auto fd = ::accept4(sockfd, _peerAddr ? ptr : nullptr,
+                                      _peerAddr ? &len : nullptr,
+                                      SOCK_NONBLOCK | SOCK_CLOEXEC);
+            probe.done(fd);
+
+            if (fd == -1) {
+                const auto currErrno = errno;
+                if (currErrno == EAGAIN || currErrno == EWOULDBLOCK) {
+                    break;
+                }
+                if (currErrno == EINTR || currErrno == ECONNABORTED) {
+                    continue;
+                }
+                throw std::runtime_error(net::methods::getErrorMsg(currErrno));
+            }
+
+            _peers.push_back(
+              Socket(fd, sock_domain, sock_type, _peerAddr ? &addr : nullptr));
+            ++count;
+        }
+
+        return count;
+    }
+
+
     /**
     * @method write
     * @access public
@@ -455,10 +768,25 @@ public:
     * Throws invalid_argument exception in case of non-blocking net::Socket if
     * _errorNB is missing.
     *
-    * @param {string} _msg String to be written to Socket.
+    * @param {StringView} _msg String to be written to Socket.
     * @param {bool *} _errorNB To signal error in case of non-blocking write.
     */
-    void write(const std::string &, bool * = nullptr) const;
+    void write(StringView, bool * = nullptr) const;
+
+
+    /**
+    * @method write
+    * @access public
+    * @desc Writes _len bytes of given buffer to Socket without copying it if
+    * successful else throws runtime_error exception.
+    * Throws invalid_argument exception in case of non-blocking net::Socket if
+    * _errorNB is missing.
+    *
+    * @param {char *} _msg Buffer to be written to Socket.
+    * @param {size_t} _len Number of bytes of _msg to write.
+    * @param {bool *} _errorNB To signal error in case of non-blocking write.
+    */
+    void write(const char *, const std::size_t, bool * = nullptr) const;
 
 
     /**
@@ -476,6 +804,59 @@ public:
     std::string read(const int, bool * = nullptr) const;
 
 
+    /**
+    * @method read
+    * @access public
+    * @desc Reads at most _len bytes using Socket into caller owned buffer if
+    * successful else throws runtime_error exception. Never allocates.
+    * Throws invalid_argument exception in case of non-blocking net::Socket if
+    * _errorNB is missing.
+    *
+    * @param {char *} _buf Buffer to store the data.
+    * @param {size_t} _len Capacity of _buf in bytes.
+    * @param {bool *} _errorNB To signal error in case of non-blocking read.
+    * @returns {ssize_t} Number of bytes read, -1 on non-blocking error.
+    */
+    ssize_t read(char *, const std::size_t, bool * = nullptr) const;
+
+
+    /**
+    * @method read
+    * @access public
+    * @desc Reads at most _len bytes using Socket into a buffer borrowed from
+    * _pool, sized to the bytes read, if successful else throws runtime_error
+    * exception. Allocates nothing once the pool is warm.
+    * Throws invalid_argument exception in case of non-blocking net::Socket if
+    * _errorNB is missing.
+    *
+    * @param {BufferPool} _pool Pool to borrow the buffer from.
+    * @param {size_t} _len Maximum number of bytes to read.
+    * @param {bool *} _errorNB To signal error in case of non-blocking read.
+    * @returns {net::BufferPool::Buffer} Buffer of the bytes read, empty on
+    * non-blocking error.
+    */
+    BufferPool::Buffer read(BufferPool &, const std::size_t,
+                            bool * = nullptr) const;
+
+
+    /**
+    * @method read
+    * @access public
+    * @desc Reads at most _numBytes bytes using Socket into given string,
+    * replacing its contents, if successful else throws runtime_error
+    * exception. Reuses the capacity of _str so repeated reads into the same
+    * string do not allocate.
+    * Throws invalid_argument exception in case of non-blocking net::Socket if
+    * _errorNB is missing.
+    *
+    * @param {string} _str String to store the data.
+    * @param {int} _numBytes Maximum number of bytes to be read using Socket.
+    * @param {bool *} _errorNB To signal error in case of non-blocking read.
+    * @returns {ssize_t} Number of bytes read, -1 on non-blocking error.
+    */
+    ssize_t read(std::string &, const int, bool * = nullptr) const;
+
+
     /**
     * @method send
     * @access public
@@ -484,61 +865,59 @@ public:
     * Throws invalid_argument exception in case of non-blocking net::Socket if
     * _errorNB is missing.
     *
-    * @param {string} _msg String to be sent using Socket.
+    * @param {StringView} _msg String to be sent using Socket.
     * @param {send} _flags Modify default behaviour of send.
     * @param {bool *} _errorNB To signal error in case of non-blocking send.
     */
-    void send(const std::string &, Send = Send::NONE, bool * = nullptr) const;
+    void send(StringView, Send = Send::NONE, bool * = nullptr) const;
 
 
     /**
     * @method send
     * @access public
-    * @desc Sends given string using Socket if successful else throws
-    * runtime_error exception.
+    * @desc Sends _len bytes of given buffer using Socket without copying it if
+    * successful else throws runtime_error exception.
     * Throws invalid_argument exception in case of non-blocking net::Socket if
     * _errorNB is missing.
-    * Throws invalid_argument exception if destination address given is invalid.
-    * Invokes the callable provided to fill AddrIPv4 object.
     *
-    * @param {string} _msg String to be sent using Socket.
-    * @param {callable} _fn Some callable that takes arg of type AddrIPv4 or
-    * void.
+    * @param {char *} _msg Buffer to be sent using Socket.
+    * @param {size_t} _len Number of bytes of _msg to send.
     * @param {send} _flags Modify default behaviour of send.
     * @param {bool *} _errorNB To signal error in case of non-blocking send.
     */
-    template <typename F>
-    auto send(const std::string &_msg, F _fn, Send _flags = Send::NONE,
-              bool *_errorNB = nullptr) const
-      -> decltype(_fn(std::declval<AddrIPv4 &>()), void()) const
-    {
-        AddrIPv4 addr;
+    void send(const char *, const std::size_t, Send = Send::NONE,
+              bool * = nullptr) const;
 
-        const auto flags = static_cast<int>(_flags);
-        const auto res   = _fn(addr);
 
-        if (res == 0) {
-            throw std::invalid_argument("Address argument invalid");
-        }
+    /**
+    * @method trySend
+    * @access public
+    * @desc Sends given buffer using Socket with a single call, reporting
+    * failures through the result instead of throwing. Unlike send, fewer than
+    * _len bytes may be sent, and the caller continues from bytes().
+    *
+    * @param {char *} _msg Buffer to be sent using Socket.
+    * @param {size_t} _len Number of bytes of _msg to send.
+    * @param {send} _flags Modify default behaviour of send.
+    * @returns {IoResult} Number of bytes sent, or the failure.
+    */
+    IoResult trySend(const char *, const std::size_t,
+                     Send = Send::NONE) const noexcept;
 
-        ssize_t sent = -1;
-        if (res >= 1) {
-            sent = low_write(::sendto, _msg, flags, (sockaddr *) &addr,
-                             sizeof(addr));
-        }
 
-        const auto currErrno = errno;
-        if (res == -1 || sent == -1) {
-            if (currErrno == EAGAIN || currErrno == EWOULDBLOCK) {
-                if (_errorNB != nullptr) {
-                    *_errorNB = true;
-                } else {
-                    throw std::invalid_argument("errorNB argument missing");
-                }
-            } else {
-                throw std::runtime_error(net::methods::getErrorMsg(currErrno));
-            }
-        }
+    /**
+    * @method trySend
+    * @access public
+    * @desc Sends given string using Socket with a single call, reporting
+    * failures through the result instead of throwing.
+    *
+    * @param {StringView} _msg String to be sent using Socket.
+    * @param {send} _flags Modify default behaviour of send.
+    * @returns {IoResult} Number of bytes sent, or the failure.
+    */
+    IoResult trySend(StringView _msg, Send _flags = Send::NONE) const noexcept
+    {
+        return trySend(_msg.data(), _msg.size(), _flags);
     }
 
 
@@ -550,46 +929,95 @@ public:
     * Throws invalid_argument exception in case of non-blocking net::Socket if
     * _errorNB is missing.
     * Throws invalid_argument exception if destination address given is invalid.
-    * Invokes the callable provided to fill AddrIPv6 object.
+    * Invokes the callable provided to fill AddrIPv4 object.
     *
-    * @param {string} _msg String to be sent using Socket.
-    * @param {callable} _fn Some callable that takes arg of type AddrIPv6 or
+    * @param {StringView} _msg String to be sent using Socket.
+    * @param {callable} _fn Some callable that takes arg of type AddrIPv4 or
     * void.
     * @param {send} _flags Modify default behaviour of send.
     * @param {bool *} _errorNB To signal error in case of non-blocking send.
     */
     template <typename F>
-    auto send(const std::string &_msg, F _fn, Send _flags = Send::NONE,
+    auto send(StringView _msg, F _fn, Send _flags = Send::NONE,
               bool *_errorNB = nullptr) const
-      -> decltype(_fn(std::declval<AddrIPv6 &>()), void()) const
+      -> decltype(_fn(std::declval<AddrIPv4 &>()), void()) const
     {
-        AddrIPv6 addr;
+        low_sendto<AddrIPv4>(_msg.data(), _msg.size(), _fn, _flags, _errorNB);
+    }
 
-        const auto flags = static_cast<int>(_flags);
-        const auto res   = _fn(addr);
 
-        if (res == 0) {
-            throw std::invalid_argument("Address argument invalid");
-        }
+    /**
+    * @method send
+    * @access public
+    * @desc Sends _len bytes of given buffer using Socket without copying it if
+    * successful else throws runtime_error exception.
+    * Throws invalid_argument exception in case of non-blocking net::Socket if
+    * _errorNB is missing.
+    * Throws invalid_argument exception if destination address given is invalid.
+    * Invokes the callable provided to fill AddrIPv4 object.
+    *
+    * @param {char *} _msg Buffer to be sent using Socket.
+    * @param {size_t} _len Number of bytes of _msg to send.
+    * @param {callable} _fn Some callable that takes arg of type AddrIPv4.
+    * @param {send} _flags Modify default behaviour of send.
+    * @param {bool *} _errorNB To signal error in case of non-blocking send.
+    */
+    template <typename F>
+    auto send(const char *_msg, const std::size_t _len, F _fn,
+              Send _flags = Send::NONE, bool *_errorNB = nullptr) const
+      -> decltype(_fn(std::declval<AddrIPv4 &>()), void())
+    {
+        low_sendto<AddrIPv4>(_msg, _len, _fn, _flags, _errorNB);
+    }
 
-        ssize_t sent = -1;
-        if (res >= 1) {
-            sent = low_write(::sendto, _msg, flags, (sockaddr *) &addr,
-                             sizeof(addr));
-        }
 
-        const auto currErrno = errno;
-        if (res == -1 || sent == -1) {
-            if (currErrno == EAGAIN || currErrno == EWOULDBLOCK) {
-                if (_errorNB != nullptr) {
-                    *_errorNB = true;
-                } else {
-                    throw std::invalid_argument("errorNB argument missing");
-                }
-            } else {
-                throw std::runtime_error(net::methods::getErrorMsg(currErrno));
-            }
-        }
+    /**
+    * @method send
+    * @access public
+    * @desc Sends given string using Socket if successful else throws
+    * runtime_error exception.
+    * Throws invalid_argument exception in case of non-blocking net::Socket if
+    * _errorNB is missing.
+    * Throws invalid_argument exception if destination address given is invalid.
+    * Invokes the callable provided to fill AddrIPv6 object.
+    *
+    * @param {StringView} _msg String to be sent using Socket.
+    * @param {callable} _fn Some callable that takes arg of type AddrIPv6 or
+    * void.
+    * @param {send} _flags Modify default behaviour of send.
+    * @param {bool *} _errorNB To signal error in case of non-blocking send.
+    */
+    template <typename F>
+    auto send(StringView _msg, F _fn, Send _flags = Send::NONE,
+              bool *_errorNB = nullptr) const
+      -> decltype(_fn(std::declval<AddrIPv6 &>()), void()) const
+    {
+        low_sendto<AddrIPv6>(_msg.data(), _msg.size(), _fn, _flags, _errorNB);
+    }
+
+
+    /**
+    * @method send
+    * @access public
+    * @desc Sends _len bytes of given buffer using Socket without copying it if
+    * successful else throws runtime_error exception.
+    * Throws invalid_argument exception in case of non-blocking net::Socket if
+    * _errorNB is missing.
+    * Throws invalid_argument exception if destination address given is invalid.
+    * Invokes the callable provided to fill AddrIPv6 object.
+    *
+    * @param {char *} _msg Buffer to be sent using Socket.
+    * @param {size_t} _len Number of bytes of _msg to send.
+    * @param {callable} _fn Some callable that takes arg of type AddrIPv6.
+    * @param {send} _flags Modify default behaviour of send.
+    * @param {bool *} _errorNB To signal error in case of non-blocking send.
+    */
+    template <typename F>
+    auto send(const char *_msg, const std::size_t _len, F _fn,
+              Send _flags = Send::NONE, bool *_errorNB = nullptr) const
+      -> decltype(_fn(std::declval<AddrIPv6 &>()), void())
+    {
+        low_sendto<AddrIPv6>(_msg, _len, _fn, _flags, _errorNB);
     }
 
 
@@ -603,44 +1031,43 @@ public:
     * Throws invalid_argument exception if destination address given is invalid.
     * Invokes the callable provided to fill AddrUnix object.
     *
-    * @param {string} _msg String to be sent using Socket.
+    * @param {StringView} _msg String to be sent using Socket.
     * @param {callable} _fn Some callable that takes arg of type AddrUnix or
     * void.
     * @param {send} _flags Modify default behaviour of send.
     * @param {bool *} _errorNB To signal error in case of non-blocking send.
     */
     template <typename F>
-    auto send(const std::string &_msg, F _fn, Send _flags = Send::NONE,
+    auto send(StringView _msg, F _fn, Send _flags = Send::NONE,
               bool *_errorNB = nullptr) const
       -> decltype(_fn(std::declval<AddrUnix &>()), void()) const
     {
-        AddrUnix addr;
-
-        const auto flags = static_cast<int>(_flags);
-        const auto res   = _fn(addr);
-
-        if (res == 0) {
-            throw std::invalid_argument("Address argument invalid");
-        }
+        low_sendto<AddrUnix>(_msg.data(), _msg.size(), _fn, _flags, _errorNB);
+    }
 
-        ssize_t sent = -1;
-        if (res >= 1) {
-            sent = low_write(::sendto, _msg, flags, (sockaddr *) &addr,
-                             sizeof(addr));
-        }
 
-        const auto currErrno = errno;
-        if (res == -1 || sent == -1) {
-            if (currErrno == EAGAIN || currErrno == EWOULDBLOCK) {
-                if (_errorNB != nullptr) {
-                    *_errorNB = true;
-                } else {
-                    throw std::invalid_argument("errorNB argument missing");
-                }
-            } else {
-                throw std::runtime_error(net::methods::getErrorMsg(currErrno));
-            }
-        }
+    /**
+    * @method send
+    * @access public
+    * @desc Sends _len bytes of given buffer using Socket without copying it if
+    * successful else throws runtime_error exception.
+    * Throws invalid_argument exception in case of non-blocking net::Socket if
+    * _errorNB is missing.
+    * Throws invalid_argument exception if destination address given is invalid.
+    * Invokes the callable provided to fill AddrUnix object.
+    *
+    * @param {char *} _msg Buffer to be sent using Socket.
+    * @param {size_t} _len Number of bytes of _msg to send.
+    * @param {callable} _fn Some callable that takes arg of type AddrUnix.
+    * @param {send} _flags Modify default behaviour of send.
+    * @param {bool *} _errorNB To signal error in case of non-blocking send.
+    */
+    template <typename F>
+    auto send(const char *_msg, const std::size_t _len, F _fn,
+              Send _flags = Send::NONE, bool *_errorNB = nullptr) const
+      -> decltype(_fn(std::declval<AddrUnix &>()), void())
+    {
+        low_sendto<AddrUnix>(_msg, _len, _fn, _flags, _errorNB);
     }
 
 
@@ -660,6 +1087,80 @@ public:
     std::string recv(const int, Recv = Recv::NONE, bool * = nullptr) const;
 
 
+    /**
+    * @method recv
+    * @access public
+    * @desc Reads at most _len bytes using Socket into caller owned buffer if
+    * successful else throws runtime_error exception. Never allocates.
+    * Throws invalid_argument exception in case of non-blocking net::Socket if
+    * _errorNB is missing.
+    *
+    * @param {char *} _buf Buffer to store the data.
+    * @param {size_t} _len Capacity of _buf in bytes.
+    * @param {recv} _flags Modify default behaviour of recv.
+    * @param {bool *} _errorNB To signal error in case of non-blocking recv.
+    * @returns {ssize_t} Number of bytes read, -1 on non-blocking error.
+    */
+    ssize_t recv(char *, const std::size_t, Recv = Recv::NONE,
+                 bool * = nullptr) const;
+
+
+    /**
+    * @method recv
+    * @access public
+    * @desc Reads at most _len bytes using Socket into a buffer borrowed from
+    * _pool, sized to the bytes read, if successful else throws runtime_error
+    * exception. Allocates nothing once the pool is warm.
+    * Throws invalid_argument exception in case of non-blocking net::Socket if
+    * _errorNB is missing.
+    *
+    * @param {BufferPool} _pool Pool to borrow the buffer from.
+    * @param {size_t} _len Maximum number of bytes to read.
+    * @param {recv} _flags Modify default behaviour of recv.
+    * @param {bool *} _errorNB To signal error in case of non-blocking recv.
+    * @returns {net::BufferPool::Buffer} Buffer of the bytes read, empty on
+    * non-blocking error.
+    */
+    BufferPool::Buffer recv(BufferPool &, const std::size_t, Recv = Recv::NONE,
+                            bool * = nullptr) const;
+
+
+    /**
+    * @method tryRecv
+    * @access public
+    * @desc Reads at most _len bytes using Socket into caller owned buffer,
+    * reporting failures through the result instead of throwing. Never
+    * allocates.
+    *
+    * @param {char *} _buf Buffer to store the data.
+    * @param {size_t} _len Capacity of _buf in bytes.
+    * @param {recv} _flags Modify default behaviour of recv.
+    * @returns {IoResult} Number of bytes read, or the failure.
+    */
+    IoResult tryRecv(char *, const std::size_t,
+                     Recv = Recv::NONE) const noexcept;
+
+
+    /**
+    * @method recv
+    * @access public
+    * @desc Reads at most _numBytes bytes using Socket into given string,
+    * replacing its contents, if successful else throws runtime_error
+    * exception. Reuses the capacity of _str so repeated reads into the same
+    * string do not allocate.
+    * Throws invalid_argument exception in case of non-blocking net::Socket if
+    * _errorNB is missing.
+    *
+    * @param {string} _str String to store the data.
+    * @param {int} _numBytes Maximum number of bytes to be read using Socket.
+    * @param {recv} _flags Modify default behaviour of recv.
+    * @param {bool *} _errorNB To signal error in case of non-blocking recv.
+    * @returns {ssize_t} Number of bytes read, -1 on non-blocking error.
+    */
+    ssize_t recv(std::string &, const int, Recv = Recv::NONE,
+                 bool * = nullptr) const;
+
+
     /**
     * @method recv
     * @access public
@@ -682,30 +1183,14 @@ public:
               bool *_errorNB = nullptr) const
       -> decltype(_fn(std::declval<AddrIPv4 &>()), std::string()) const
     {
-        AddrIPv4 addr;
         std::string str;
         str.reserve(_numBytes);
-
-        const auto flags = static_cast<int>(_flags);
-        socklen_t length = sizeof(addr);
+        str.resize(str.capacity());
 
         const auto recvd
-          = low_read(::recvfrom, str, flags, (sockaddr *) &addr, &length);
+          = low_recvfrom<AddrIPv4>(&str[0], str.size(), _fn, _flags, _errorNB);
 
-        const auto currErrno = errno;
-        if (recvd == -1) {
-            if (currErrno == EAGAIN || currErrno == EWOULDBLOCK) {
-                if (_errorNB != nullptr) {
-                    *_errorNB = true;
-                } else {
-                    throw std::invalid_argument("errorNB argument missing");
-                }
-            } else {
-                throw std::runtime_error(net::methods::getErrorMsg(currErrno));
-            }
-        }
-
-        _fn(addr);
+        str.resize((recvd > 0) ? recvd : 0);
         return str;
     }
 
@@ -732,30 +1217,14 @@ public:
               bool *_errorNB = nullptr) const
       -> decltype(_fn(std::declval<AddrIPv6 &>()), std::string()) const
     {
-        AddrIPv6 addr;
         std::string str;
         str.reserve(_numBytes);
-
-        const auto flags = static_cast<int>(_flags);
-        socklen_t length = sizeof(addr);
+        str.resize(str.capacity());
 
         const auto recvd
-          = low_read(::recvfrom, str, flags, (sockaddr *) &addr, &length);
+          = low_recvfrom<AddrIPv6>(&str[0], str.size(), _fn, _flags, _errorNB);
 
-        const auto currErrno = errno;
-        if (recvd == -1) {
-            if (currErrno == EAGAIN || currErrno == EWOULDBLOCK) {
-                if (_errorNB != nullptr) {
-                    *_errorNB = true;
-                } else {
-                    throw std::invalid_argument("errorNB argument missing");
-                }
-            } else {
-                throw std::runtime_error(net::methods::getErrorMsg(currErrno));
-            }
-        }
-
-        _fn(addr);
+        str.resize((recvd > 0) ? recvd : 0);
         return str;
     }
 
@@ -782,15 +1251,313 @@ public:
               bool *_errorNB = nullptr) const
       -> decltype(_fn(std::declval<AddrUnix &>()), std::string()) const
     {
-        AddrUnix addr;
         std::string str;
         str.reserve(_numBytes);
-
-        const auto flags = static_cast<int>(_flags);
-        socklen_t length = sizeof(addr);
+        str.resize(str.capacity());
 
         const auto recvd
-          = low_read(::recvfrom, str, flags, (sockaddr *) &addr, &length);
+          = low_recvfrom<AddrUnix>(&str[0], str.size(), _fn, _flags, _errorNB);
+
+        str.resize((recvd > 0) ? recvd : 0);
+        return str;
+    }
+
+
+    /**
+    * @method recv
+    * @access public
+    * @desc Reads at most _len bytes using Socket into caller owned buffer if
+    * successful else throws runtime_error exception. Never allocates.
+    * Throws invalid_argument exception in case of non-blocking net::Socket if
+    * _errorNB is missing.
+    * Invokes the callable provided to return AddrIPv4 object from where msg has
+    * been received.
+    *
+    * @param {char *} _buf Buffer to store the data.
+    * @param {size_t} _len Capacity of _buf in bytes.
+    * @param {callable} _fn Some callable that takes arg of type AddrIPv4.
+    * @param {recv} _flags Modify default behaviour of recv.
+    * @param {bool *} _errorNB To signal error in case of non-blocking recv.
+    * @returns {ssize_t} Number of bytes read, -1 on non-blocking error.
+    */
+    template <typename F>
+    auto recv(char *_buf, const std::size_t _len, F _fn,
+              Recv _flags = Recv::NONE, bool *_errorNB = nullptr) const
+      -> decltype(_fn(std::declval<AddrIPv4 &>()), ssize_t())
+    {
+        return low_recvfrom<AddrIPv4>(_buf, _len, _fn, _flags, _errorNB);
+    }
+
+
+    /**
+    * @method recv
+    * @access public
+    * @desc Reads at most _len bytes using Socket into caller owned buffer if
+    * successful else throws runtime_error exception. Never allocates.
+    * Throws invalid_argument exception in case of non-blocking net::Socket if
+    * _errorNB is missing.
+    * Invokes the callable provided to return AddrIPv6 object from where msg has
+    * been received.
+    *
+    * @param {char *} _buf Buffer to store the data.
+    * @param {size_t} _len Capacity of _buf in bytes.
+    * @param {callable} _fn Some callable that takes arg of type AddrIPv6.
+    * @param {recv} _flags Modify default behaviour of recv.
+    * @param {bool *} _errorNB To signal error in case of non-blocking recv.
+    * @returns {ssize_t} Number of bytes read, -1 on non-blocking error.
+    */
+    template <typename F>
+    auto recv(char *_buf, const std::size_t _len, F _fn,
+              Recv _flags = Recv::NONE, bool *_errorNB = nullptr) const
+      -> decltype(_fn(std::declval<AddrIPv6 &>()), ssize_t())
+    {
+        return low_recvfrom<AddrIPv6>(_buf, _len, _fn, _flags, _errorNB);
+    }
+
+
+    /**
+    * @method recv
+    * @access public
+    * @desc Reads at most _len bytes using Socket into caller owned buffer if
+    * successful else throws runtime_error exception. Never allocates.
+    * Throws invalid_argument exception in case of non-blocking net::Socket if
+    * _errorNB is missing.
+    * Invokes the callable provided to return AddrUnix object from where msg has
+    * been received.
+    *
+    * @param {char *} _buf Buffer to store the data.
+    * @param {size_t} _len Capacity of _buf in bytes.
+    * @param {callable} _fn Some callable that takes arg of type AddrUnix.
+    * @param {recv} _flags Modify default behaviour of recv.
+    * @param {bool *} _errorNB To signal error in case of non-blocking recv.
+    * @returns {ssize_t} Number of bytes read, -1 on non-blocking error.
+    */
+    template <typename F>
+    auto recv(char *_buf, const std::size_t _len, F _fn,
+              Recv _flags = Recv::NONE, bool *_errorNB = nullptr) const
+      -> decltype(_fn(std::declval<AddrUnix &>()), ssize_t())
+    {
+        return low_recvfrom<AddrUnix>(_buf, _len, _fn, _flags, _errorNB);
+    }
+
+
+    /**
+    * @method recv
+    * @access public
+    * @desc Reads at most _numBytes bytes using Socket into given string,
+    * replacing its contents, if successful else throws runtime_error
+    * exception. Reuses the capacity of _str so repeated reads into the same
+    * string do not allocate.
+    * Throws invalid_argument exception in case of non-blocking net::Socket if
+    * _errorNB is missing.
+    * Invokes the callable provided to return AddrIPv4, AddrIPv6 or AddrUnix
+    * object from where msg has been received.
+    *
+    * @param {string} _str String to store the data.
+    * @param {int} _numBytes Maximum number of bytes to be read using Socket.
+    * @param {callable} _fn Some callable that takes arg of type AddrIPv4,
+    * AddrIPv6 or AddrUnix.
+    * @param {recv} _flags Modify default behaviour of recv.
+    * @param {bool *} _errorNB To signal error in case of non-blocking recv.
+    * @returns {ssize_t} Number of bytes read, -1 on non-blocking error.
+    */
+    template <typename F>
+    auto recv(std::string &_str, const int _numBytes, F _fn,
+              Recv _flags = Recv::NONE, bool *_errorNB = nullptr) const
+      -> decltype(this->recv(&_str[0], std::size_t(), _fn, _flags, _errorNB))
+    {
+        _str.resize(_numBytes);
+        const auto recvd = recv(&_str[0], _str.size(), _fn, _flags, _errorNB);
+        _str.resize((recvd > 0) ? recvd : 0);
+        return recvd;
+    }
+
+
+    /**
+    * @method writev
+    * @access public
+    * @desc Writes all given buffers to Socket, in order, gathering them in as
+    * few syscalls as possible if successful else throws runtime_error
+    * exception.
+    * Throws invalid_argument exception in case of non-blocking net::Socket if
+    * _errorNB is missing.
+    *
+    * @param {StringView *} _bufs Buffers to be written to Socket.
+    * @param {size_t} _count Number of buffers.
+    * @param {bool *} _errorNB To signal error in case of non-blocking write.
+    * @returns {size_t} Number of bytes written, less than the total size of
+    * _bufs on non-blocking error; resume from there.
+    */
+    std::size_t writev(const StringView *, const std::size_t,
+                       bool * = nullptr) const;
+
+
+    /**
+    * @method writev
+    * @access public
+    * @desc Writes all given buffers to Socket, in order, gathering them in as
+    * few syscalls as possible if successful else throws runtime_error
+    * exception.
+    * Throws invalid_argument exception in case of non-blocking net::Socket if
+    * _errorNB is missing.
+    *
+    * @param {initializer_list} _bufs Buffers to be written to Socket.
+    * @param {bool *} _errorNB To signal error in case of non-blocking write.
+    * @returns {size_t} Number of bytes written.
+    */
+    std::size_t writev(std::initializer_list<StringView> _bufs,
+                       bool *_errorNB = nullptr) const
+    {
+        return writev(_bufs.begin(), _bufs.size(), _errorNB);
+    }
+
+
+    /**
+    * @method sendmsg
+    * @access public
+    * @desc Sends all given buffers using Socket, in order, gathering them in
+    * as few syscalls as possible if successful else throws runtime_error
+    * exception.
+    * Throws invalid_argument exception in case of non-blocking net::Socket if
+    * _errorNB is missing.
+    *
+    * @param {StringView *} _bufs Buffers to be sent using Socket.
+    * @param {size_t} _count Number of buffers.
+    * @param {send} _flags Modify default behaviour of send.
+    * @param {bool *} _errorNB To signal error in case of non-blocking send.
+    * @returns {size_t} Number of bytes sent, less than the total size of
+    * _bufs on non-blocking error; resume from there.
+    */
+    std::size_t sendmsg(const StringView *, const std::size_t,
+                        Send = Send::NONE, bool * = nullptr) const;
+
+
+    /**
+    * @method sendmsg
+    * @access public
+    * @desc Sends all given buffers using Socket, in order, gathering them in
+    * as few syscalls as possible if successful else throws runtime_error
+    * exception.
+    * Throws invalid_argument exception in case of non-blocking net::Socket if
+    * _errorNB is missing.
+    *
+    * @param {initializer_list} _bufs Buffers to be sent using Socket.
+    * @param {send} _flags Modify default behaviour of send.
+    * @param {bool *} _errorNB To signal error in case of non-blocking send.
+    * @returns {size_t} Number of bytes sent.
+    */
+    std::size_t sendmsg(std::initializer_list<StringView> _bufs,
+                        Send _flags = Send::NONE,
+                        bool *_errorNB = nullptr) const
+    {
+        return sendmsg(_bufs.begin(), _bufs.size(), _flags, _errorNB);
+    }
+
+
+    /**
+    * @method readv
+    * @access public
+    * @desc Reads using Socket into given buffers, filling each one before
+    * moving to the next, in a single syscall if successful else throws
+    * runtime_error exception.
+    * Throws invalid_argument exception in case of non-blocking net::Socket if
+    * _errorNB is missing.
+    *
+    * @param {iovec *} _bufs Buffers to store the data.
+    * @param {size_t} _count Number of buffers.
+    * @param {bool *} _errorNB To signal error in case of non-blocking read.
+    * @returns {ssize_t} Number of bytes read, -1 on non-blocking error.
+    */
+    ssize_t readv(const iovec *, const std::size_t, bool * = nullptr) const;
+
+
+    /**
+    * @method readv
+    * @access public
+    * @desc Reads using Socket into given buffers, filling each one before
+    * moving to the next, in a single syscall if successful else throws
+    * runtime_error exception.
+    * Throws invalid_argument exception in case of non-blocking net::Socket if
+    * _errorNB is missing.
+    *
+    * @param {initializer_list} _bufs Buffers to store the data.
+    * @param {bool *} _errorNB To signal error in case of non-blocking read.
+    * @returns {ssize_t} Number of bytes read, -1 on non-blocking error.
+    */
+    ssize_t readv(std::initializer_list<iovec> _bufs,
+                  bool *_errorNB = nullptr) const
+    {
+        return readv(_bufs.begin(), _bufs.size(), _errorNB);
+    }
+
+
+    /**
+    * @method recvmsg
+    * @access public
+    * @desc Receives using Socket into given buffers, filling each one before
+    * moving to the next, in a single syscall if successful else throws
+    * runtime_error exception. Lets a header and a body land in separate
+    * buffers without an intermediate copy.
+    * Throws invalid_argument exception in case of non-blocking net::Socket if
+    * _errorNB is missing.
+    *
+    * @param {iovec *} _bufs Buffers to store the data.
+    * @param {size_t} _count Number of buffers.
+    * @param {recv} _flags Modify default behaviour of recv.
+    * @param {bool *} _errorNB To signal error in case of non-blocking recv.
+    * @returns {ssize_t} Number of bytes read, -1 on non-blocking error.
+    */
+    ssize_t recvmsg(const iovec *, const std::size_t, Recv = Recv::NONE,
+                    bool * = nullptr) const;
+
+
+    /**
+    * @method recvmsg
+    * @access public
+    * @desc Receives using Socket into given buffers, filling each one before
+    * moving to the next, in a single syscall if successful else throws
+    * runtime_error exception. Lets a header and a body land in separate
+    * buffers without an intermediate copy.
+    * Throws invalid_argument exception in case of non-blocking net::Socket if
+    * _errorNB is missing.
+    *
+    * @param {initializer_list} _bufs Buffers to store the data.
+    * @param {recv} _flags Modify default behaviour of recv.
+    * @param {bool *} _errorNB To signal error in case of non-blocking recv.
+    * @returns {ssize_t} Number of bytes read, -1 on non-blocking error.
+    */
+    ssize_t recvmsg(std::initializer_list<iovec> _bufs,
+                    Recv _flags = Recv::NONE, bool *_errorNB = nullptr) const
+    {
+        return recvmsg(_bufs.begin(), _bufs.size(), _flags, _errorNB);
+    }
+
+
+    /**
+    * @method recvmmsg
+    * @access public
+    * @desc Receives as many datagrams as are queued, up to the capacity of
+    * _batch, in a single syscall if successful else throws runtime_error
+    * exception. Blocks only until the first datagram arrives.
+    * Throws invalid_argument exception in case of non-blocking net::Socket if
+    * _errorNB is missing.
+    *
+    * @param {DatagramBatch} _batch Slots to store datagrams and their source
+    * addresses of type AddrIPv4, AddrIPv6 or AddrUnix.
+    * @param {recv} _flags Modify default behaviour of recv.
+    * @param {bool *} _errorNB To signal error in case of non-blocking recv.
+    * @returns {size_t} Number of datagrams received, same as _batch.size().
+    */
+    template <typename Addr>
+    std::size_t recvmmsg(DatagramBatch<Addr> &_batch, Recv _flags = Recv::NONE,
+                         bool *_errorNB = nullptr) const
+    {
+        const auto flags = static_cast<int>(_flags) | MSG_WAITFORONE;
+
+        StatsProbe probe(StatOp::READ, attachedStats());
+        const auto recvd = ::recvmmsg(sockfd, _batch.prepareRecv(),
+                                      _batch.capacity(), flags, nullptr);
+        probe.done(batchBytes(_batch.hdrs.get(), recvd));
 
         const auto currErrno = errno;
         if (recvd == -1) {
@@ -803,13 +1570,179 @@ public:
             } else {
                 throw std::runtime_error(net::methods::getErrorMsg(currErrno));
             }
+            return 0;
         }
 
-        _fn(addr);
-        return str;
+        _batch.used = recvd;
+        return _batch.used;
+    }
+
+
+    /**
+    * @method sendmmsg
+    * @access public
+    * @desc Sends all the datagrams pushed in _batch to their destination
+    * addresses using as few syscalls as possible if successful else throws
+    * runtime_error exception.
+    * Throws invalid_argument exception in case of non-blocking net::Socket if
+    * _errorNB is missing.
+    *
+    * @param {DatagramBatch} _batch Datagrams to send.
+    * @param {send} _flags Modify default behaviour of send.
+    * @param {bool *} _errorNB To signal error in case of non-blocking send.
+    * @returns {size_t} Number of datagrams sent from the start of _batch.
+    */
+    template <typename Addr>
+    std::size_t sendmmsg(DatagramBatch<Addr> &_batch, Send _flags = Send::NONE,
+                         bool *_errorNB = nullptr) const
+    {
+        const auto flags = static_cast<int>(_flags);
+        std::size_t sent = 0;
+
+        while (sent < _batch.size()) {
+            StatsProbe probe(StatOp::WRITE, attachedStats());
+            const auto res = ::sendmmsg(sockfd, _batch.hdrs.get() + sent,
+                                        _batch.size() - sent, flags);
+            probe.done(batchBytes(_batch.hdrs.get() + sent, res),
+                       res != -1 && sent + res < _batch.size());
+
+            const auto currErrno = errno;
+            if (res == -1) {
+                if (currErrno == EAGAIN || currErrno == EWOULDBLOCK) {
+                    if (_errorNB != nullptr) {
+                        *_errorNB = true;
+                        break;
+                    } else {
+                        throw std::invalid_argument("errorNB argument missing");
+                    }
+                } else {
+                    throw std::runtime_error(
+                      net::methods::getErrorMsg(currErrno));
+                }
+            }
+            sent += res;
+        }
+
+        return sent;
     }
 
 
+    /**
+    * @method sendFile
+    * @access public
+    * @desc Sends _count bytes of file _fd starting at _offset using Socket
+    * with sendfile, without copying them to user space, if successful else
+    * throws runtime_error exception. The file offset of _fd is not changed.
+    * On a non-blocking Socket it stops when the send buffer is full and
+    * returns the bytes sent so far; resume from _offset plus that number.
+    * Throws invalid_argument exception in case of non-blocking net::Socket if
+    * _errorNB is missing.
+    *
+    * @param {int} _fd Descriptor of the file to send.
+    * @param {off_t} _offset Offset in the file to start from.
+    * @param {size_t} _count Number of bytes to send.
+    * @param {bool *} _errorNB To signal error in case of non-blocking send.
+    * @returns {size_t} Number of bytes sent, less than _count at end of file
+    * or on non-blocking error.
+    */
+    std::size_t sendFile(const int, off_t, const std::size_t,
+                         bool * = nullptr) const;
+
+
+    /**
+    * @method splice
+    * @access public
+    * @desc Moves at most _count bytes received on Socket to descriptor _fdOut
+    * through _pipe, without copying them to user space, if successful else
+    * throws runtime_error exception. Bytes left in _pipe by an earlier call
+    * are delivered first and count towards _count. If _fdOut would block, the
+    * undelivered bytes stay in _pipe for the next call.
+    * Throws invalid_argument exception in case of non-blocking net::Socket or
+    * _fdOut if _errorNB is missing.
+    *
+    * @param {Pipe} _pipe Pipe dedicated to this transfer.
+    * @param {int} _fdOut Descriptor of a file, pipe or socket to move to.
+    * @param {size_t} _count Maximum number of bytes to deliver to _fdOut.
+    * @param {bool *} _errorNB To signal error in case of non-blocking splice.
+    * @returns {size_t} Number of bytes delivered to _fdOut, less than _count
+    * at end of stream or on non-blocking error.
+    */
+    std::size_t splice(Pipe &, const int, const std::size_t,
+                       bool * = nullptr) const;
+
+
+    /**
+    * @method splice
+    * @access public
+    * @desc Moves at most _count bytes received on Socket to Socket _to
+    * through _pipe, without copying them to user space, if successful else
+    * throws runtime_error exception. Same semantics as splice to a descriptor.
+    *
+    * @param {Pipe} _pipe Pipe dedicated to this transfer.
+    * @param {Socket} _to Socket to move the bytes to.
+    * @param {size_t} _count Maximum number of bytes to deliver to _to.
+    * @param {bool *} _errorNB To signal error in case of non-blocking splice.
+    * @returns {size_t} Number of bytes delivered to _to.
+    */
+    std::size_t splice(Pipe &_pipe, const Socket &_to, const std::size_t _count,
+                       bool *_errorNB = nullptr) const
+    {
+        return splice(_pipe, _to.sockfd, _count, _errorNB);
+    }
+
+
+    /**
+    * @method sendZeroCopy
+    * @access public
+    * @desc Sends _msg on Socket with MSG_ZEROCOPY, so the kernel sends from
+    * the pages of _msg instead of copying them, if successful else throws
+    * runtime_error exception. _msg must not be modified until _zc reports the
+    * returned number complete. Messages smaller than the threshold of _zc are
+    * sent by copy. Requires Opt::ZEROCOPY enabled.
+    * Throws invalid_argument exception in case of non-blocking net::Socket if
+    * _errorNB is missing. ENOBUFS, signalling too many pending zero-copy
+    * sends, is reported the same way. Either may come after part of _msg is
+    * queued: call pollZeroCopy and resume from _msg plus *_sent.
+    *
+    * @param {ZeroCopy} _zc Tracker of the zero-copy sends of Socket.
+    * @param {StringView} _msg Message to send.
+    * @param {Send} _flags Bitwise OR of flags for send.
+    * @param {bool *} _errorNB To signal error in case of non-blocking send.
+    * @param {size_t *} _sent Set to the number of bytes queued, if given.
+    * @returns {uint32_t} Number to pass to ZeroCopy::isComplete. If no byte
+    * was sent by zero-copy, as for messages below the threshold, it names a
+    * send complete already, so isComplete is true for it at once.
+    */
+    std::uint32_t sendZeroCopy(ZeroCopy &, StringView, Send = Send::NONE,
+                               bool * = nullptr,
+                               std::size_t * = nullptr) const;
+
+
+    /**
+    * @method pollZeroCopy
+    * @access public
+    * @desc Reads the zero-copy completions queued on the error queue of
+    * Socket into _zc, without blocking, if successful else throws
+    * runtime_error exception.
+    *
+    * @param {ZeroCopy} _zc Tracker of the zero-copy sends of Socket.
+    * @returns {uint32_t} Number of sends completed by this call.
+    */
+    std::uint32_t pollZeroCopy(ZeroCopy &) const;
+
+
+    /**
+    * @method setNonBlocking
+    * @access public
+    * @desc Switches Socket to non-blocking mode, or back to blocking mode, if
+    * successful else throws runtime_error exception. Calls on a non-blocking
+    * Socket that would block signal it through _errorNB instead of waiting.
+    *
+    * @param {bool} _nonBlocking true for non-blocking mode.
+    */
+    void setNonBlocking(const bool = true) const;
+
+
     /**
     * @method setOpt
     * @access public
@@ -847,6 +1780,26 @@ public:
     }
 
 
+    /**
+    * @method attachStats
+    * @access public
+    * @desc Records the system calls of this Socket into _stats as well as
+    * into the stats of the calling thread. Only the thread using the Socket
+    * may write to _stats, which must outlive it. Does nothing unless built
+    * with NET_SOCKET_STATS defined.
+    *
+    * @param {SocketStats *} _stats Stats to record into, nullptr to detach.
+    */
+    void attachStats(SocketStats *_stats) noexcept
+    {
+#ifdef NET_SOCKET_STATS
+        stats = _stats;
+#else
+        static_cast<void>(_stats);
+#endif
+    }
+
+
     /**
     * @method unlink
     * @access public
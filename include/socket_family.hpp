@@ -3,6 +3,7 @@
 
 #include <mutex>
 #include <cstring>
+#include <string>
 #include <utility>
 #include "socket_options.hpp"
 
@@ -10,6 +11,7 @@ extern "C" {
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <sys/un.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <unistd.h>
@@ -54,10 +56,12 @@ enum class Shut { READ = SHUT_RD, WRITE = SHUT_WR, READWRITE = SHUT_RDWR };
 
 
 enum class Recv {
-    NONE    = 0,
-    PEEK    = MSG_PEEK,
-    OOB     = MSG_OOB,
-    WAITALL = MSG_WAITALL
+    NONE     = 0,
+    PEEK     = MSG_PEEK,
+    OOB      = MSG_OOB,
+    WAITALL  = MSG_WAITALL,
+    DONTWAIT = MSG_DONTWAIT,
+    TRUNC    = MSG_TRUNC
 };
 inline constexpr Recv operator|(Recv a, Recv b) noexcept
 {
@@ -68,7 +72,11 @@ enum class Send {
     NONE     = 0,
     EOR      = MSG_EOR,
     OOB      = MSG_OOB,
-    NOSIGNAL = MSG_NOSIGNAL
+    NOSIGNAL = MSG_NOSIGNAL,
+#ifdef MSG_ZEROCOPY
+    ZEROCOPY = MSG_ZEROCOPY,
+#endif
+    DONTWAIT = MSG_DONTWAIT
 };
 inline constexpr Send operator|(Send a, Send b) noexcept
 {
@@ -78,10 +86,27 @@ inline constexpr Send operator|(Send a, Send b) noexcept
 
 namespace methods {
 
+    /**
+    * @function errorString
+    * @desc Picks the message out of the result of strerror_r, which returns
+    * the message in its GNU variant and a status in its XSI variant.
+    */
+    inline const char *errorString(const char *_msg, const char *) noexcept
+    {
+        return _msg;
+    }
+
+    inline const char *errorString(const int _res, const char *_buf) noexcept
+    {
+        return (_res == 0) ? _buf : "Unknown error";
+    }
+
+
     /**
     * @function getErrorMsg
     * @desc Returns the standard human readable error message corresponding to
-    * given errorNumber.
+    * given errorNumber. Uses the reentrant strerror_r, so threads failing at
+    * the same time do not serialise on a lock.
     *
     * @param {int} errorNumber Error number whose string to return.
     * @returns {string} Standard error string corresponding to given
@@ -89,11 +114,8 @@ namespace methods {
     */
     inline std::string getErrorMsg(const int errorNumber)
     {
-        static std::mutex m;
-        std::lock_guard<std::mutex> lock(m);
-        const char *errMsg = strerror(errorNumber);
-        std::string returnString(errMsg);
-        return returnString;
+        char buf[256] = {};
+        return errorString(strerror_r(errorNumber, buf, sizeof(buf)), buf);
     }
 
     /**
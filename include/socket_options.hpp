@@ -7,10 +7,14 @@
 
 extern "C" {
 #include <sys/socket.h>
+#include <netinet/in.h>
 }
 
 namespace net {
 
+// Options of levels other than SOL_SOCKET carry their level in the upper 16
+// bits, since their numbers overlap (TCP_NODELAY == SO_DEBUG, TCP_MAXSEG ==
+// SO_REUSEADDR).
 enum class Opt {
 #ifdef SO_BROADCAST
     BROADCAST = SO_BROADCAST,
@@ -63,11 +67,14 @@ enum class Opt {
 #ifdef SO_USELOOPBACK
     USELOOPBACK = SO_USELOOPBACK,
 #endif
+#ifdef SO_ZEROCOPY
+    ZEROCOPY = SO_ZEROCOPY,
+#endif
 #ifdef TCP_MAXSEG
-    MAXSEG = TCP_MAXSEG,
+    MAXSEG = IPPROTO_TCP << 16 | TCP_MAXSEG,
 #endif
 #ifdef TCP_NODELAY
-    NODELAY = TCP_NODELAY
+    NODELAY = IPPROTO_TCP << 16 | TCP_NODELAY
 #endif
 };
 
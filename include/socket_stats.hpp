@@ -0,0 +1,252 @@
+#ifndef SOCKET_STATS_HPP
+#define SOCKET_STATS_HPP
+
+#include "hdr_histogram.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+extern "C" {
+#include <sys/types.h>
+#include <errno.h>
+}
+
+
+namespace net {
+
+/**
+* @enum net::StatOp
+* @desc Operations of net::Socket counted by net::SocketStats. READ and WRITE
+* cover every recv, read, send, write and their vectored, addressed and try
+* variants, the batched recvmmsg and sendmmsg counting the bytes of all
+* their datagrams, as well as sendFile, sendZeroCopy and the splice from the
+* Socket into the pipe. Every system call is one call, so a sendFile looping
+* until done counts each sendfile it makes.
+*/
+enum class StatOp : std::size_t { READ, WRITE, ACCEPT, CONNECT };
+
+
+/**
+* @class net::StatCounter
+* @desc Counter written by a single thread and readable by any. Updates are a
+* relaxed load and store rather than a locked read-modify-write, so they cost
+* the same as on a plain integer while readers never see a torn value.
+*/
+class StatCounter final {
+    std::atomic<std::uint64_t> value;
+
+public:
+    /**
+    * @construct net::StatCounter
+    * @access public
+    * @desc Creates a counter at 0.
+    */
+    StatCounter() noexcept : value(0) {}
+
+
+    /**
+    * @method add
+    * @access public
+    * @desc Adds _n to the counter. Writing thread only.
+    *
+    * @param {uint64_t} _n Amount to add.
+    */
+    void add(const std::uint64_t _n = 1) noexcept
+    {
+        value.store(value.load(std::memory_order_relaxed) + _n,
+                    std::memory_order_relaxed);
+    }
+
+
+    /**
+    * @method get
+    * @access public
+    * @desc Current value, from any thread.
+    *
+    * @returns {uint64_t}
+    */
+    std::uint64_t get() const noexcept
+    {
+        return value.load(std::memory_order_relaxed);
+    }
+
+
+    /**
+    * @method reset
+    * @access public
+    * @desc Sets the counter back to 0. Writing thread only.
+    */
+    void reset() noexcept { value.store(0, std::memory_order_relaxed); }
+};
+
+
+/**
+* @class net::OpStats
+* @desc Counters of one net::StatOp.
+*/
+struct OpStats {
+    // System calls made, retried ones included.
+    StatCounter calls;
+    // Bytes transferred, READ and WRITE only.
+    StatCounter bytes;
+    // Calls failing with EAGAIN, or EINPROGRESS for connect.
+    StatCounter wouldBlock;
+    // Writes which took only some of the bytes given.
+    StatCounter partial;
+    // Calls failing with any other error.
+    StatCounter errors;
+    // Duration of every call, in nanoseconds.
+    HdrHistogram latency;
+};
+
+
+/**
+* @class net::SocketStats
+* @desc Counters of the system calls made by net::Socket, kept only when the
+* library and its users are built with NET_SOCKET_STATS defined, which the
+* socket_stats meson option does; otherwise recording compiles to nothing.
+* Every thread records into its own instance, given by local, without any
+* lock, and total sums them all. A Socket may also record into an instance
+* attached to it with Socket::attachStats, which it then must be the only
+* one writing to.
+*/
+class SocketStats final {
+    OpStats ops[4];
+
+    SocketStats &operator=(const SocketStats &) = delete;
+
+public:
+    /**
+    * @construct net::SocketStats
+    * @access public
+    * @desc Creates stats with every counter at 0.
+    */
+    SocketStats() = default;
+
+
+    /**
+    * @construct net::SocketStats
+    * @access public
+    * @desc Creates a snapshot of _other, which may still be recording.
+    *
+    * @param {SocketStats} _other Stats to copy.
+    */
+    SocketStats(const SocketStats &);
+
+
+    /**
+    * @method operator[]
+    * @access public
+    * @desc Counters of operation _op.
+    *
+    * @param {StatOp} _op Operation.
+    * @returns {OpStats}
+    */
+    const OpStats &operator[](const StatOp _op) const noexcept
+    {
+        return ops[static_cast<std::size_t>(_op)];
+    }
+
+
+    /**
+    * @method record
+    * @access public
+    * @desc Counts one system call. Writing thread only.
+    *
+    * @param {StatOp} _op Operation made.
+    * @param {ssize_t} _res Return value of the call.
+    * @param {int} _errno errno after the call, used if _res is -1.
+    * @param {bool} _partial Whether a write took only some of the bytes.
+    * @param {nanoseconds} _took Duration of the call.
+    */
+    void record(StatOp, ssize_t, int, bool, std::chrono::nanoseconds) noexcept;
+
+
+    /**
+    * @method merge
+    * @access public
+    * @desc Adds the counters of _other. Writing thread only.
+    *
+    * @param {SocketStats} _other Stats to add.
+    */
+    void merge(const SocketStats &) noexcept;
+
+
+    /**
+    * @method reset
+    * @access public
+    * @desc Sets every counter back to 0. Writing thread only.
+    */
+    void reset() noexcept;
+
+
+    /**
+    * @method local
+    * @access public
+    * @desc Stats recorded by the calling thread.
+    *
+    * @returns {SocketStats}
+    */
+    static SocketStats &local() noexcept;
+
+
+    /**
+    * @method total
+    * @access public
+    * @desc Sum of the stats of every thread, those which exited included.
+    * Takes a lock, but only against threads starting or exiting, never
+    * against recording.
+    *
+    * @returns {SocketStats}
+    */
+    static SocketStats total();
+};
+
+
+#ifdef NET_SOCKET_STATS
+
+/**
+* @class net::StatsProbe
+* @desc Times one system call of net::Socket from its construction to done,
+* then records it in the stats of the thread and in _attached if not null.
+* errno is left as the call set it.
+*/
+class StatsProbe final {
+    const StatOp op;
+    SocketStats *const attached;
+    const std::chrono::steady_clock::time_point start;
+
+public:
+    StatsProbe(const StatOp _op, SocketStats *_attached) noexcept
+        : op(_op), attached(_attached), start(std::chrono::steady_clock::now())
+    {
+    }
+
+    void done(const ssize_t _res, const bool _partial = false) const noexcept
+    {
+        const auto currErrno = errno;
+        const auto took      = std::chrono::steady_clock::now() - start;
+
+        SocketStats::local().record(op, _res, currErrno, _partial, took);
+        if (attached != nullptr) {
+            attached->record(op, _res, currErrno, _partial, took);
+        }
+
+        errno = currErrno;
+    }
+};
+
+#else
+
+class StatsProbe final {
+public:
+    constexpr StatsProbe(StatOp, SocketStats *) noexcept {}
+
+    void done(ssize_t, bool = false) const noexcept {}
+};
+
+#endif
+}
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef STRING_VIEW_HPP
+#define STRING_VIEW_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+
+namespace net {
+
+/**
+* @class net::StringView
+* @desc Non-owning view of a contiguous sequence of bytes, usable from C++14.
+* Implicitly constructible from std::string, C strings and (under C++17)
+* std::string_view so that send/write never need to materialize a string.
+*/
+class StringView final {
+    const char *ptr;
+    std::size_t len;
+
+public:
+    constexpr StringView() noexcept : ptr(nullptr), len(0) {}
+    constexpr StringView(const char *_ptr, const std::size_t _len) noexcept
+        : ptr(_ptr), len(_len)
+    {
+    }
+    StringView(const char *_str) noexcept : ptr(_str), len(std::strlen(_str))
+    {
+    }
+    StringView(const std::string &_str) noexcept
+        : ptr(_str.data()), len(_str.size())
+    {
+    }
+
+#if __cplusplus >= 201703L
+    constexpr StringView(const std::string_view _str) noexcept
+        : ptr(_str.data()), len(_str.size())
+    {
+    }
+
+    constexpr operator std::string_view() const noexcept { return {ptr, len}; }
+#endif
+
+    constexpr auto data() const noexcept { return ptr; }
+    constexpr auto size() const noexcept { return len; }
+    constexpr auto length() const noexcept { return len; }
+    constexpr auto empty() const noexcept { return len == 0; }
+
+    constexpr auto begin() const noexcept { return ptr; }
+    constexpr auto end() const noexcept { return ptr + len; }
+
+    constexpr char operator[](const std::size_t _pos) const noexcept
+    {
+        return ptr[_pos];
+    }
+
+    /**
+    * @method substr
+    * @access public
+    * @desc Returns the view of at most _count bytes starting at _pos.
+    *
+    * @param {size_t} _pos Position of the first byte.
+    * @param {size_t} _count Maximum number of bytes.
+    * @returns {StringView} View of the requested bytes.
+    */
+    constexpr StringView substr(const std::size_t _pos,
+                                const std::size_t _count = -1) const noexcept
+    {
+        return (_pos >= len)
+          ? StringView(ptr + len, 0)
+          : StringView(ptr + _pos, (_count < len - _pos) ? _count : len - _pos);
+    }
+
+    std::string str() const { return std::string(ptr, len); }
+};
+
+
+inline bool operator==(const StringView _lhs, const StringView _rhs) noexcept
+{
+    return _lhs.size() == _rhs.size()
+      && (_lhs.size() == 0
+          || std::memcmp(_lhs.data(), _rhs.data(), _lhs.size()) == 0);
+}
+inline bool operator!=(const StringView _lhs, const StringView _rhs) noexcept
+{
+    return !(_lhs == _rhs);
+}
+}
+
+#endif
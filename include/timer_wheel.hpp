@@ -0,0 +1,242 @@
+#ifndef TIMER_WHEEL_HPP
+#define TIMER_WHEEL_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+
+namespace net {
+
+class TimerWheel;
+
+/**
+* @class net::TimerLink
+* @desc Links of the circular lists of timers kept in every slot of a
+* TimerWheel.
+*/
+class TimerLink {
+    friend class TimerWheel;
+    friend class Timer;
+
+    TimerLink *prev = this;
+    TimerLink *next = this;
+};
+
+
+/**
+* @class net::Timer
+* @desc Timer scheduled on a TimerWheel, typically a member of the object it
+* times out, such as a connection. The timer links itself into the wheel,
+* so scheduling, rescheduling and cancelling it never allocate. Destroying
+* a pending timer cancels it, and its callback may destroy it too.
+*/
+class Timer final : private TimerLink {
+    friend class TimerWheel;
+
+public:
+    using Callback = std::function<void()>;
+
+private:
+    TimerWheel *wheel      = nullptr;
+    std::uint64_t deadline = 0;
+    bool *destroyed        = nullptr;
+    Callback callback;
+
+    Timer(const Timer &) = delete;
+    Timer &operator=(const Timer &) = delete;
+
+
+public:
+    /**
+    * @construct net::Timer
+    * @access public
+    * @desc Creates a timer which is not scheduled yet.
+    *
+    * @param {Callback} _callback Invoked by the wheel when the timer expires.
+    */
+    explicit Timer(Callback _callback = nullptr)
+        : callback(std::move(_callback))
+    {
+    }
+
+
+    /**
+    * @method setCallback
+    * @access public
+    * @desc Replaces the callback invoked when the timer expires.
+    *
+    * @param {Callback} _callback Callback to invoke.
+    */
+    void setCallback(Callback _callback) { callback = std::move(_callback); }
+
+
+    /**
+    * @method pending
+    * @access public
+    * @desc Whether the timer is scheduled and has not expired yet.
+    *
+    * @returns {bool}
+    */
+    bool pending() const noexcept { return wheel != nullptr; }
+
+
+    /**
+    * @method cancel
+    * @access public
+    * @desc Cancels the timer if pending.
+    */
+    void cancel() noexcept;
+
+
+    ~Timer() noexcept
+    {
+        cancel();
+        if (destroyed != nullptr) {
+            *destroyed = true;
+        }
+    }
+};
+
+
+/**
+* @class net::TimerWheel
+* @desc Hierarchical timing wheel of four levels of 256 slots, in ticks of a
+* fixed resolution. A timer due within 256 ticks is placed in a slot of the
+* first level, later ones in coarser levels, from which they cascade down
+* as the wheel turns, so scheduling, cancelling and expiring a timer take
+* constant time however many are pending. Timers are due in up to 2^32
+* ticks, longer delays are shortened to that.
+* The wheel owns a one-shot timerfd, armed for the next tick at which a
+* timer is due or cascades down a level, so a wheel holding only a 30 s idle
+* timeout wakes its loop a few times rather than every tick. Registering
+* the timerfd with a Reactor drives the wheel:
+* reactor.add(wheel.fd(), Event::READ, [&](Event) { wheel.expire(); }).
+* Not thread-safe, like Reactor.
+*/
+class TimerWheel final {
+    friend class Timer;
+
+    static constexpr unsigned levelBits     = 8;
+    static constexpr std::size_t slots      = 1 << levelBits;
+    static constexpr std::size_t levels     = 4;
+    static constexpr std::uint64_t maxDelay = (std::uint64_t(1) << 32) - 1;
+
+    int tfd;
+    std::uint64_t armedTick = 0;
+    std::chrono::nanoseconds resolution;
+    std::chrono::steady_clock::time_point start;
+    std::uint64_t current = 0;
+    std::size_t count     = 0;
+
+    TimerLink buckets[levels][slots];
+
+    TimerWheel(const TimerWheel &) = delete;
+    TimerWheel &operator=(const TimerWheel &) = delete;
+
+    std::uint64_t elapsed() const noexcept;
+    void insert(Timer &) noexcept;
+    std::uint64_t nextEvent() const noexcept;
+    void arm(std::uint64_t);
+    std::size_t tick();
+
+
+public:
+    /**
+    * @construct net::TimerWheel
+    * @access public
+    * @desc Creates the timerfd if successful else throws runtime_error
+    * exception.
+    *
+    * @param {nanoseconds} _resolution Length of a tick.
+    */
+    explicit TimerWheel(
+      std::chrono::nanoseconds = std::chrono::milliseconds(1));
+
+
+    /**
+    * @method schedule
+    * @access public
+    * @desc Schedules _timer to expire after _delay, rounded up to whole ticks
+    * and counted from the last tick of the wheel. Reschedules it if already
+    * pending, on this wheel or another one. Never allocates.
+    *
+    * @param {Timer} _timer Timer to schedule.
+    * @param {duration} _delay Time until it expires.
+    */
+    template <typename Rep, typename Period>
+    void schedule(Timer &_timer, std::chrono::duration<Rep, Period> _delay)
+    {
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          _delay);
+        const auto ticks = (ns.count() <= 0)
+          ? 0
+          : (ns.count() + resolution.count() - 1) / resolution.count();
+
+        scheduleTicks(_timer, static_cast<std::uint64_t>(ticks));
+    }
+
+
+    /**
+    * @method scheduleTicks
+    * @access public
+    * @desc Schedules _timer to expire after _ticks ticks, at least one.
+    *
+    * @param {Timer} _timer Timer to schedule.
+    * @param {uint64_t} _ticks Number of ticks until it expires.
+    */
+    void scheduleTicks(Timer &, std::uint64_t);
+
+
+    /**
+    * @method expire
+    * @access public
+    * @desc Turns the wheel up to the present time, invoking the callbacks of
+    * the timers that expired, if successful else throws runtime_error
+    * exception. Call when fd() is readable. Callbacks may schedule and
+    * cancel timers, including the one expiring.
+    *
+    * @returns {size_t} Number of timers expired.
+    */
+    std::size_t expire();
+
+
+    /**
+    * @method advance
+    * @access public
+    * @desc Turns the wheel by _ticks ticks without looking at the clock,
+    * invoking the callbacks of the timers that expired. Meant for tests and
+    * simulations.
+    *
+    * @param {uint64_t} _ticks Number of ticks to turn.
+    * @returns {size_t} Number of timers expired.
+    */
+    std::size_t advance(std::uint64_t);
+
+
+    /**
+    * @method fd
+    * @access public
+    * @desc Get the timerfd to watch for Event::READ.
+    *
+    * @returns {int}
+    */
+    int fd() const noexcept { return tfd; }
+
+
+    /**
+    * @method size
+    * @access public
+    * @desc Get the number of pending timers.
+    *
+    * @returns {size_t}
+    */
+    std::size_t size() const noexcept { return count; }
+
+
+    ~TimerWheel() noexcept;
+};
+}
+
+#endif
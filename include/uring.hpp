@@ -0,0 +1,258 @@
+#ifndef URING_HPP
+#define URING_HPP
+
+#include "socket.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+extern "C" {
+#include <linux/io_uring.h>
+}
+
+
+namespace net {
+
+/**
+* @class net::Uring
+* @desc io_uring instance executing accept, recv, send and close on Socket
+* descriptors as submitted operations, so a busy loop pays one syscall per
+* batch instead of one per operation. Accept and recv are multishot: armed
+* once, they complete again and again until they fail. Multishot recv takes
+* its buffers from a ring registered with provideBuffers, so memory is only
+* tied up by connections that actually received data.
+* Talks to the kernel ABI directly and needs Linux 6.0 or later. Not thread
+* safe; use one Uring per thread.
+*/
+class Uring final {
+public:
+    /**
+    * @class net::Uring::Completion
+    * @desc Result of an operation: the user data given at submission and
+    * the syscall result, negative errno on failure.
+    */
+    struct Completion {
+        std::uint64_t data;
+        std::int32_t res;
+        std::uint32_t flags;
+
+        // true if a multishot operation stays armed after this completion.
+        bool more() const noexcept { return flags & IORING_CQE_F_MORE; }
+        bool hasBuffer() const noexcept { return flags & IORING_CQE_F_BUFFER; }
+        std::uint16_t buffer() const noexcept
+        {
+            return flags >> IORING_CQE_BUFFER_SHIFT;
+        }
+    };
+
+private:
+    int ringfd = -1;
+
+    std::uint32_t sqMask      = 0;
+    std::uint32_t sqEntries   = 0;
+    std::uint32_t sqTail      = 0;
+    std::uint32_t sqSubmitted = 0;
+    std::uint32_t *sqHead     = nullptr;
+    std::uint32_t *sqKTail    = nullptr;
+    io_uring_sqe *sqes        = nullptr;
+
+    std::uint32_t cqMask  = 0;
+    std::uint32_t *cqHead = nullptr;
+    std::uint32_t *cqTail = nullptr;
+    io_uring_cqe *cqes    = nullptr;
+
+    void *sqRing           = nullptr;
+    void *cqRing           = nullptr;
+    std::size_t sqRingSize = 0;
+    std::size_t cqRingSize = 0;
+    std::size_t sqesSize   = 0;
+
+    io_uring_buf *bufRing = nullptr;
+    std::unique_ptr<char[]> bufStorage;
+    std::size_t bufRingSize = 0;
+    std::uint32_t bufSize   = 0;
+    std::uint16_t bufMask   = 0;
+    std::uint16_t bufTail   = 0;
+
+    static constexpr std::uint16_t bufGroup = 0;
+
+    Uring(const Uring &) = delete;
+    Uring &operator=(const Uring &) = delete;
+
+
+    /**
+    * @method getSqe
+    * @access private
+    * @desc Returns a zeroed submission queue entry, submitting pending
+    * entries first if the queue is full.
+    *
+    * @returns {io_uring_sqe *} Entry to fill.
+    */
+    io_uring_sqe *getSqe();
+
+
+    void pushBuffer(const std::uint16_t) noexcept;
+    void release() noexcept;
+
+
+public:
+    /**
+    * @construct net::Uring
+    * @access public
+    * @desc Sets up the rings if successful else throws runtime_error
+    * exception.
+    *
+    * @param {unsigned} _entries Size of the submission queue.
+    */
+    explicit Uring(const unsigned _entries = 256);
+
+    ~Uring() noexcept;
+
+
+    /**
+    * @method provideBuffers
+    * @access public
+    * @desc Registers _count buffers of _size bytes each for multishot recv if
+    * successful else throws runtime_error exception. Can be called once.
+    *
+    * @param {uint16_t} _count Number of buffers, a power of 2.
+    * @param {uint32_t} _size Size of each buffer.
+    */
+    void provideBuffers(const std::uint16_t, const std::uint32_t);
+
+
+    /**
+    * @method buffer
+    * @access public
+    * @desc Get the data received by a recv completion. The buffer must be
+    * given back with recycle once the data is consumed.
+    *
+    * @param {Completion} _c Successful recv completion.
+    * @returns {StringView} Received data.
+    */
+    StringView buffer(const Completion &_c) const noexcept
+    {
+        const auto offset = std::size_t(_c.buffer()) * bufSize;
+        return StringView(bufStorage.get() + offset, _c.res);
+    }
+
+
+    /**
+    * @method recycle
+    * @access public
+    * @desc Gives the buffer of a recv completion back to the kernel.
+    *
+    * @param {Completion} _c Completion holding a buffer.
+    */
+    void recycle(const Completion &_c) noexcept
+    {
+        if (_c.hasBuffer()) {
+            pushBuffer(_c.buffer());
+        }
+    }
+
+
+    /**
+    * @method recycle
+    * @access public
+    * @desc Gives buffer _id back to the kernel, for buffers kept past their
+    * recv completion, for example to send them.
+    *
+    * @param {uint16_t} _id Buffer id from Completion::buffer.
+    */
+    void recycle(const std::uint16_t _id) noexcept { pushBuffer(_id); }
+
+
+    /**
+    * @method accept
+    * @access public
+    * @desc Queues a multishot accept on listening Socket _s. Every accepted
+    * connection completes with its descriptor as result.
+    *
+    * @param {Socket} _s Listening socket.
+    * @param {uint64_t} _data User data of the completions.
+    */
+    void accept(const Socket &, const std::uint64_t);
+
+
+    /**
+    * @method recv
+    * @access public
+    * @desc Queues a multishot recv on descriptor _fd using the provided
+    * buffers. Completes with 0 at end of stream, and with -ENOBUFS, not
+    * armed anymore, if no buffer was left.
+    *
+    * @param {int} _fd Connected socket descriptor.
+    * @param {uint64_t} _data User data of the completions.
+    */
+    void recv(const int, const std::uint64_t);
+
+
+    /**
+    * @method send
+    * @access public
+    * @desc Queues a send of _len bytes of _msg on descriptor _fd. _msg must
+    * stay valid until completion, which may report a partial send.
+    *
+    * @param {int} _fd Connected socket descriptor.
+    * @param {char *} _msg Data to send.
+    * @param {size_t} _len Number of bytes to send.
+    * @param {uint64_t} _data User data of the completion.
+    */
+    void send(const int, const char *, const std::size_t, const std::uint64_t);
+
+
+    /**
+    * @method close
+    * @access public
+    * @desc Queues the close of descriptor _fd.
+    *
+    * @param {int} _fd Descriptor to close.
+    * @param {uint64_t} _data User data of the completion.
+    */
+    void close(const int, const std::uint64_t);
+
+
+    /**
+    * @method submit
+    * @access public
+    * @desc Submits queued operations and waits for at least _waitFor
+    * completions if successful else throws runtime_error exception.
+    *
+    * @param {unsigned} _waitFor Number of completions to wait for.
+    * @returns {unsigned} Number of operations submitted.
+    */
+    unsigned submit(const unsigned = 0);
+
+
+    /**
+    * @method complete
+    * @access public
+    * @desc Invokes the callable provided with every available completion.
+    *
+    * @param {callable} _fn Some callable that takes arg of type Completion.
+    * @returns {size_t} Number of completions handled.
+    */
+    template <typename F>
+    std::size_t complete(F &&_fn)
+    {
+        auto head         = *cqHead;
+        const auto tail   = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+        std::size_t count = 0;
+
+        while (head != tail) {
+            const auto &cqe = cqes[head & cqMask];
+            const Completion c{cqe.user_data, cqe.res, cqe.flags};
+
+            // Release the entry before the callback, which may queue more.
+            __atomic_store_n(cqHead, ++head, __ATOMIC_RELEASE);
+            _fn(c);
+            ++count;
+        }
+
+        return count;
+    }
+};
+}
+
+#endif
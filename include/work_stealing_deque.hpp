@@ -0,0 +1,187 @@
+#ifndef WORK_STEALING_DEQUE_HPP
+#define WORK_STEALING_DEQUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+
+namespace net {
+
+/**
+* @class net::WorkStealingDeque
+* @desc Chase-Lev deque of pointers, lock-free. Its owner thread pushes and
+* pops at the bottom, last in first out so the work it just created is still
+* in cache, while any other thread steals from the top, oldest first. The
+* ring doubles when full; rings outgrown are kept until destruction, as
+* thieves may still be reading them.
+*/
+template <typename T>
+class WorkStealingDeque final {
+    struct Ring {
+        const std::int64_t capacity;
+        std::unique_ptr<std::atomic<T *>[]> items;
+
+        explicit Ring(const std::int64_t _capacity)
+            : capacity(_capacity), items(new std::atomic<T *>[_capacity])
+        {
+        }
+
+        T *get(const std::int64_t _i) const noexcept
+        {
+            return items[_i & (capacity - 1)].load(std::memory_order_relaxed);
+        }
+
+        void put(const std::int64_t _i, T *_item) noexcept
+        {
+            items[_i & (capacity - 1)].store(_item, std::memory_order_relaxed);
+        }
+    };
+
+    std::atomic<std::int64_t> top;
+    std::atomic<std::int64_t> bottom;
+    std::atomic<Ring *> ring;
+    std::vector<std::unique_ptr<Ring>> rings;
+
+    WorkStealingDeque(const WorkStealingDeque &) = delete;
+    WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+
+    Ring *grow(Ring *_old, const std::int64_t _top, const std::int64_t _bottom)
+    {
+        rings.emplace_back(std::make_unique<Ring>(_old->capacity * 2));
+        const auto bigger = rings.back().get();
+        for (auto i = _top; i < _bottom; ++i) {
+            bigger->put(i, _old->get(i));
+        }
+
+        ring.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+
+
+public:
+    /**
+    * @construct net::WorkStealingDeque
+    * @access public
+    * @desc Creates an empty deque.
+    *
+    * @param {size_t} _capacity Initial capacity, rounded up to a power of 2.
+    */
+    explicit WorkStealingDeque(const std::size_t _capacity = 1024)
+        : top(0), bottom(0)
+    {
+        std::int64_t capacity = 1;
+        while (capacity < static_cast<std::int64_t>(_capacity)) {
+            capacity *= 2;
+        }
+
+        rings.emplace_back(std::make_unique<Ring>(capacity));
+        ring.store(rings.back().get(), std::memory_order_relaxed);
+    }
+
+
+    /**
+    * @method push
+    * @access public
+    * @desc Adds _item at the bottom. Owner thread only.
+    *
+    * @param {T *} _item Item to add, not null.
+    */
+    void push(T *_item)
+    {
+        const auto b = bottom.load(std::memory_order_relaxed);
+        const auto t = top.load(std::memory_order_acquire);
+        auto r       = ring.load(std::memory_order_relaxed);
+
+        if (b - t > r->capacity - 1) {
+            r = grow(r, t, b);
+        }
+
+        r->put(b, _item);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+
+    /**
+    * @method pop
+    * @access public
+    * @desc Takes the item at the bottom. Owner thread only.
+    *
+    * @returns {T *} Item taken, nullptr if empty.
+    */
+    T *pop() noexcept
+    {
+        const auto b = bottom.load(std::memory_order_relaxed) - 1;
+        const auto r = ring.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto t = top.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        auto item = r->get(b);
+        if (t == b) {
+            // The last item, which a thief may be taking as well.
+            if (!top.compare_exchange_strong(t, t + 1,
+                                             std::memory_order_seq_cst,
+                                             std::memory_order_relaxed)) {
+                item = nullptr;
+            }
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+
+        return item;
+    }
+
+
+    /**
+    * @method steal
+    * @access public
+    * @desc Takes the item at the top. Any thread.
+    *
+    * @returns {T *} Item taken, nullptr if empty or if another thread took
+    * it first.
+    */
+    T *steal() noexcept
+    {
+        auto t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto b = bottom.load(std::memory_order_acquire);
+
+        if (t >= b) {
+            return nullptr;
+        }
+
+        const auto item = ring.load(std::memory_order_acquire)->get(t);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                         std::memory_order_relaxed)) {
+            return nullptr;
+        }
+
+        return item;
+    }
+
+
+    /**
+    * @method empty
+    * @access public
+    * @desc Whether the deque looked empty, which may change right away when
+    * called from other threads than the owner.
+    *
+    * @returns {bool}
+    */
+    bool empty() const noexcept
+    {
+        return bottom.load(std::memory_order_relaxed)
+          <= top.load(std::memory_order_relaxed);
+    }
+};
+}
+
+#endif
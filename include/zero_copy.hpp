@@ -0,0 +1,92 @@
+#ifndef ZERO_COPY_HPP
+#define ZERO_COPY_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace net {
+
+class Socket;
+
+/**
+* @class net::ZeroCopy
+* @desc Tracks MSG_ZEROCOPY sends of one Socket. The kernel numbers every
+* successful zero-copy send call of a socket 0, 1, 2, ... and later reports
+* ranges of completed numbers on the error queue. Socket::sendZeroCopy returns
+* the number of its last call, and the buffer sent may be reused once
+* isComplete() is true for it, after Socket::pollZeroCopy has read the
+* completions. A send that made no zero-copy call returns a number already
+* complete. Completions of a TCP socket are reported in order.
+* Requires Opt::ZEROCOPY enabled on the Socket.
+*/
+class ZeroCopy final {
+    friend class Socket;
+
+    std::uint32_t next = 0;
+    std::uint32_t done = 0;
+    std::size_t threshold;
+    bool lastCopied = false;
+
+    // A number isComplete holds true for, until 2^31 more sends are made.
+    // Returned for sends that left no page pinned.
+    std::uint32_t completed() const noexcept { return done - 1; }
+
+public:
+    /**
+    * @construct net::ZeroCopy
+    * @access public
+    * @param {size_t} _threshold Sends smaller than this are copied as usual,
+    * since pinning pages and reading completions costs more than copying them.
+    */
+    explicit ZeroCopy(const std::size_t _threshold = 10240) noexcept
+        : threshold(_threshold)
+    {
+    }
+
+
+    /**
+    * @method isComplete
+    * @access public
+    * @desc Check if the kernel released the buffer of the given send.
+    *
+    * @param {uint32_t} _id Number returned by Socket::sendZeroCopy.
+    * @returns {bool} true if the buffer may be reused.
+    */
+    bool isComplete(const std::uint32_t _id) const noexcept
+    {
+        return static_cast<std::int32_t>(_id - done) < 0;
+    }
+
+
+    /**
+    * @method pending
+    * @access public
+    * @desc Get the number of zero-copy sends not yet completed.
+    *
+    * @returns {uint32_t} Number of buffers still held by the kernel.
+    */
+    auto pending() const noexcept { return next - done; }
+
+
+    /**
+    * @method copied
+    * @access public
+    * @desc Check if the kernel fell back to copying for the last completion
+    * read, as it does on loopback and for devices without scatter-gather.
+    * Zero-copy only costs in that case and is better disabled.
+    *
+    * @returns {bool} true if the last completed sends were copied.
+    */
+    auto copied() const noexcept { return lastCopied; }
+
+
+    auto getThreshold() const noexcept { return threshold; }
+    void setThreshold(const std::size_t _threshold) noexcept
+    {
+        threshold = _threshold;
+    }
+};
+}
+
+#endif
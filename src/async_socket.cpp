@@ -0,0 +1,159 @@
+#include "async_socket.hpp"
+
+extern "C" {
+#include <sys/socket.h>
+}
+
+
+namespace net {
+
+AsyncSocket::AsyncSocket(Reactor &_reactor, Socket &&_sock)
+    : reactor(_reactor), sock(std::move(_sock))
+{
+    sock.setNonBlocking();
+
+    // Edge-triggered, so a descriptor nobody waits on stays quiet; every
+    // operation is tried before waiting, so no edge is missed.
+    reactor.add(sock,
+                Event::READ | Event::WRITE | Event::PEERCLOSE | Event::EDGE,
+                [this](Event _events) { ready(_events); });
+}
+
+
+AsyncSocket::~AsyncSocket() noexcept
+{
+    try {
+        reactor.remove(sock);
+    } catch (std::exception &) {
+    }
+}
+
+
+void AsyncSocket::wait(Operation *&_slot, Operation &_op,
+                       std::coroutine_handle<> _h)
+{
+    if (_slot != nullptr) {
+        throw std::invalid_argument("Socket already awaited in that direction");
+    }
+
+    _op.handle = _h;
+    _slot      = &_op;
+}
+
+
+void AsyncSocket::ready(Event _events) noexcept
+{
+    const auto failed = hasEvent(_events, Event::HANGUP | Event::ERROR);
+
+    // Both are taken before resuming either, as a coroutine resumed may
+    // destroy this AsyncSocket.
+    std::coroutine_handle<> read, write;
+    if (reader != nullptr
+        && (failed || hasEvent(_events, Event::READ | Event::PEERCLOSE))
+        && reader->attempt()) {
+        read   = reader->handle;
+        reader = nullptr;
+    }
+    if (writer != nullptr && (failed || hasEvent(_events, Event::WRITE))
+        && writer->attempt()) {
+        write  = writer->handle;
+        writer = nullptr;
+    }
+
+    if (read) {
+        read.resume();
+    }
+    if (write) {
+        write.resume();
+    }
+}
+
+
+void AsyncSocket::Operation::check() const
+{
+    if (!result) {
+        throw std::runtime_error(
+          net::methods::getErrorMsg(result.errorNumber()));
+    }
+}
+
+
+bool AsyncSocket::AcceptOp::attempt() noexcept
+{
+    peer.emplace(owner.sock.tryAccept(result));
+    return !result.wouldBlock();
+}
+
+
+Socket AsyncSocket::AcceptOp::await_resume()
+{
+    check();
+    return std::move(*peer);
+}
+
+
+bool AsyncSocket::RecvOp::attempt() noexcept
+{
+    result = owner.sock.tryRecv(buf, len);
+    return !result.wouldBlock();
+}
+
+
+std::size_t AsyncSocket::RecvOp::await_resume() const
+{
+    check();
+    return result.bytes();
+}
+
+
+bool AsyncSocket::SendOp::attempt() noexcept
+{
+    while (sent < len) {
+        result = owner.sock.trySend(msg + sent, len - sent, Send::NOSIGNAL);
+        if (!result) {
+            return !result.wouldBlock();
+        }
+        sent += result.bytes();
+    }
+
+    return true;
+}
+
+
+bool AsyncSocket::ConnectOp::attempt() noexcept
+{
+    if (!started) {
+        started = true;
+        result  = owner.sock.tryConnect(addr, port);
+        return !result.inProgress();
+    }
+
+    // Woken while connecting, the outcome is in SO_ERROR; a socket still
+    // connecting has no error and no peer yet.
+    auto error = 0;
+    auto size  = static_cast<socklen_t>(sizeof(error));
+    if (getsockopt(owner.sock.getSocket(), SOL_SOCKET, SO_ERROR, &error, &size)
+        < 0) {
+        error = errno;
+    }
+    if (error != 0) {
+        result = IoResult::fromErrno(error);
+        return true;
+    }
+
+    sockaddr_storage peerAddr;
+    socklen_t peerSize = sizeof(peerAddr);
+    if (getpeername(owner.sock.getSocket(),
+                    reinterpret_cast<sockaddr *>(&peerAddr), &peerSize)
+        < 0) {
+        if (errno == ENOTCONN) {
+            return false;
+        }
+        result = IoResult::fromErrno(errno);
+        return true;
+    }
+
+    result = IoResult();
+    return true;
+}
+}
@@ -0,0 +1,246 @@
+#include "buffer_pool.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_set>
+
+
+namespace net {
+
+namespace {
+
+std::atomic<std::uint64_t> nextId(1);
+
+std::mutex &registryMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+// Ids of the pools alive, so exiting threads skip the caches of pools
+// destroyed before them.
+std::unordered_set<std::uint64_t> &livePools()
+{
+    static std::unordered_set<std::uint64_t> ids;
+    return ids;
+}
+}
+
+
+constexpr std::size_t BufferPool::minSize;
+constexpr std::size_t BufferPool::maxSize;
+constexpr std::size_t BufferPool::classes;
+constexpr std::size_t BufferPool::slabBytes;
+
+
+struct BufferPool::LocalCache {
+    BufferPool *pool;
+    std::uint64_t id;
+    std::vector<char *> free[classes];
+};
+
+
+struct BufferPool::ThreadCaches {
+    LocalCache *last = nullptr;
+    std::vector<std::unique_ptr<LocalCache>> caches;
+
+    ~ThreadCaches()
+    {
+        std::lock_guard<std::mutex> lock(registryMutex());
+        for (auto &c : caches) {
+            if (livePools().count(c->id) == 0) {
+                continue;
+            }
+            for (std::size_t i = 0; i < classes; ++i) {
+                c->pool->spill(i, c->free[i], c->free[i].size());
+            }
+        }
+    }
+};
+
+
+thread_local BufferPool::ThreadCaches BufferPool::threadCaches;
+
+
+BufferPool::BufferPool(const std::size_t _cacheSize)
+    : id(nextId++), cacheSize(std::max<std::size_t>(_cacheSize, 2)),
+      oversized(0)
+{
+    std::lock_guard<std::mutex> lock(registryMutex());
+    livePools().insert(id);
+}
+
+
+BufferPool::LocalCache &BufferPool::localCache()
+{
+    auto &local = threadCaches;
+    if (local.last != nullptr && local.last->id == id) {
+        return *local.last;
+    }
+
+    for (auto &c : local.caches) {
+        if (c->id == id) {
+            local.last = c.get();
+            return *c;
+        }
+    }
+
+    // First use of this pool by the thread; drop the caches of pools
+    // destroyed meanwhile, whose buffers are gone with their slabs.
+    {
+        std::lock_guard<std::mutex> lock(registryMutex());
+        auto &caches = local.caches;
+        caches.erase(std::remove_if(caches.begin(), caches.end(),
+                                    [](const std::unique_ptr<LocalCache> &c) {
+                                        return livePools().count(c->id) == 0;
+                                    }),
+                     caches.end());
+    }
+
+    std::unique_ptr<LocalCache> cache(new LocalCache{this, id, {}});
+    local.caches.push_back(std::move(cache));
+    local.last = local.caches.back().get();
+    for (auto &f : local.last->free) {
+        f.reserve(cacheSize);
+    }
+
+    return *local.last;
+}
+
+
+void BufferPool::refill(const std::size_t _class, std::vector<char *> &_free)
+{
+    auto &sc = sizeClasses[_class];
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (!sc.shared.empty()) {
+        const auto n = std::min(sc.shared.size(), cacheSize / 2);
+        _free.insert(_free.end(), sc.shared.end() - n, sc.shared.end());
+        sc.shared.resize(sc.shared.size() - n);
+        return;
+    }
+
+    const auto size = minSize << _class;
+    slabs.emplace_back(new char[slabBytes]);
+    const auto slab = slabs.back().get();
+
+    // Buffers beyond what the cache keeps go to the shared list.
+    const auto n = slabBytes / size;
+    for (std::size_t i = 0; i < n; ++i) {
+        auto &to = (_free.size() < cacheSize / 2) ? _free : sc.shared;
+        to.push_back(slab + i * size);
+    }
+    sc.buffers += n;
+}
+
+
+void BufferPool::spill(const std::size_t _class, std::vector<char *> &_free,
+                       const std::size_t _n)
+{
+    auto &sc = sizeClasses[_class];
+    std::lock_guard<std::mutex> lock(mutex);
+
+    sc.shared.insert(sc.shared.end(), _free.end() - _n, _free.end());
+    _free.resize(_free.size() - _n);
+}
+
+
+BufferPool::Buffer BufferPool::acquire(const std::size_t _size)
+{
+    if (_size > maxSize) {
+        auto ptr = new char[_size];
+        ++oversized;
+        return Buffer(this, ptr, _size);
+    }
+
+    const auto c = classOf(_size);
+    auto &free   = localCache().free[c];
+    if (free.empty()) {
+        refill(c, free);
+    }
+
+    const auto ptr = free.back();
+    free.pop_back();
+    sizeClasses[c].inUse.fetch_add(1, std::memory_order_relaxed);
+    return Buffer(this, ptr, minSize << c);
+}
+
+
+void BufferPool::release(char *_ptr, const std::size_t _cap) noexcept
+{
+    if (_cap > maxSize) {
+        delete[] _ptr;
+        --oversized;
+        return;
+    }
+
+    const auto c = classOf(_cap);
+    sizeClasses[c].inUse.fetch_sub(1, std::memory_order_relaxed);
+
+    try {
+        auto &free = localCache().free[c];
+        if (free.size() >= cacheSize) {
+            spill(c, free, cacheSize / 2);
+        }
+        free.push_back(_ptr);
+    } catch (...) {
+        // Only a thread's first use of the pool allocates, for its cache;
+        // the buffer then goes straight to the shared list.
+        std::lock_guard<std::mutex> lock(mutex);
+        sizeClasses[c].shared.push_back(_ptr);
+    }
+}
+
+
+BufferPool::Stats BufferPool::classStats(const std::size_t _class) const
+{
+    const auto &sc = sizeClasses[_class];
+
+    Stats s;
+    s.buffers   = sc.buffers;
+    s.slabBytes = s.buffers * (minSize << _class);
+    s.inUse     = sc.inUse.load(std::memory_order_relaxed);
+    s.shared    = sc.shared.size();
+
+    // Read apart from each other, so clamped while buffers move around.
+    const auto out = s.inUse + s.shared;
+    s.cached       = (s.buffers > out) ? s.buffers - out : 0;
+    return s;
+}
+
+
+BufferPool::Stats BufferPool::stats() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    Stats total;
+    for (std::size_t i = 0; i < classes; ++i) {
+        const auto s = classStats(i);
+        total.slabBytes += s.slabBytes;
+        total.buffers += s.buffers;
+        total.inUse += s.inUse;
+        total.cached += s.cached;
+        total.shared += s.shared;
+    }
+    total.oversized = oversized;
+
+    return total;
+}
+
+
+BufferPool::Stats BufferPool::stats(const std::size_t _size) const
+{
+    if (_size > maxSize) {
+        throw std::invalid_argument("Size above maxSize");
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    return classStats(classOf(_size));
+}
+
+
+BufferPool::~BufferPool() noexcept
+{
+    std::lock_guard<std::mutex> lock(registryMutex());
+    livePools().erase(id);
+}
+}
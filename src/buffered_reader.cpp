@@ -0,0 +1,158 @@
+#include "buffered_reader.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+extern "C" {
+#include <sys/mman.h>
+#include <unistd.h>
+}
+
+
+namespace net {
+
+BufferedReader::BufferedReader(const Socket &_sock, std::size_t _capacity)
+    : sock(_sock)
+{
+    const auto page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    cap = std::max<std::size_t>((_capacity + page - 1) / page, 1) * page;
+
+    const auto fd = memfd_create("net::BufferedReader", MFD_CLOEXEC);
+    if (fd == -1) {
+        const auto currErrno = errno;
+        throw std::runtime_error(net::methods::getErrorMsg(currErrno));
+    }
+
+    // Reserve twice the capacity, then map the same pages into both halves.
+    auto res = (ftruncate(fd, cap) == 0)
+      ? mmap(nullptr, 2 * cap, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)
+      : MAP_FAILED;
+
+    if (res != MAP_FAILED) {
+        ring = static_cast<char *>(res);
+        for (auto half : {ring, ring + cap}) {
+            if (mmap(half, cap, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED,
+                     fd, 0)
+                == MAP_FAILED) {
+                munmap(ring, 2 * cap);
+                res = MAP_FAILED;
+                break;
+            }
+        }
+    }
+
+    const auto currErrno = errno;
+    ::close(fd);
+    if (res == MAP_FAILED) {
+        throw std::runtime_error(net::methods::getErrorMsg(currErrno));
+    }
+}
+
+
+StringView BufferedReader::readUntil(StringView _delim, bool *_errorNB)
+{
+    if (_delim.size() == 0) {
+        throw std::invalid_argument("Delimiter is empty");
+    }
+
+    while (true) {
+        const auto from = ring + head + scanned;
+        const auto left = buffered() - scanned;
+
+        // memchr and memmem are vectorised in the C library.
+        const auto found = static_cast<const char *>(
+          (_delim.size() == 1)
+            ? std::memchr(from, _delim[0], left)
+            : memmem(from, left, _delim.data(), _delim.size()));
+
+        if (found != nullptr) {
+            return take(found - (ring + head) + _delim.size());
+        }
+
+        // A delimiter may start in the last bytes and end in the next recv.
+        scanned = std::max(buffered(), _delim.size() - 1) - (_delim.size() - 1);
+
+        if (buffered() == cap) {
+            throw std::runtime_error("Delimiter not found within capacity");
+        }
+        if (!receive(_errorNB)) {
+            return StringView();
+        }
+    }
+}
+
+
+StringView BufferedReader::readExact(const std::size_t _len, bool *_errorNB)
+{
+    if (_len > cap) {
+        throw std::invalid_argument("Length exceeds capacity");
+    }
+
+    while (buffered() < _len) {
+        if (!receive(_errorNB)) {
+            return StringView();
+        }
+    }
+
+    return take(_len);
+}
+
+
+void BufferedReader::consume(const std::size_t _len) noexcept
+{
+    take(std::min(_len, buffered()));
+}
+
+
+bool BufferedReader::receive(bool *_errorNB)
+{
+    if (buffered() == cap) {
+        return false;
+    }
+
+    // Packets longer than the room left are cut by the kernel; MSG_TRUNC
+    // makes recv return their full length so the loss is caught.
+    const auto type  = static_cast<int>(sock.getType()) & 0xf;
+    const auto flags = (type == SOCK_STREAM) ? Recv::NONE : Recv::TRUNC;
+    const auto room  = cap - buffered();
+
+    auto errorNB     = false;
+    const auto recvd = sock.recv(ring + tail, room, flags,
+                                 (_errorNB != nullptr) ? &errorNB : nullptr);
+
+    if (errorNB) {
+        *_errorNB = true;
+        return false;
+    }
+    if (recvd == 0) {
+        closed = true;
+        return false;
+    }
+    if (static_cast<std::size_t>(recvd) > room) {
+        throw std::runtime_error("Packet larger than buffer, truncated");
+    }
+
+    tail += recvd;
+    return true;
+}
+
+
+StringView BufferedReader::take(const std::size_t _len) noexcept
+{
+    const StringView msg(ring + head, _len);
+
+    head += _len;
+    scanned = 0;
+
+    // Keep head in the first mapping; the second one mirrors the wrap.
+    if (head >= cap) {
+        head -= cap;
+        tail -= cap;
+    }
+
+    return msg;
+}
+
+
+BufferedReader::~BufferedReader() noexcept { munmap(ring, 2 * cap); }
+}
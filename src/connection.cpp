@@ -0,0 +1,82 @@
+#include "connection.hpp"
+
+
+namespace net {
+
+Connection::Connection(Socket &&_s) noexcept
+    : Connection(_s.sockfd, _s.sock_domain, _s.sock_type)
+{
+    if (_s.isClosed) {
+        fd = -1;
+    }
+
+    _s.sockfd   = -1;
+    _s.isClosed = true;
+}
+
+
+Connection &Connection::operator=(Connection &&_other) noexcept
+{
+    if (this != &_other) {
+        close();
+        fd        = _other.fd;
+        family    = _other.family;
+        sockType  = _other.sockType;
+        _other.fd = -1;
+    }
+
+    return *this;
+}
+
+
+AddrStore Connection::peer() const
+{
+    AddrStore addr;
+    std::memset(&addr, 0, sizeof(addr));
+    socklen_t len = sizeof(addr);
+
+    if (::getpeername(fd, reinterpret_cast<sockaddr *>(&addr), &len) == -1) {
+        const auto currErrno = errno;
+        throw std::runtime_error(net::methods::getErrorMsg(currErrno));
+    }
+
+    return addr;
+}
+
+
+Socket Connection::view() const noexcept
+{
+    Socket s(fd, domain(), type(), nullptr);
+    s.isClosed = true;
+    return s;
+}
+
+
+Socket Connection::toSocket()
+{
+    AddrStore addr;
+    std::memset(&addr, 0, sizeof(addr));
+    socklen_t len = sizeof(addr);
+
+    // Unconnected datagram sockets have no peer; their address stays empty.
+    const auto res
+      = ::getpeername(fd, reinterpret_cast<sockaddr *>(&addr), &len);
+
+    Socket s(fd, domain(), type(), (res == 0) ? &addr : nullptr);
+    s.isClosed = (fd == -1);
+    fd         = -1;
+    return s;
+}
+
+
+bool Connection::close() noexcept
+{
+    if (fd == -1) {
+        return false;
+    }
+
+    const auto res = ::close(fd);
+    fd             = -1;
+    return res == 0;
+}
+}
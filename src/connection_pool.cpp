@@ -0,0 +1,80 @@
+#include "connection_pool.hpp"
+#include <algorithm>
+
+
+namespace net {
+
+ConnectionPool::ConnectionPool(Domain _domain, const std::size_t _minIdle,
+                               const std::size_t _maxIdle)
+    : domain(_domain), minIdle(_minIdle), maxIdle(std::max(_minIdle, _maxIdle))
+{
+}
+
+
+ConnectionPool::Endpoint &ConnectionPool::endpoint(const char _addr[],
+                                                   const int _port)
+{
+    auto key = std::string(_addr) + ':' + std::to_string(_port);
+
+    auto it = endpoints.find(key);
+    if (it == endpoints.end()) {
+        Endpoint ep(_addr, _port);
+
+        // Returned connections never reallocate, keeping release noexcept.
+        ep.idleSockets.reserve(maxIdle);
+
+        // Registered only once warm, so a failed warm-up leaves nothing
+        // behind and the next call tries again.
+        warmUp(ep);
+        it = endpoints.emplace(std::move(key), std::move(ep)).first;
+    }
+
+    return it->second;
+}
+
+
+void ConnectionPool::warmUp(Endpoint &_ep)
+{
+    while (_ep.idleSockets.size() < minIdle) {
+        _ep.idleSockets.push_back(open(_ep));
+    }
+}
+
+
+ConnectionPool::Lease ConnectionPool::acquire(Endpoint &_ep)
+{
+    while (!_ep.idleSockets.empty()) {
+        Socket sock(std::move(_ep.idleSockets.back()));
+        _ep.idleSockets.pop_back();
+
+        if (healthy(sock)) {
+            return Lease(this, &_ep, std::move(sock), true);
+        }
+    }
+
+    return Lease(this, &_ep, open(_ep), false);
+}
+
+
+bool ConnectionPool::healthy(const Socket &_sock) noexcept
+{
+    char c;
+    return _sock.tryRecv(&c, 1, Recv::PEEK | Recv::DONTWAIT).wouldBlock();
+}
+
+
+Socket ConnectionPool::open(const Endpoint &_ep) const
+{
+    Socket sock(domain, Type::TCP);
+    sock.connect(_ep.addr.c_str(), _ep.port);
+    return sock;
+}
+
+
+void ConnectionPool::release(Endpoint &_ep, Socket &&_sock) noexcept
+{
+    if (_ep.idleSockets.size() < maxIdle) {
+        _ep.idleSockets.push_back(std::move(_sock));
+    }
+}
+}
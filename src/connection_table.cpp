@@ -0,0 +1,119 @@
+#include "connection_table.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace net {
+
+constexpr std::uint32_t ConnectionTable::none;
+
+
+void ConnectionTable::reserve(const std::size_t _capacity)
+{
+    // Slots are only added when every slot is in use, so the slot arrays
+    // never outgrow the entry arrays and insert never reallocates them.
+    slotEntries.reserve(_capacity);
+    slotGenerations.reserve(_capacity);
+    connections.reserve(_capacity);
+    descriptors.reserve(_capacity);
+    owners.reserve(_capacity);
+    states.reserve(_capacity);
+    activity.reserve(_capacity);
+}
+
+
+ConnectionTable::Id ConnectionTable::insert(Connection &&_conn,
+                                            const std::uint8_t _state,
+                                            const Clock::time_point _now)
+{
+    const auto fd = _conn.getSocket();
+    if (fd < 0) {
+        throw std::invalid_argument("Connection is empty");
+    }
+
+    const auto index = static_cast<std::size_t>(fd);
+    if (index < fdSlots.size() && fdSlots[index] != 0) {
+        throw std::invalid_argument("Descriptor already in table");
+    }
+
+    // Everything that may throw happens before the table is touched.
+    if (index >= fdSlots.size()) {
+        fdSlots.resize(std::max(index + 1, 2 * fdSlots.size()), 0);
+    }
+    if (connections.size() == connections.capacity()) {
+        reserve(std::max<std::size_t>(64, 2 * connections.size()));
+    }
+
+    std::uint32_t slot = freeSlots;
+    if (slot != none) {
+        freeSlots = slotEntries[slot];
+    } else {
+        slot = static_cast<std::uint32_t>(slotEntries.size());
+        slotEntries.push_back(0);
+        slotGenerations.push_back(0);
+    }
+
+    const auto e = static_cast<std::uint32_t>(connections.size());
+    connections.push_back(std::move(_conn));
+    descriptors.push_back(fd);
+    owners.push_back(slot);
+    states.push_back(_state);
+    activity.push_back(_now);
+
+    slotEntries[slot] = e;
+    fdSlots[index]    = slot + 1;
+    return Id(slot, ++slotGenerations[slot]);
+}
+
+
+Connection ConnectionTable::release(const Id _id) noexcept
+{
+    const auto e = entry(_id);
+    if (e == none) {
+        return Connection();
+    }
+
+    Connection conn(std::move(connections[e]));
+    fdSlots[descriptors[e]] = 0;
+
+    const auto last = connections.size() - 1;
+    if (e != last) {
+        connections[e]         = std::move(connections[last]);
+        descriptors[e]         = descriptors[last];
+        owners[e]              = owners[last];
+        states[e]              = states[last];
+        activity[e]            = activity[last];
+        slotEntries[owners[e]] = e;
+    }
+
+    connections.pop_back();
+    descriptors.pop_back();
+    owners.pop_back();
+    states.pop_back();
+    activity.pop_back();
+
+    ++slotGenerations[_id.index];
+    slotEntries[_id.index] = freeSlots;
+    freeSlots              = _id.index;
+    return conn;
+}
+
+
+void ConnectionTable::clear() noexcept
+{
+    while (!connections.empty()) {
+        erase(idAt(connections.size() - 1));
+    }
+}
+
+
+std::uint8_t ConnectionTable::state(const Id _id) const
+{
+    const auto e = entry(_id);
+    if (e == none) {
+        throw std::out_of_range("Stale connection id");
+    }
+
+    return states[e];
+}
+}
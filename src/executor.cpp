@@ -0,0 +1,155 @@
+#include "executor.hpp"
+#include <algorithm>
+
+
+namespace net {
+
+namespace {
+
+    // Worker running on this thread, so jobs submitted by jobs stay local.
+    thread_local const Executor *currentExecutor = nullptr;
+    thread_local std::size_t currentWorker       = 0;
+
+    // Where the next round of stealing starts, so idle workers spread over
+    // their victims instead of all trying the same one.
+    thread_local std::size_t nextVictim = 0;
+}
+
+
+Executor::Executor(std::size_t _threads, ErrorHandler _onError)
+    : sleepers(0), stopping(false), onError(std::move(_onError))
+{
+    if (_threads == 0) {
+        _threads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    workers.reserve(_threads);
+    for (std::size_t i = 0; i < _threads; ++i) {
+        workers.emplace_back(std::make_unique<Worker>());
+    }
+
+    // Started once all deques exist, as every worker steals from the others.
+    try {
+        for (std::size_t i = 0; i < _threads; ++i) {
+            workers[i]->thread = std::thread(&Executor::work, this, i);
+        }
+    } catch (...) {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        wakeup.notify_all();
+        for (auto &w : workers) {
+            if (w->thread.joinable()) {
+                w->thread.join();
+            }
+        }
+        throw;
+    }
+}
+
+
+Executor::~Executor() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeup.notify_all();
+
+    for (auto &w : workers) {
+        w->thread.join();
+    }
+}
+
+
+void Executor::enqueue(std::unique_ptr<Job> _job)
+{
+    if (currentExecutor == this) {
+        workers[currentWorker]->jobs.push(_job.get());
+    } else {
+        std::lock_guard<std::mutex> lock(sharedMutex);
+        shared.push_back(_job.get());
+    }
+    _job.release();
+
+    // Pairs with the fence of a worker going to sleep: either it sees the
+    // job, or this sees it sleeping and wakes it.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepers.load(std::memory_order_relaxed) > 0) {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        wakeup.notify_one();
+    }
+}
+
+
+Executor::Job *Executor::find(const std::size_t _index) noexcept
+{
+    if (const auto job = workers[_index]->jobs.pop()) {
+        return job;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(sharedMutex);
+        if (!shared.empty()) {
+            const auto job = shared.front();
+            shared.pop_front();
+            return job;
+        }
+    }
+
+    const auto n     = workers.size();
+    const auto start = nextVictim++;
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto victim = (start + i) % n;
+        if (victim == _index) {
+            continue;
+        }
+        if (const auto job = workers[victim]->jobs.steal()) {
+            return job;
+        }
+    }
+
+    return nullptr;
+}
+
+
+void Executor::work(const std::size_t _index) noexcept
+{
+    currentExecutor = this;
+    currentWorker   = _index;
+
+    while (true) {
+        auto job = find(_index);
+
+        if (job == nullptr) {
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            sleepers.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            // Looked for once more, as a job submitted before the worker
+            // counted as sleeping did not wake it.
+            job = find(_index);
+            while (job == nullptr && !stopping) {
+                wakeup.wait(lock);
+                job = find(_index);
+            }
+            sleepers.fetch_sub(1, std::memory_order_relaxed);
+
+            if (job == nullptr) {
+                break;
+            }
+        }
+
+        try {
+            std::unique_ptr<Job>(job)->run();
+        } catch (...) {
+            if (onError) {
+                onError(std::current_exception());
+            }
+        }
+    }
+
+    currentExecutor = nullptr;
+}
+}
@@ -0,0 +1,129 @@
+#include "framing.hpp"
+#include <cstring>
+#include <stdexcept>
+
+extern "C" {
+#include <arpa/inet.h>
+}
+
+
+namespace net {
+
+namespace {
+
+    constexpr std::size_t headerLen = sizeof(std::uint32_t);
+}
+
+
+FrameWriter::FrameWriter(const Socket &_sock, const std::size_t _batch,
+                         const std::size_t _maxFrame)
+    : sock(_sock), batch(_batch), maxFrame(_maxFrame),
+      packets((static_cast<int>(_sock.getType()) & 0xf) == SOCK_SEQPACKET)
+{
+    buf.reserve(batch + headerLen);
+}
+
+
+void FrameWriter::write(StringView _payload, bool *_errorNB)
+{
+    if (_payload.size() > maxFrame) {
+        throw std::invalid_argument("Frame exceeds maximum size");
+    }
+
+    const auto len = htonl(static_cast<std::uint32_t>(_payload.size()));
+    buf.append(reinterpret_cast<const char *>(&len), headerLen);
+    buf.append(_payload.data(), _payload.size());
+
+    if (pending() >= batch) {
+        flush(_errorNB);
+    }
+}
+
+
+std::size_t FrameWriter::packetLen() const noexcept
+{
+    if (!packets) {
+        return pending();
+    }
+
+    // Whole frames only, no more than the largest frame takes on its own.
+    std::size_t len = 0;
+    while (sent + len < buf.size()) {
+        std::uint32_t frameLen;
+        std::memcpy(&frameLen, buf.data() + sent + len, headerLen);
+        const auto next = headerLen + ntohl(frameLen);
+
+        if (len > 0 && len + next > maxFrame + headerLen) {
+            break;
+        }
+        len += next;
+    }
+
+    return len;
+}
+
+
+bool FrameWriter::flush(bool *_errorNB)
+{
+    while (pending() > 0) {
+        const auto res = sock.trySend(buf.data() + sent, packetLen());
+
+        if (!res) {
+            if (res.wouldBlock()) {
+                if (_errorNB != nullptr) {
+                    *_errorNB = true;
+                } else {
+                    throw std::invalid_argument("errorNB argument missing");
+                }
+                return false;
+            }
+            throw std::runtime_error(
+              net::methods::getErrorMsg(res.errorNumber()));
+        }
+
+        sent += res.bytes();
+    }
+
+    buf.clear();
+    sent = 0;
+    return true;
+}
+
+
+FrameReader::FrameReader(const Socket &_sock, const std::size_t _maxFrame)
+    : reader(_sock, _maxFrame + headerLen), maxFrame(_maxFrame)
+{
+}
+
+
+bool FrameReader::read(StringView &_payload, bool *_errorNB)
+{
+    if (!inFrame) {
+        const auto header = reader.readExact(headerLen, _errorNB);
+        if (header.size() != headerLen) {
+            return false;
+        }
+
+        std::memcpy(&frameLen, header.data(), headerLen);
+        frameLen = ntohl(frameLen);
+        if (frameLen > maxFrame) {
+            throw std::runtime_error("Frame exceeds maximum size");
+        }
+        inFrame = true;
+    }
+
+    // Zero length frames are valid, and an empty view is not a failure.
+    if (frameLen > 0) {
+        const auto payload = reader.readExact(frameLen, _errorNB);
+        if (payload.size() != frameLen) {
+            return false;
+        }
+        _payload = payload;
+    } else {
+        _payload = StringView();
+    }
+
+    inFrame = false;
+    return true;
+}
+}
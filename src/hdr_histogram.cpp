@@ -0,0 +1,187 @@
+#include "hdr_histogram.hpp"
+#include <stdexcept>
+
+
+namespace net {
+
+namespace {
+
+const char magic = 'H';
+
+void putVarint(std::string &_out, std::uint64_t _v)
+{
+    while (_v >= 0x80) {
+        _out.push_back(static_cast<char>((_v & 0x7f) | 0x80));
+        _v >>= 7;
+    }
+    _out.push_back(static_cast<char>(_v));
+}
+
+std::uint64_t getVarint(StringView _data, std::size_t &_pos)
+{
+    std::uint64_t v = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        if (_pos == _data.size()) {
+            break;
+        }
+
+        const auto byte = static_cast<unsigned char>(_data[_pos++]);
+        v |= std::uint64_t(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return v;
+        }
+    }
+
+    throw std::invalid_argument("Histogram encoding truncated");
+}
+}
+
+
+HdrHistogram::HdrHistogram(const unsigned _subBits, const unsigned _maxBits)
+    : subBits(_subBits), maxBits(_maxBits), total(0), max(0)
+{
+    if (_subBits > 16 || _subBits >= _maxBits || _maxBits > 64) {
+        throw std::invalid_argument("Histogram layout invalid");
+    }
+
+    limit = (_maxBits == 64) ? UINT64_MAX
+                             : (std::uint64_t(1) << _maxBits) - 1;
+    buckets = std::size_t(_maxBits - _subBits + 1) << _subBits;
+    counts.reset(new std::atomic<std::uint64_t>[buckets]);
+    reset();
+}
+
+
+HdrHistogram::HdrHistogram(const HdrHistogram &_other)
+    : HdrHistogram(_other.subBits, _other.maxBits)
+{
+    merge(_other);
+}
+
+
+std::uint64_t HdrHistogram::highest(const std::size_t _i) const noexcept
+{
+    if (_i < (std::size_t(1) << subBits)) {
+        return _i;
+    }
+
+    // Wraps to UINT64_MAX for the last bucket of a 64 bit layout.
+    const auto shift = (_i >> subBits) - 1;
+    const auto sub
+      = (_i & ((std::size_t(1) << subBits) - 1)) + (std::size_t(1) << subBits);
+    return (std::uint64_t(sub + 1) << shift) - 1;
+}
+
+
+std::uint64_t HdrHistogram::percentile(const double _p) const noexcept
+{
+    const auto n    = count();
+    const auto peak = maximum();
+    if (n == 0) {
+        return 0;
+    }
+
+    const auto rank    = static_cast<std::uint64_t>(_p / 100 * n);
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < buckets; ++i) {
+        seen += counts[i].load(std::memory_order_relaxed);
+        if (seen > rank) {
+            return (highest(i) < peak) ? highest(i) : peak;
+        }
+    }
+
+    return peak;
+}
+
+
+void HdrHistogram::merge(const HdrHistogram &_other)
+{
+    if (_other.subBits != subBits || _other.maxBits != maxBits) {
+        throw std::invalid_argument("Histogram layouts differ");
+    }
+
+    // total is summed from the counters taken rather than read from _other,
+    // so it matches them even while _other is recording.
+    std::uint64_t added = 0;
+    for (std::size_t i = 0; i < buckets; ++i) {
+        const auto c = _other.counts[i].load(std::memory_order_relaxed);
+        if (c != 0) {
+            add(counts[i], c);
+            added += c;
+        }
+    }
+    add(total, added);
+
+    const auto otherMax = _other.maximum();
+    if (otherMax > maximum()) {
+        max.store(otherMax, std::memory_order_relaxed);
+    }
+}
+
+
+void HdrHistogram::reset() noexcept
+{
+    for (std::size_t i = 0; i < buckets; ++i) {
+        counts[i].store(0, std::memory_order_relaxed);
+    }
+    total.store(0, std::memory_order_relaxed);
+    max.store(0, std::memory_order_relaxed);
+}
+
+
+std::string HdrHistogram::serialize() const
+{
+    std::string out(1, magic);
+    putVarint(out, subBits);
+    putVarint(out, maxBits);
+    putVarint(out, maximum());
+
+    std::uint64_t zeros = 0;
+    for (std::size_t i = 0; i < buckets; ++i) {
+        const auto c = counts[i].load(std::memory_order_relaxed);
+        if (c == 0) {
+            ++zeros;
+            continue;
+        }
+
+        putVarint(out, zeros);
+        putVarint(out, c);
+        zeros = 0;
+    }
+
+    return out;
+}
+
+
+HdrHistogram HdrHistogram::deserialize(StringView _data)
+{
+    if (_data.size() == 0 || _data[0] != magic) {
+        throw std::invalid_argument("Not a histogram encoding");
+    }
+
+    std::size_t pos     = 1;
+    const auto sub      = getVarint(_data, pos);
+    const auto bits     = getVarint(_data, pos);
+    const auto savedMax = getVarint(_data, pos);
+    if (sub > 16 || bits > 64) {
+        throw std::invalid_argument("Histogram layout invalid");
+    }
+
+    HdrHistogram h(static_cast<unsigned>(sub), static_cast<unsigned>(bits));
+    std::size_t i = 0;
+    while (pos < _data.size()) {
+        const auto zeros = getVarint(_data, pos);
+        const auto c     = getVarint(_data, pos);
+        if (zeros >= h.buckets - i) {
+            throw std::invalid_argument("Histogram encoding too long");
+        }
+
+        i += zeros;
+        add(h.counts[i++], c);
+        add(h.total, c);
+    }
+
+    h.max.store(savedMax, std::memory_order_relaxed);
+    return h;
+}
+}
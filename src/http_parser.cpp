@@ -0,0 +1,304 @@
+#include "http_parser.hpp"
+#include <cstring>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define NET_HTTP_SIMD
+#include <immintrin.h>
+#endif
+
+
+namespace net {
+
+namespace {
+
+    using Finder = const char *(*) (const char *, const char *, char);
+
+    // tchar of RFC 7230, the characters of methods and header names.
+    struct TokenTable {
+        bool chars[256] = {};
+
+        constexpr TokenTable()
+        {
+            for (auto c = '0'; c <= '9'; ++c) {
+                chars[static_cast<unsigned char>(c)] = true;
+            }
+            for (auto c = 'a'; c <= 'z'; ++c) {
+                chars[static_cast<unsigned char>(c)] = true;
+                chars[static_cast<unsigned char>(c - 'a' + 'A')] = true;
+            }
+            for (auto c : "!#$%&'*+-.^_`|~") {
+                chars[static_cast<unsigned char>(c)] = (c != '\0');
+            }
+        }
+
+        bool operator[](const char _c) const noexcept
+        {
+            return chars[static_cast<unsigned char>(_c)];
+        }
+    };
+
+    constexpr TokenTable token;
+
+
+    // Whether _c ends a field value or target: a control character other
+    // than HTAB, DEL, or _extra.
+    inline bool isSpecial(const char _c, const char _extra) noexcept
+    {
+        const auto c = static_cast<unsigned char>(_c);
+        return (c < 0x20 && c != '\t') || c == 0x7f || _c == _extra;
+    }
+
+    const char *findScalar(const char *_p, const char *_end,
+                           const char _extra) noexcept
+    {
+        while (_p != _end && !isSpecial(*_p, _extra)) {
+            ++_p;
+        }
+        return _p;
+    }
+
+#ifdef NET_HTTP_SIMD
+    __attribute__((target("sse4.2"))) const char *
+    findSse42(const char *_p, const char *_end, const char _extra) noexcept
+    {
+        // Inclusive ranges of special bytes, compared 16 at a time.
+        const char ranges[16] = {'\x00', '\x08', '\x0a', '\x1f',
+                                 '\x7f', '\x7f', _extra, _extra};
+        const auto r
+          = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ranges));
+
+        while (_end - _p >= 16) {
+            const auto b
+              = _mm_loadu_si128(reinterpret_cast<const __m128i *>(_p));
+            const auto i = _mm_cmpestri(r, 8, b, 16,
+                                        _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES
+                                          | _SIDD_LEAST_SIGNIFICANT);
+            if (i != 16) {
+                return _p + i;
+            }
+            _p += 16;
+        }
+
+        return findScalar(_p, _end, _extra);
+    }
+
+    __attribute__((target("avx2"))) const char *
+    findAvx2(const char *_p, const char *_end, const char _extra) noexcept
+    {
+        const auto maxCtl = _mm256_set1_epi8(0x1f);
+        const auto tab    = _mm256_set1_epi8('\t');
+        const auto del    = _mm256_set1_epi8(0x7f);
+        const auto extra  = _mm256_set1_epi8(_extra);
+
+        while (_end - _p >= 32) {
+            const auto b
+              = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(_p));
+
+            // Unsigned b <= 0x1f is min(b, 0x1f) == b.
+            const auto ctl
+              = _mm256_andnot_si256(_mm256_cmpeq_epi8(b, tab),
+                                    _mm256_cmpeq_epi8(
+                                      _mm256_min_epu8(b, maxCtl), b));
+            const auto hit = _mm256_or_si256(
+              ctl, _mm256_or_si256(_mm256_cmpeq_epi8(b, del),
+                                   _mm256_cmpeq_epi8(b, extra)));
+
+            const auto mask
+              = static_cast<unsigned>(_mm256_movemask_epi8(hit));
+            if (mask != 0) {
+                return _p + __builtin_ctz(mask);
+            }
+            _p += 32;
+        }
+
+        return findScalar(_p, _end, _extra);
+    }
+#endif
+
+    Finder pickFinder() noexcept
+    {
+#ifdef NET_HTTP_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return findAvx2;
+        }
+        if (__builtin_cpu_supports("sse4.2")) {
+            return findSse42;
+        }
+#endif
+        return findScalar;
+    }
+
+    // Picked once for the CPU running the program.
+    const Finder findSpecial = pickFinder();
+
+
+    inline char lower(const char _c) noexcept
+    {
+        return (_c >= 'A' && _c <= 'Z') ? _c - 'A' + 'a' : _c;
+    }
+
+    bool equalsLower(StringView _str, StringView _lower) noexcept
+    {
+        if (_str.size() != _lower.size()) {
+            return false;
+        }
+        for (std::size_t i = 0; i < _str.size(); ++i) {
+            if (lower(_str[i]) != _lower[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Content-Length is 1*DIGIT; longer numbers than fit are rejected.
+    bool parseLength(StringView _value, std::size_t &_len) noexcept
+    {
+        if (_value.size() == 0 || _value.size() > 18) {
+            return false;
+        }
+
+        _len = 0;
+        for (std::size_t i = 0; i < _value.size(); ++i) {
+            if (_value[i] < '0' || _value[i] > '9') {
+                return false;
+            }
+            _len = _len * 10 + (_value[i] - '0');
+        }
+        return true;
+    }
+}
+
+
+StringView HttpRequest::header(StringView _name) const noexcept
+{
+    for (const auto &f : *this) {
+        if (f.name.size() == _name.size()) {
+            auto same = true;
+            for (std::size_t i = 0; same && i < _name.size(); ++i) {
+                same = lower(f.name[i]) == lower(_name[i]);
+            }
+            if (same) {
+                return f.value;
+            }
+        }
+    }
+
+    return StringView();
+}
+
+
+bool HttpRequest::keepAlive() const noexcept
+{
+    const auto conn = header("connection");
+    return (minor == 1) ? !equalsLower(conn, "close")
+                        : equalsLower(conn, "keep-alive");
+}
+
+
+HttpStatus HttpParser::parse(StringView _buf, HttpRequest &_req) noexcept
+{
+    // Only the bytes new since the last call can complete the empty line
+    // ending the head, together with the three before them.
+    const auto from
+      = (scanned > 3 && scanned <= _buf.size()) ? scanned - 3 : 0;
+    const auto found = static_cast<const char *>(
+      memmem(_buf.data() + from, _buf.size() - from, "\r\n\r\n", 4));
+
+    if (found == nullptr) {
+        scanned = _buf.size();
+        return HttpStatus::PARTIAL;
+    }
+    scanned = 0;
+
+    // The head ends with CRLF CRLF, so every scan below stops before end.
+    auto p         = _buf.data();
+    const auto end = found + 4;
+
+    const auto method = p;
+    while (token[*p]) {
+        ++p;
+    }
+    if (p == method || *p != ' ') {
+        return HttpStatus::INVALID;
+    }
+    _req.methodView = StringView(method, p - method);
+
+    const auto target = ++p;
+    p                 = findSpecial(p, end, ' ');
+    if (p == target || *p != ' ') {
+        return HttpStatus::INVALID;
+    }
+    _req.targetView = StringView(target, p - target);
+
+    ++p;
+    if (end - p < 10 || std::memcmp(p, "HTTP/1.", 7) != 0
+        || (p[7] != '0' && p[7] != '1') || p[8] != '\r' || p[9] != '\n') {
+        return HttpStatus::INVALID;
+    }
+    _req.minor = p[7] - '0';
+    p += 10;
+
+    _req.count       = 0;
+    _req.bodyLen     = 0;
+    auto hasLen      = false;
+    auto hasEncoding = false;
+
+    while (*p != '\r') {
+        if (_req.count == HttpRequest::maxHeaders) {
+            return HttpStatus::INVALID;
+        }
+
+        // Also rejects obsolete line folding, which starts with whitespace.
+        const auto name = p;
+        while (token[*p]) {
+            ++p;
+        }
+        const auto nameEnd = p;
+        if (p == name || *p != ':') {
+            return HttpStatus::INVALID;
+        }
+
+        ++p;
+        while (*p == ' ' || *p == '\t') {
+            ++p;
+        }
+
+        const auto value = p;
+        p                = findSpecial(p, end, '\r');
+        if (*p != '\r' || p[1] != '\n') {
+            return HttpStatus::INVALID;
+        }
+
+        auto valueEnd = p;
+        while (valueEnd != value
+               && (valueEnd[-1] == ' ' || valueEnd[-1] == '\t')) {
+            --valueEnd;
+        }
+        p += 2;
+
+        auto &field = _req.fields[_req.count++];
+        field.name  = StringView(name, nameEnd - name);
+        field.value = StringView(value, valueEnd - value);
+
+        if (equalsLower(field.name, "content-length")) {
+            std::size_t len = 0;
+            if (!parseLength(field.value, len)
+                || (hasLen && len != _req.bodyLen)) {
+                return HttpStatus::INVALID;
+            }
+            _req.bodyLen = len;
+            hasLen       = true;
+        } else if (equalsLower(field.name, "transfer-encoding")) {
+            hasEncoding = true;
+        }
+    }
+
+    if (hasEncoding) {
+        return hasLen ? HttpStatus::INVALID : HttpStatus::UNSUPPORTED;
+    }
+
+    _req.headLen = end - _buf.data();
+    return HttpStatus::COMPLETE;
+}
+}
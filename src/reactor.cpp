@@ -0,0 +1,170 @@
+#include "reactor.hpp"
+
+extern "C" {
+#include <sys/eventfd.h>
+}
+
+
+namespace net {
+
+Reactor::Reactor(const std::size_t _maxEvents)
+    : stopped(false), events(_maxEvents)
+{
+    epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (epfd < 0) {
+        const auto currErrno = errno;
+        throw std::runtime_error(net::methods::getErrorMsg(currErrno));
+    }
+
+    wakefd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakefd < 0) {
+        const auto currErrno = errno;
+        ::close(epfd);
+        throw std::runtime_error(net::methods::getErrorMsg(currErrno));
+    }
+
+    epoll_event ev{};
+    ev.events  = EPOLLIN;
+    ev.data.fd = wakefd;
+    if (epoll_ctl(epfd, EPOLL_CTL_ADD, wakefd, &ev) < 0) {
+        const auto currErrno = errno;
+        ::close(wakefd);
+        ::close(epfd);
+        throw std::runtime_error(net::methods::getErrorMsg(currErrno));
+    }
+}
+
+
+Reactor::~Reactor() noexcept
+{
+    ::close(wakefd);
+    ::close(epfd);
+}
+
+
+void Reactor::add(const int _fd, Event _events, Callback _fn)
+{
+    if (_fd < 0 || !_fn) {
+        throw std::invalid_argument("Invalid descriptor or callback");
+    }
+
+    const auto index = static_cast<std::size_t>(_fd);
+    if (index >= handlers.size()) {
+        generations.resize(index + 1, 0);
+        handlers.resize(index + 1);
+    }
+    auto handler          = std::make_unique<Callback>(std::move(_fn));
+    const auto generation = generations[index] + 1;
+
+    epoll_event ev{};
+    ev.events   = static_cast<std::uint32_t>(_events);
+    ev.data.u64 = (static_cast<std::uint64_t>(generation) << 32)
+      | static_cast<std::uint32_t>(_fd);
+    if (epoll_ctl(epfd, EPOLL_CTL_ADD, _fd, &ev) < 0) {
+        const auto currErrno = errno;
+        throw std::runtime_error(net::methods::getErrorMsg(currErrno));
+    }
+
+    generations[index] = generation;
+    handlers[index]    = std::move(handler);
+    ++registered;
+}
+
+
+void Reactor::modify(const int _fd, Event _events)
+{
+    epoll_event ev{};
+    ev.events   = static_cast<std::uint32_t>(_events);
+    ev.data.u64 = token(_fd);
+    if (epoll_ctl(epfd, EPOLL_CTL_MOD, _fd, &ev) < 0) {
+        const auto currErrno = errno;
+        throw std::runtime_error(net::methods::getErrorMsg(currErrno));
+    }
+}
+
+
+void Reactor::remove(const int _fd)
+{
+    if (epoll_ctl(epfd, EPOLL_CTL_DEL, _fd, nullptr) < 0) {
+        const auto currErrno = errno;
+        throw std::runtime_error(net::methods::getErrorMsg(currErrno));
+    }
+
+    auto &handler = handlers[static_cast<std::size_t>(_fd)];
+    if (dispatching) {
+        // The callback may be the one running; free it after dispatch.
+        retired.push_back(std::move(handler));
+    }
+    handler.reset();
+    --registered;
+}
+
+
+std::size_t Reactor::poll(const int _timeout)
+{
+    const auto ready
+      = epoll_wait(epfd, events.data(), static_cast<int>(events.size()),
+                   _timeout);
+    if (ready < 0) {
+        const auto currErrno = errno;
+        if (currErrno == EINTR) {
+            return 0;
+        }
+        throw std::runtime_error(net::methods::getErrorMsg(currErrno));
+    }
+
+    std::size_t invoked = 0;
+    dispatching         = true;
+
+    for (auto i = 0; i < ready; ++i) {
+        const auto data = events[i].data.u64;
+        const auto fd   = static_cast<int>(static_cast<std::uint32_t>(data));
+        if (fd == wakefd) {
+            std::uint64_t count;
+            while (::read(wakefd, &count, sizeof(count)) > 0) {
+            }
+            continue;
+        }
+
+        // A callback earlier in this batch may have removed fd, and maybe
+        // added a new descriptor under the same number.
+        const auto index = static_cast<std::size_t>(fd);
+        if (index >= handlers.size() || !handlers[index]
+            || data != token(fd)) {
+            continue;
+        }
+
+        try {
+            (*handlers[index])(static_cast<Event>(events[i].events));
+        } catch (...) {
+            dispatching = false;
+            retired.clear();
+            throw;
+        }
+        ++invoked;
+    }
+
+    dispatching = false;
+    retired.clear();
+    return invoked;
+}
+
+
+void Reactor::run()
+{
+    while (!stopped) {
+        poll();
+    }
+    stopped = false;
+}
+
+
+void Reactor::stop() noexcept
+{
+    stopped = true;
+
+    const std::uint64_t one = 1;
+    const auto res          = ::write(wakefd, &one, sizeof(one));
+    static_cast<void>(res);
+}
+}
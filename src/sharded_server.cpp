@@ -0,0 +1,113 @@
+#include "sharded_server.hpp"
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+extern "C" {
+#include <pthread.h>
+#include <sched.h>
+}
+
+
+namespace net {
+
+namespace {
+
+    // Cores this process may run on, in order.
+    std::vector<int> usableCores()
+    {
+        std::vector<int> cores;
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+            for (auto cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                if (CPU_ISSET(cpu, &set)) {
+                    cores.push_back(cpu);
+                }
+            }
+        }
+
+        return cores;
+    }
+}
+
+
+ShardedServer::ShardedServer(Domain _domain, const char _addr[],
+                             const int _port, std::size_t _shards,
+                             const bool _pin)
+    : pin(_pin)
+{
+    if (_domain != Domain::IPv4 && _domain != Domain::IPv6) {
+        throw std::invalid_argument("Socket type not supported");
+    }
+
+    if (_shards == 0) {
+        _shards = std::max<std::size_t>(usableCores().size(), 1);
+    }
+
+    listeners.reserve(_shards);
+    reactors.reserve(_shards);
+
+    for (std::size_t i = 0; i < _shards; ++i) {
+        listeners.emplace_back(_domain, Type::TCP);
+        auto &s = listeners.back();
+        s.setOpt(Opt::REUSEADDR, SockOpt(1));
+        s.setOpt(Opt::REUSEPORT, SockOpt(1));
+        s.start(_addr, _port);
+        s.setNonBlocking();
+
+        reactors.push_back(std::make_unique<Reactor>());
+    }
+}
+
+
+void ShardedServer::run(Setup _setup)
+{
+    const auto cores = usableCores();
+
+    std::mutex m;
+    std::exception_ptr error;
+    std::vector<std::thread> workers;
+    workers.reserve(listeners.size());
+
+    for (std::size_t i = 0; i < listeners.size(); ++i) {
+        workers.emplace_back([&, i] {
+            try {
+                if (pin && !cores.empty()) {
+                    cpu_set_t set;
+                    CPU_ZERO(&set);
+                    CPU_SET(cores[i % cores.size()], &set);
+                    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+                }
+
+                _setup(*reactors[i], listeners[i], i);
+                reactors[i]->run();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(m);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                stop();
+            }
+        });
+    }
+
+    for (auto &w : workers) {
+        w.join();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+
+void ShardedServer::stop() noexcept
+{
+    for (auto &r : reactors) {
+        r->stop();
+    }
+}
+}
@@ -1,4 +1,11 @@
 #include "socket.hpp"
+#include <algorithm>
+
+extern "C" {
+#include <sys/sendfile.h>
+#include <fcntl.h>
+#include <linux/errqueue.h>
+}
 
 
 namespace net {
@@ -37,7 +44,9 @@ Socket::Socket(const int _sockfd, Domain _domain, Type _type, const void *_addr)
     }
 
     sock_type = _type;
-    std::memcpy(ptr, _addr, size);
+    if (_addr != nullptr) {
+        std::memcpy(ptr, _addr, size);
+    }
 }
 
 
@@ -114,6 +123,55 @@ void Socket::connect(const char _addr[], const int _port, bool *_errorNB)
 }
 
 
+IoResult Socket::tryConnect(const char _addr[], const int _port) const noexcept
+{
+    union {
+        AddrIPv4 ipv4;
+        AddrIPv6 ipv6;
+        AddrUnix unix;
+    } addr;
+
+    auto res       = 0;
+    socklen_t size = 0;
+
+    switch (sock_domain) {
+        case Domain::IPv4:
+            res  = net::methods::construct(addr.ipv4, _addr, _port);
+            size = sizeof(addr.ipv4);
+            break;
+
+        case Domain::IPv6:
+            res  = net::methods::construct(addr.ipv6, _addr, _port);
+            size = sizeof(addr.ipv6);
+            break;
+
+        case Domain::UNIX:
+            res  = net::methods::construct(addr.unix, _addr);
+            size = sizeof(addr.unix);
+            break;
+
+        default: return IoResult::fromErrno(EAFNOSUPPORT);
+    }
+
+    if (res == 0) {
+        return IoResult::fromErrno(EINVAL);
+    }
+    if (res == -1) {
+        return IoResult::fromErrno(errno);
+    }
+
+    StatsProbe probe(StatOp::CONNECT, attachedStats());
+    res = ::connect(sockfd, (sockaddr *) &addr, size);
+    probe.done(res);
+
+    if (res == -1) {
+        return IoResult::fromErrno(errno);
+    }
+
+    return IoResult();
+}
+
+
 Socket Socket::accept(bool *_errorNB) const
 {
     union {
@@ -157,7 +215,10 @@ Socket Socket::accept(bool *_errorNB) const
             break;
     }
 
-    const auto client    = ::accept(sockfd, addrPtr, &addrSize);
+    StatsProbe probe(StatOp::ACCEPT, attachedStats());
+    const auto client = ::accept(sockfd, addrPtr, &addrSize);
+    probe.done(client);
+
     const auto currErrno = errno;
 
     if (client == -1) {
@@ -176,9 +237,41 @@ Socket Socket::accept(bool *_errorNB) const
 }
 
 
-void Socket::write(const std::string &_msg, bool *_errorNB) const
+Socket Socket::tryAccept(IoResult &_res) const noexcept
 {
-    const auto written = low_write(::write, _msg);
+    AddrStore addr;
+    socklen_t len = sizeof(addr);
+
+    int client;
+    do {
+        StatsProbe probe(StatOp::ACCEPT, attachedStats());
+        client = ::accept(sockfd, reinterpret_cast<sockaddr *>(&addr), &len);
+        probe.done(client);
+    } while (client == -1 && errno == EINTR);
+
+    if (client == -1) {
+        _res = IoResult::fromErrno(errno);
+
+        Socket closed(-1, sock_domain, sock_type, nullptr);
+        closed.isClosed = true;
+        return closed;
+    }
+
+    _res = IoResult();
+    return Socket(client, sock_domain, sock_type, &addr);
+}
+
+
+void Socket::write(StringView _msg, bool *_errorNB) const
+{
+    write(_msg.data(), _msg.size(), _errorNB);
+}
+
+
+void Socket::write(const char *_msg, const std::size_t _len,
+                   bool *_errorNB) const
+{
+    const auto written = low_write(::write, _msg, _len);
 
     const auto currErrno = errno;
     if (written == -1) {
@@ -195,10 +288,17 @@ void Socket::write(const std::string &_msg, bool *_errorNB) const
 }
 
 
-void Socket::send(const std::string &_msg, Send _flags, bool *_errorNB) const
+void Socket::send(StringView _msg, Send _flags, bool *_errorNB) const
+{
+    send(_msg.data(), _msg.size(), _flags, _errorNB);
+}
+
+
+void Socket::send(const char *_msg, const std::size_t _len, Send _flags,
+                  bool *_errorNB) const
 {
     const auto flags = static_cast<int>(_flags);
-    const auto sent  = low_write(::send, _msg, flags);
+    const auto sent  = low_write(::send, _msg, _len, flags);
 
     const auto currErrno = errno;
     if (sent == -1) {
@@ -215,12 +315,36 @@ void Socket::send(const std::string &_msg, Send _flags, bool *_errorNB) const
 }
 
 
+IoResult Socket::trySend(const char *_msg, const std::size_t _len,
+                         Send _flags) const noexcept
+{
+    ssize_t sent;
+    do {
+        StatsProbe probe(StatOp::WRITE, attachedStats());
+        sent = ::send(sockfd, _msg, _len, static_cast<int>(_flags));
+        probe.done(sent, sent > 0 && static_cast<std::size_t>(sent) < _len);
+    } while (sent == -1 && errno == EINTR);
+
+    return (sent == -1) ? IoResult::fromErrno(errno) : IoResult(sent);
+}
+
+
 std::string Socket::read(const int _numBytes, bool *_errorNB) const
 {
     std::string str;
     str.reserve(_numBytes);
+    str.resize(str.capacity());
+
+    const auto recvd = read(&str[0], str.size(), _errorNB);
+
+    str.resize((recvd > 0) ? recvd : 0);
+    return str;
+}
 
-    const auto recvd = low_read(::read, str);
+
+ssize_t Socket::read(char *_buf, const std::size_t _len, bool *_errorNB) const
+{
+    const auto recvd = low_read(::read, _buf, _len);
 
     const auto currErrno = errno;
     if (recvd == -1) {
@@ -235,7 +359,28 @@ std::string Socket::read(const int _numBytes, bool *_errorNB) const
         }
     }
 
-    return str;
+    return recvd;
+}
+
+
+BufferPool::Buffer Socket::read(BufferPool &_pool, const std::size_t _len,
+                                bool *_errorNB) const
+{
+    auto buf         = _pool.acquire(_len);
+    const auto recvd = read(buf.data(), _len, _errorNB);
+
+    buf.resize((recvd > 0) ? recvd : 0);
+    return buf;
+}
+
+
+ssize_t Socket::read(std::string &_str, const int _numBytes,
+                     bool *_errorNB) const
+{
+    _str.resize(_numBytes);
+    const auto recvd = read(&_str[0], _str.size(), _errorNB);
+    _str.resize((recvd > 0) ? recvd : 0);
+    return recvd;
 }
 
 
@@ -243,9 +388,20 @@ std::string Socket::recv(const int _numBytes, Recv _flags, bool *_errorNB) const
 {
     std::string str;
     str.reserve(_numBytes);
+    str.resize(str.capacity());
+
+    const auto recvd = recv(&str[0], str.size(), _flags, _errorNB);
 
+    str.resize((recvd > 0) ? recvd : 0);
+    return str;
+}
+
+
+ssize_t Socket::recv(char *_buf, const std::size_t _len, Recv _flags,
+                     bool *_errorNB) const
+{
     const auto flags = static_cast<int>(_flags);
-    const auto recvd = low_read(::recv, str, flags);
+    const auto recvd = low_read(::recv, _buf, _len, flags);
 
     const auto currErrno = errno;
     if (recvd == -1) {
@@ -260,7 +416,336 @@ std::string Socket::recv(const int _numBytes, Recv _flags, bool *_errorNB) const
         }
     }
 
-    return str;
+    return recvd;
+}
+
+
+BufferPool::Buffer Socket::recv(BufferPool &_pool, const std::size_t _len,
+                                Recv _flags, bool *_errorNB) const
+{
+    auto buf         = _pool.acquire(_len);
+    const auto recvd = recv(buf.data(), _len, _flags, _errorNB);
+
+    buf.resize((recvd > 0) ? recvd : 0);
+    return buf;
+}
+
+
+IoResult Socket::tryRecv(char *_buf, const std::size_t _len,
+                         Recv _flags) const noexcept
+{
+    ssize_t recvd;
+    do {
+        StatsProbe probe(StatOp::READ, attachedStats());
+        recvd = ::recv(sockfd, _buf, _len, static_cast<int>(_flags));
+        probe.done(recvd);
+    } while (recvd == -1 && errno == EINTR);
+
+    return (recvd == -1) ? IoResult::fromErrno(errno) : IoResult(recvd);
+}
+
+
+ssize_t Socket::recv(std::string &_str, const int _numBytes, Recv _flags,
+                     bool *_errorNB) const
+{
+    _str.resize(_numBytes);
+    const auto recvd = recv(&_str[0], _str.size(), _flags, _errorNB);
+    _str.resize((recvd > 0) ? recvd : 0);
+    return recvd;
+}
+
+
+std::size_t Socket::writev(const StringView *_bufs, const std::size_t _count,
+                           bool *_errorNB) const
+{
+    std::size_t total  = 0;
+    const auto written = low_writev(::writev, _bufs, _count, total);
+
+    const auto currErrno = errno;
+    if (written == -1) {
+        if (currErrno == EAGAIN || currErrno == EWOULDBLOCK) {
+            if (_errorNB != nullptr) {
+                *_errorNB = true;
+            } else {
+                throw std::invalid_argument("errorNB argument missing");
+            }
+        } else {
+            throw std::runtime_error(net::methods::getErrorMsg(currErrno));
+        }
+    }
+
+    return total;
+}
+
+
+std::size_t Socket::sendmsg(const StringView *_bufs, const std::size_t _count,
+                            Send _flags, bool *_errorNB) const
+{
+    const auto flags  = static_cast<int>(_flags);
+    std::size_t total = 0;
+    const auto sent   = low_writev(
+      [flags](const int _sockfd, iovec *_iov, const int _iovcnt) {
+          msghdr msg;
+          std::memset(&msg, 0, sizeof(msg));
+          msg.msg_iov    = _iov;
+          msg.msg_iovlen = _iovcnt;
+          return ::sendmsg(_sockfd, &msg, flags);
+      },
+      _bufs, _count, total);
+
+    const auto currErrno = errno;
+    if (sent == -1) {
+        if (currErrno == EAGAIN || currErrno == EWOULDBLOCK) {
+            if (_errorNB != nullptr) {
+                *_errorNB = true;
+            } else {
+                throw std::invalid_argument("errorNB argument missing");
+            }
+        } else {
+            throw std::runtime_error(net::methods::getErrorMsg(currErrno));
+        }
+    }
+
+    return total;
+}
+
+
+ssize_t Socket::readv(const iovec *_bufs, const std::size_t _count,
+                      bool *_errorNB) const
+{
+    StatsProbe probe(StatOp::READ, attachedStats());
+    const auto recvd = ::readv(sockfd, _bufs, static_cast<int>(_count));
+    probe.done(recvd);
+
+    const auto currErrno = errno;
+    if (recvd == -1) {
+        if (currErrno == EAGAIN || currErrno == EWOULDBLOCK) {
+            if (_errorNB != nullptr) {
+                *_errorNB = true;
+            } else {
+                throw std::invalid_argument("errorNB argument missing");
+            }
+        } else {
+            throw std::runtime_error(net::methods::getErrorMsg(currErrno));
+        }
+    }
+
+    return recvd;
+}
+
+
+ssize_t Socket::recvmsg(const iovec *_bufs, const std::size_t _count,
+                        Recv _flags, bool *_errorNB) const
+{
+    msghdr msg;
+    std::memset(&msg, 0, sizeof(msg));
+    msg.msg_iov    = const_cast<iovec *>(_bufs);
+    msg.msg_iovlen = _count;
+
+    const auto flags = static_cast<int>(_flags);
+    StatsProbe probe(StatOp::READ, attachedStats());
+    const auto recvd = ::recvmsg(sockfd, &msg, flags);
+    probe.done(recvd);
+
+    const auto currErrno = errno;
+    if (recvd == -1) {
+        if (currErrno == EAGAIN || currErrno == EWOULDBLOCK) {
+            if (_errorNB != nullptr) {
+                *_errorNB = true;
+            } else {
+                throw std::invalid_argument("errorNB argument missing");
+            }
+        } else {
+            throw std::runtime_error(net::methods::getErrorMsg(currErrno));
+        }
+    }
+
+    return recvd;
+}
+
+
+std::size_t Socket::sendFile(const int _fd, off_t _offset,
+                             const std::size_t _count, bool *_errorNB) const
+{
+    std::size_t sent = 0;
+    ssize_t res      = 0;
+
+    while (sent < _count) {
+        StatsProbe probe(StatOp::WRITE, attachedStats());
+        res = ::sendfile(sockfd, _fd, &_offset, _count - sent);
+        probe.done(res, res > 0 && sent + res < _count);
+        if (res <= 0) {
+            break;
+        }
+        sent += res;
+    }
+
+    const auto currErrno = errno;
+    if (res == -1) {
+        if (currErrno == EAGAIN || currErrno == EWOULDBLOCK) {
+            if (_errorNB != nullptr) {
+                *_errorNB = true;
+            } else {
+                throw std::invalid_argument("errorNB argument missing");
+            }
+        } else {
+            throw std::runtime_error(net::methods::getErrorMsg(currErrno));
+        }
+    }
+
+    return sent;
+}
+
+
+std::size_t Socket::splice(Pipe &_pipe, const int _fdOut,
+                           const std::size_t _count, bool *_errorNB) const
+{
+    std::size_t moved = 0;
+    ssize_t res       = 0;
+
+    while (moved < _count) {
+        if (_pipe.used == 0) {
+            const auto want = std::min(_count - moved, _pipe.size);
+
+            // Only the half reading from the Socket is one of its calls.
+            StatsProbe probe(StatOp::READ, attachedStats());
+            res = ::splice(sockfd, nullptr, _pipe.fds[1], nullptr, want,
+                           SPLICE_F_MOVE);
+            probe.done(res);
+            if (res <= 0) {
+                break;
+            }
+            _pipe.used += res;
+        }
+
+        const auto give = std::min(_count - moved, _pipe.used);
+        res = ::splice(_pipe.fds[0], nullptr, _fdOut, nullptr, give,
+                       SPLICE_F_MOVE);
+        if (res <= 0) {
+            break;
+        }
+        _pipe.used -= res;
+        moved += res;
+    }
+
+    const auto currErrno = errno;
+    if (res == -1) {
+        if (currErrno == EAGAIN || currErrno == EWOULDBLOCK) {
+            if (_errorNB != nullptr) {
+                *_errorNB = true;
+            } else {
+                throw std::invalid_argument("errorNB argument missing");
+            }
+        } else {
+            throw std::runtime_error(net::methods::getErrorMsg(currErrno));
+        }
+    }
+
+    return moved;
+}
+
+
+std::uint32_t Socket::sendZeroCopy(ZeroCopy &_zc, StringView _msg, Send _flags,
+                                  bool *_errorNB, std::size_t *_sent) const
+{
+    // Below the threshold the message is copied, and so complete on return.
+    const auto zeroCopy = _msg.size() >= _zc.threshold;
+    const auto flags
+      = static_cast<int>(_flags) | (zeroCopy ? MSG_ZEROCOPY : 0);
+    const auto first = _zc.next;
+    std::size_t sent = 0;
+    ssize_t res      = 0;
+
+    while (sent < _msg.size()) {
+        StatsProbe probe(StatOp::WRITE, attachedStats());
+        res = ::send(sockfd, _msg.data() + sent, _msg.size() - sent, flags);
+        probe.done(res, res > 0 && sent + res < _msg.size());
+        if (res <= 0) {
+            break;
+        }
+        if (zeroCopy) {
+            ++_zc.next;
+        }
+        sent += res;
+    }
+
+    if (_sent != nullptr) {
+        *_sent = sent;
+    }
+
+    const auto currErrno = errno;
+    if (res == -1) {
+        if (currErrno == EAGAIN || currErrno == EWOULDBLOCK
+            || currErrno == ENOBUFS) {
+            if (_errorNB != nullptr) {
+                *_errorNB = true;
+            } else {
+                throw std::invalid_argument("errorNB argument missing");
+            }
+        } else {
+            throw std::runtime_error(net::methods::getErrorMsg(currErrno));
+        }
+    }
+
+    return (_zc.next != first) ? _zc.next - 1 : _zc.completed();
+}
+
+
+std::uint32_t Socket::pollZeroCopy(ZeroCopy &_zc) const
+{
+    const auto before = _zc.done;
+    char control[128];
+
+    while (true) {
+        msghdr msg{};
+        msg.msg_control    = control;
+        msg.msg_controllen = sizeof(control);
+
+        if (::recvmsg(sockfd, &msg, MSG_ERRQUEUE) == -1) {
+            const auto currErrno = errno;
+            if (currErrno == EAGAIN || currErrno == EWOULDBLOCK) {
+                break;
+            }
+            throw std::runtime_error(net::methods::getErrorMsg(currErrno));
+        }
+
+        for (auto cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm)) {
+            if (!(cm->cmsg_level == SOL_IP && cm->cmsg_type == IP_RECVERR)
+                && !(cm->cmsg_level == SOL_IPV6
+                     && cm->cmsg_type == IPV6_RECVERR)) {
+                continue;
+            }
+
+            sock_extended_err err;
+            std::memcpy(&err, CMSG_DATA(cm), sizeof(err));
+            if (err.ee_errno != 0 || err.ee_origin != SO_EE_ORIGIN_ZEROCOPY) {
+                continue;
+            }
+
+            // ee_info..ee_data is the inclusive range of completed sends.
+            if (static_cast<std::int32_t>(err.ee_data + 1 - _zc.done) > 0) {
+                _zc.done = err.ee_data + 1;
+            }
+            _zc.lastCopied = (err.ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0;
+        }
+    }
+
+    return _zc.done - before;
+}
+
+
+void Socket::setNonBlocking(const bool _nonBlocking) const
+{
+    auto flags = fcntl(sockfd, F_GETFL);
+    if (flags != -1) {
+        flags = _nonBlocking ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK);
+        flags = fcntl(sockfd, F_SETFL, flags);
+    }
+
+    const auto currErrno = errno;
+    if (flags == -1) {
+        throw std::runtime_error(net::methods::getErrorMsg(currErrno));
+    }
 }
 
 
@@ -269,7 +754,7 @@ void Socket::setOpt(Opt _opType, SockOpt _opValue) const
     enum type { TIME = 0, LINGER = 1, INT = 2 };
     auto res = -1;
 
-    const auto optname = static_cast<int>(_opType);
+    const auto optname = static_cast<int>(_opType) & 0xffff;
 
     switch (_opType) {
 
@@ -338,7 +823,7 @@ void Socket::setOpt(Opt _opType, SockOpt _opValue) const
 
 SockOpt Socket::getOpt(Opt _opType) const
 {
-    const auto optname = static_cast<int>(_opType);
+    const auto optname = static_cast<int>(_opType) & 0xffff;
 
     switch (_opType) {
 
@@ -0,0 +1,123 @@
+#include "socket_stats.hpp"
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+
+namespace net {
+
+namespace {
+
+std::mutex &registryMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+// Stats of the threads running, summed by SocketStats::total.
+std::vector<const SocketStats *> &threadStats()
+{
+    static std::vector<const SocketStats *> stats;
+    return stats;
+}
+
+// Stats of the threads which exited.
+SocketStats &exitedStats()
+{
+    static SocketStats stats;
+    return stats;
+}
+
+struct ThreadStats {
+    SocketStats stats;
+
+    ThreadStats()
+    {
+        std::lock_guard<std::mutex> lock(registryMutex());
+        threadStats().push_back(&stats);
+    }
+
+    ~ThreadStats()
+    {
+        std::lock_guard<std::mutex> lock(registryMutex());
+        exitedStats().merge(stats);
+
+        auto &all = threadStats();
+        all.erase(std::find(all.begin(), all.end(), &stats));
+    }
+};
+
+thread_local ThreadStats localStats;
+}
+
+
+SocketStats::SocketStats(const SocketStats &_other) { merge(_other); }
+
+
+void SocketStats::record(const StatOp _op, const ssize_t _res,
+                         const int _errno, const bool _partial,
+                         const std::chrono::nanoseconds _took) noexcept
+{
+    auto &s = ops[static_cast<std::size_t>(_op)];
+
+    s.calls.add();
+    s.latency.record(_took.count());
+
+    if (_res == -1) {
+        if (_errno == EAGAIN || _errno == EWOULDBLOCK
+            || (_op == StatOp::CONNECT && _errno == EINPROGRESS)) {
+            s.wouldBlock.add();
+        } else {
+            s.errors.add();
+        }
+    } else if (_op == StatOp::READ || _op == StatOp::WRITE) {
+        s.bytes.add(_res);
+    }
+
+    if (_partial) {
+        s.partial.add();
+    }
+}
+
+
+void SocketStats::merge(const SocketStats &_other) noexcept
+{
+    for (std::size_t i = 0; i < 4; ++i) {
+        ops[i].calls.add(_other.ops[i].calls.get());
+        ops[i].bytes.add(_other.ops[i].bytes.get());
+        ops[i].wouldBlock.add(_other.ops[i].wouldBlock.get());
+        ops[i].partial.add(_other.ops[i].partial.get());
+        ops[i].errors.add(_other.ops[i].errors.get());
+        ops[i].latency.merge(_other.ops[i].latency);
+    }
+}
+
+
+void SocketStats::reset() noexcept
+{
+    for (auto &s : ops) {
+        s.calls.reset();
+        s.bytes.reset();
+        s.wouldBlock.reset();
+        s.partial.reset();
+        s.errors.reset();
+        s.latency.reset();
+    }
+}
+
+
+SocketStats &SocketStats::local() noexcept { return localStats.stats; }
+
+
+SocketStats SocketStats::total()
+{
+    std::lock_guard<std::mutex> lock(registryMutex());
+
+    SocketStats sum(exitedStats());
+    for (const auto s : threadStats()) {
+        sum.merge(*s);
+    }
+
+    return sum;
+}
+}
@@ -0,0 +1,287 @@
+#include "timer_wheel.hpp"
+#include "socket_family.hpp"
+#include <stdexcept>
+
+extern "C" {
+#include <sys/timerfd.h>
+#include <unistd.h>
+}
+
+
+namespace net {
+
+void Timer::cancel() noexcept
+{
+    if (wheel == nullptr) {
+        return;
+    }
+
+    prev->next = next;
+    next->prev = prev;
+    prev       = this;
+    next       = this;
+
+    --wheel->count;
+    wheel = nullptr;
+}
+
+
+TimerWheel::TimerWheel(const std::chrono::nanoseconds _resolution)
+    : resolution(_resolution), start(std::chrono::steady_clock::now())
+{
+    if (resolution.count() <= 0) {
+        throw std::invalid_argument("Resolution must be positive");
+    }
+
+    tfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (tfd < 0) {
+        const auto currErrno = errno;
+        throw std::runtime_error(net::methods::getErrorMsg(currErrno));
+    }
+}
+
+
+TimerWheel::~TimerWheel() noexcept
+{
+    // Timers outliving the wheel are left unscheduled.
+    for (auto &level : buckets) {
+        for (auto &slot : level) {
+            while (slot.next != &slot) {
+                auto &t = static_cast<Timer &>(*slot.next);
+                slot.next = t.next;
+                t.prev    = &t;
+                t.next    = &t;
+                t.wheel   = nullptr;
+            }
+        }
+    }
+
+    ::close(tfd);
+}
+
+
+std::uint64_t TimerWheel::elapsed() const noexcept
+{
+    return static_cast<std::uint64_t>(
+      (std::chrono::steady_clock::now() - start) / resolution);
+}
+
+
+void TimerWheel::insert(Timer &_timer) noexcept
+{
+    const auto delta = _timer.deadline - current;
+
+    std::size_t level = 0;
+    while (level + 1 < levels && (delta >> (levelBits * (level + 1))) != 0) {
+        ++level;
+    }
+
+    auto &slot = buckets[level][(_timer.deadline >> (levelBits * level))
+                                & (slots - 1)];
+    _timer.prev     = slot.prev;
+    _timer.next     = &slot;
+    slot.prev->next = &_timer;
+    slot.prev       = &_timer;
+}
+
+
+std::uint64_t TimerWheel::nextEvent() const noexcept
+{
+    if (count == 0) {
+        return 0;
+    }
+
+    // Per level, the first occupied slot after the current one, which is
+    // when its timers are due on level 0 or cascade down on the others.
+    std::uint64_t next = 0;
+    for (std::size_t level = 0; level < levels; ++level) {
+        const auto shift = levelBits * level;
+
+        for (std::uint64_t i = 1; i <= slots; ++i) {
+            const auto at = ((current >> shift) + i) << shift;
+            if (next != 0 && at >= next) {
+                break;
+            }
+
+            const auto &slot = buckets[level][(at >> shift) & (slots - 1)];
+            if (slot.next != &slot) {
+                next = at;
+                break;
+            }
+        }
+    }
+
+    return next;
+}
+
+
+void TimerWheel::arm(const std::uint64_t _tick)
+{
+    // steady_clock is CLOCK_MONOTONIC, so its epoch is the timerfd's.
+    itimerspec spec{};
+    if (_tick != 0) {
+        const auto at = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          start.time_since_epoch())
+          + resolution * _tick;
+        spec.it_value.tv_sec  = at.count() / 1000000000;
+        spec.it_value.tv_nsec = at.count() % 1000000000;
+    }
+
+    if (timerfd_settime(tfd, TFD_TIMER_ABSTIME, &spec, nullptr) < 0) {
+        const auto currErrno = errno;
+        throw std::runtime_error(net::methods::getErrorMsg(currErrno));
+    }
+    armedTick = _tick;
+}
+
+
+void TimerWheel::scheduleTicks(Timer &_timer, std::uint64_t _ticks)
+{
+    _timer.cancel();
+
+    // An empty wheel has nothing to turn, so it catches up with the clock.
+    if (count == 0) {
+        const auto now = elapsed();
+        if (now > current) {
+            current = now;
+        }
+    }
+
+    if (_ticks == 0) {
+        _ticks = 1;
+    } else if (_ticks > maxDelay) {
+        _ticks = maxDelay;
+    }
+
+    _timer.deadline = current + _ticks;
+    _timer.wheel    = this;
+    insert(_timer);
+    ++count;
+
+    // Only an earlier wakeup is needed; a later one is set by expire. While
+    // expire runs callbacks, armedTick has passed and this never arms.
+    if (armedTick == 0 || _timer.deadline < armedTick) {
+        arm(nextEvent());
+    }
+}
+
+
+std::size_t TimerWheel::tick()
+{
+    ++current;
+
+    // Coarser slots whose range starts now move down to finer levels,
+    // highest level first, since its timers may land in the slot of the
+    // next one due now as well.
+    for (auto level = levels - 1; level > 0; --level) {
+        const auto shift = levelBits * level;
+        if ((current & ((std::uint64_t(1) << shift) - 1)) != 0) {
+            continue;
+        }
+
+        auto &slot = buckets[level][(current >> shift) & (slots - 1)];
+        if (slot.next == &slot) {
+            continue;
+        }
+
+        // Detached first, as timers not due within this level's range yet
+        // go back to the same slot.
+        TimerLink moving;
+        moving.next       = slot.next;
+        moving.prev       = slot.prev;
+        moving.next->prev = &moving;
+        moving.prev->next = &moving;
+        slot.next         = &slot;
+        slot.prev         = &slot;
+
+        while (moving.next != &moving) {
+            auto &t = static_cast<Timer &>(*moving.next);
+            moving.next = t.next;
+            insert(t);
+        }
+    }
+
+    // Timers scheduled by the callbacks are due in a later tick, so never
+    // join this slot while it is drained.
+    auto &slot        = buckets[0][current & (slots - 1)];
+    std::size_t fired = 0;
+
+    while (slot.next != &slot) {
+        auto &t = static_cast<Timer &>(*slot.next);
+        t.cancel();
+        ++fired;
+
+        if (!t.callback) {
+            continue;
+        }
+
+        // Run from outside the timer, which the callback may destroy along
+        // with the connection owning it.
+        auto callback  = std::move(t.callback);
+        auto destroyed = false;
+        t.callback     = nullptr;
+        t.destroyed    = &destroyed;
+
+        auto restore = [&] {
+            if (!destroyed) {
+                t.destroyed = nullptr;
+                if (!t.callback) {
+                    t.callback = std::move(callback);
+                }
+            }
+        };
+
+        try {
+            callback();
+        } catch (...) {
+            restore();
+            throw;
+        }
+        restore();
+    }
+
+    return fired;
+}
+
+
+std::size_t TimerWheel::advance(const std::uint64_t _ticks)
+{
+    const auto target = current + _ticks;
+    std::size_t fired = 0;
+
+    // Empty stretches are skipped; no cascade point with timers is.
+    while (current < target) {
+        const auto next = nextEvent();
+        if (next == 0 || next > target) {
+            current = target;
+            break;
+        }
+
+        current = next - 1;
+        fired += tick();
+    }
+
+    return fired;
+}
+
+
+std::size_t TimerWheel::expire()
+{
+    std::uint64_t expirations;
+    if (::read(tfd, &expirations, sizeof(expirations)) < 0
+        && errno != EAGAIN) {
+        const auto currErrno = errno;
+        throw std::runtime_error(net::methods::getErrorMsg(currErrno));
+    }
+
+    const auto now   = elapsed();
+    const auto fired = (now > current) ? advance(now - current) : 0;
+
+    const auto next = nextEvent();
+    if (next != armedTick) {
+        arm(next);
+    }
+
+    return fired;
+}
+}
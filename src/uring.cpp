@@ -0,0 +1,255 @@
+#include "uring.hpp"
+#include <algorithm>
+#include <cstring>
+
+extern "C" {
+#include <sys/mman.h>
+#include <sys/syscall.h>
+}
+
+
+namespace net {
+
+namespace {
+
+    int setup(const unsigned _entries, io_uring_params &_p) noexcept
+    {
+        return syscall(__NR_io_uring_setup, _entries, &_p);
+    }
+
+    int enter(const int _fd, const unsigned _submit, const unsigned _wait,
+              const unsigned _flags) noexcept
+    {
+        return syscall(__NR_io_uring_enter, _fd, _submit, _wait, _flags,
+                       nullptr, 0);
+    }
+
+    int registerRing(const int _fd, const unsigned _op, void *_arg,
+                     const unsigned _count) noexcept
+    {
+        return syscall(__NR_io_uring_register, _fd, _op, _arg, _count);
+    }
+
+    void *map(const int _fd, const std::size_t _size, const off_t _offset)
+    {
+        auto ptr = mmap(nullptr, _size, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, _fd, _offset);
+        if (ptr == MAP_FAILED) {
+            const auto currErrno = errno;
+            throw std::runtime_error(net::methods::getErrorMsg(currErrno));
+        }
+        return ptr;
+    }
+
+    template <typename T>
+    T *at(void *_base, const std::uint32_t _offset) noexcept
+    {
+        return reinterpret_cast<T *>(static_cast<char *>(_base) + _offset);
+    }
+}
+
+
+Uring::Uring(const unsigned _entries)
+{
+    io_uring_params p;
+    std::memset(&p, 0, sizeof(p));
+
+    ringfd = setup(_entries, p);
+    if (ringfd < 0) {
+        const auto currErrno = errno;
+        throw std::runtime_error(net::methods::getErrorMsg(currErrno));
+    }
+
+    try {
+        sqRingSize = p.sq_off.array + p.sq_entries * sizeof(std::uint32_t);
+        cqRingSize = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+        if (p.features & IORING_FEAT_SINGLE_MMAP) {
+            sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+        }
+
+        sqRing = map(ringfd, sqRingSize, IORING_OFF_SQ_RING);
+        cqRing = (p.features & IORING_FEAT_SINGLE_MMAP)
+          ? sqRing
+          : map(ringfd, cqRingSize, IORING_OFF_CQ_RING);
+
+        sqesSize = p.sq_entries * sizeof(io_uring_sqe);
+        sqes     = static_cast<io_uring_sqe *>(
+          map(ringfd, sqesSize, IORING_OFF_SQES));
+    } catch (...) {
+        release();
+        throw;
+    }
+
+    sqEntries = p.sq_entries;
+    sqMask    = *at<std::uint32_t>(sqRing, p.sq_off.ring_mask);
+    sqHead    = at<std::uint32_t>(sqRing, p.sq_off.head);
+    sqKTail   = at<std::uint32_t>(sqRing, p.sq_off.tail);
+    sqTail = sqSubmitted = *sqKTail;
+
+    // Submission entries are used in order, so the index array is fixed.
+    const auto array = at<std::uint32_t>(sqRing, p.sq_off.array);
+    for (std::uint32_t i = 0; i < sqEntries; ++i) {
+        array[i] = i;
+    }
+
+    cqMask = *at<std::uint32_t>(cqRing, p.cq_off.ring_mask);
+    cqHead = at<std::uint32_t>(cqRing, p.cq_off.head);
+    cqTail = at<std::uint32_t>(cqRing, p.cq_off.tail);
+    cqes   = at<io_uring_cqe>(cqRing, p.cq_off.cqes);
+}
+
+
+Uring::~Uring() noexcept { release(); }
+
+
+void Uring::release() noexcept
+{
+    if (bufRing != nullptr) {
+        munmap(bufRing, bufRingSize);
+    }
+    if (sqes != nullptr) {
+        munmap(sqes, sqesSize);
+    }
+    if (cqRing != nullptr && cqRing != sqRing) {
+        munmap(cqRing, cqRingSize);
+    }
+    if (sqRing != nullptr) {
+        munmap(sqRing, sqRingSize);
+    }
+    ::close(ringfd);
+}
+
+
+io_uring_sqe *Uring::getSqe()
+{
+    if (sqTail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) == sqEntries) {
+        submit();
+        if (sqTail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) == sqEntries) {
+            throw std::runtime_error("Submission queue full");
+        }
+    }
+
+    auto sqe = &sqes[sqTail & sqMask];
+    std::memset(sqe, 0, sizeof(*sqe));
+    ++sqTail;
+    return sqe;
+}
+
+
+void Uring::pushBuffer(const std::uint16_t _id) noexcept
+{
+    auto &buf = bufRing[bufTail & bufMask];
+    buf.addr  = reinterpret_cast<std::uintptr_t>(bufStorage.get()
+                                                + std::size_t(_id) * bufSize);
+    buf.len   = bufSize;
+    buf.bid   = _id;
+
+    // The ring tail overlays the reserved field of the first entry.
+    __atomic_store_n(&bufRing[0].resv, ++bufTail, __ATOMIC_RELEASE);
+}
+
+
+void Uring::provideBuffers(const std::uint16_t _count,
+                           const std::uint32_t _size)
+{
+    if (bufRing != nullptr || _count == 0 || (_count & (_count - 1)) != 0) {
+        throw std::invalid_argument("Invalid buffer count");
+    }
+
+    bufRingSize = _count * sizeof(io_uring_buf);
+    auto ring   = mmap(nullptr, bufRingSize, PROT_READ | PROT_WRITE,
+                     MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    if (ring == MAP_FAILED) {
+        const auto currErrno = errno;
+        throw std::runtime_error(net::methods::getErrorMsg(currErrno));
+    }
+
+    io_uring_buf_reg reg;
+    std::memset(&reg, 0, sizeof(reg));
+    reg.ring_addr    = reinterpret_cast<std::uintptr_t>(ring);
+    reg.ring_entries = _count;
+    reg.bgid         = bufGroup;
+
+    if (registerRing(ringfd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+        const auto currErrno = errno;
+        munmap(ring, bufRingSize);
+        throw std::runtime_error(net::methods::getErrorMsg(currErrno));
+    }
+
+    bufRing    = static_cast<io_uring_buf *>(ring);
+    bufStorage = std::make_unique<char[]>(std::size_t(_count) * _size);
+    bufSize    = _size;
+    bufMask    = _count - 1;
+
+    for (std::uint16_t i = 0; i < _count; ++i) {
+        pushBuffer(i);
+    }
+}
+
+
+void Uring::accept(const Socket &_s, const std::uint64_t _data)
+{
+    auto sqe          = getSqe();
+    sqe->opcode       = IORING_OP_ACCEPT;
+    sqe->fd           = _s.getSocket();
+    sqe->ioprio       = IORING_ACCEPT_MULTISHOT;
+    sqe->accept_flags = SOCK_CLOEXEC;
+    sqe->user_data    = _data;
+}
+
+
+void Uring::recv(const int _fd, const std::uint64_t _data)
+{
+    auto sqe       = getSqe();
+    sqe->opcode    = IORING_OP_RECV;
+    sqe->fd        = _fd;
+    sqe->ioprio    = IORING_RECV_MULTISHOT;
+    sqe->flags     = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = bufGroup;
+    sqe->user_data = _data;
+}
+
+
+void Uring::send(const int _fd, const char *_msg, const std::size_t _len,
+                 const std::uint64_t _data)
+{
+    auto sqe       = getSqe();
+    sqe->opcode    = IORING_OP_SEND;
+    sqe->fd        = _fd;
+    sqe->addr      = reinterpret_cast<std::uintptr_t>(_msg);
+    sqe->len       = _len;
+    sqe->msg_flags = MSG_NOSIGNAL;
+    sqe->user_data = _data;
+}
+
+
+void Uring::close(const int _fd, const std::uint64_t _data)
+{
+    auto sqe       = getSqe();
+    sqe->opcode    = IORING_OP_CLOSE;
+    sqe->fd        = _fd;
+    sqe->user_data = _data;
+}
+
+
+unsigned Uring::submit(const unsigned _waitFor)
+{
+    __atomic_store_n(sqKTail, sqTail, __ATOMIC_RELEASE);
+
+    const auto pending = sqTail - sqSubmitted;
+    const auto flags   = (_waitFor > 0) ? IORING_ENTER_GETEVENTS : 0u;
+
+    auto res = 0;
+    do {
+        res = enter(ringfd, pending, _waitFor, flags);
+    } while (res < 0 && errno == EINTR);
+
+    const auto currErrno = errno;
+    if (res < 0) {
+        throw std::runtime_error(net::methods::getErrorMsg(currErrno));
+    }
+
+    sqSubmitted += res;
+    return res;
+}
+}
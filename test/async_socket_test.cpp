@@ -0,0 +1,152 @@
+#include "async_socket.hpp"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace net;
+
+
+namespace asyncSocketTest {
+
+const std::string msg("asyncSocketTest::msg");
+
+// Echoes until the peer closes, in the straight-line style of a blocking
+// handler.
+Task echo(std::unique_ptr<AsyncSocket> _peer, std::size_t &_served)
+{
+    try {
+        char buf[1024];
+        while (true) {
+            const auto recvd = co_await _peer->asyncRecv(buf, sizeof(buf));
+            if (recvd == 0) {
+                break;
+            }
+            co_await _peer->asyncSend(buf, recvd);
+        }
+        ++_served;
+    } catch (std::exception &e) {
+        ADD_FAILURE() << e.what();
+    }
+}
+
+Task serve(Reactor &_reactor, AsyncSocket &_server, const int _clients,
+           std::size_t &_served)
+{
+    try {
+        for (auto i = 0; i < _clients; ++i) {
+            auto peer = co_await _server.asyncAccept();
+            echo(std::make_unique<AsyncSocket>(_reactor, std::move(peer)),
+                 _served);
+        }
+    } catch (std::exception &e) {
+        ADD_FAILURE() << e.what();
+    }
+}
+
+struct Client {
+    AsyncSocket sock;
+    std::string out;
+    std::string in;
+
+    Client(Reactor &_reactor, const std::size_t _size)
+        : sock(_reactor, Socket(Domain::IPv4, Type::TCP))
+    {
+        while (out.size() < _size) {
+            out += msg;
+        }
+    }
+};
+
+Task receive(Client &_c, Reactor &_reactor, int &_done)
+{
+    try {
+        char buf[4096];
+        while (_c.in.size() < _c.out.size()) {
+            const auto recvd = co_await _c.sock.asyncRecv(buf, sizeof(buf));
+            if (recvd == 0) {
+                break;
+            }
+            _c.in.append(buf, recvd);
+        }
+        EXPECT_EQ(_c.in, _c.out);
+    } catch (std::exception &e) {
+        ADD_FAILURE() << e.what();
+    }
+
+    if (++_done == 3) {
+        _reactor.stop();
+    }
+}
+
+// Large messages fill the send buffers, so asyncSend suspends until the
+// echo is received concurrently.
+Task send(Client &_c, Reactor &_reactor, int &_done)
+{
+    try {
+        co_await _c.sock.asyncConnect("127.0.0.1", 21130);
+        receive(_c, _reactor, _done);
+        co_await _c.sock.asyncSend(_c.out);
+    } catch (std::exception &e) {
+        ADD_FAILURE() << e.what();
+    }
+}
+
+Task refused(Reactor &_reactor, bool &_thrown)
+{
+    {
+        AsyncSocket s(_reactor, Socket(Domain::IPv4, Type::TCP));
+        try {
+            co_await s.asyncConnect("127.0.0.1", 21131);
+        } catch (std::runtime_error &) {
+            _thrown = true;
+        }
+    }
+    _reactor.stop();
+}
+}
+
+
+TEST(AsyncSocket, EchoIPv4)
+{
+    Reactor reactor;
+    std::size_t served = 0;
+    auto done          = 0;
+
+    Socket listener(Domain::IPv4, Type::TCP);
+    listener.setOpt(Opt::REUSEADDR, SockOpt(1));
+    listener.start("127.0.0.1", 21130);
+    AsyncSocket server(reactor, std::move(listener));
+
+    asyncSocketTest::serve(reactor, server, 3, served);
+
+    std::vector<std::unique_ptr<asyncSocketTest::Client>> clients;
+    for (const std::size_t size : {10, 1000, 8 << 20}) {
+        clients.emplace_back(
+          std::make_unique<asyncSocketTest::Client>(reactor, size));
+        asyncSocketTest::send(*clients.back(), reactor, done);
+    }
+
+    reactor.run();
+    EXPECT_EQ(done, 3);
+
+    // The echo handlers see the clients close on the following polls.
+    clients.clear();
+    while (served < 3) {
+        reactor.poll(1000);
+    }
+    EXPECT_EQ(reactor.size(), 1u);
+}
+
+
+TEST(AsyncSocket, Errors)
+{
+    Reactor reactor;
+    auto thrown = false;
+
+    asyncSocketTest::refused(reactor, thrown);
+
+    reactor.run();
+    EXPECT_TRUE(thrown);
+    EXPECT_EQ(reactor.size(), 0u);
+}
@@ -0,0 +1,125 @@
+#include "socket.hpp"
+#include <gtest/gtest.h>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace net;
+
+
+TEST(BufferPool, SizeClasses)
+{
+    BufferPool pool;
+
+    EXPECT_EQ(pool.acquire(0).capacity(), 256u);
+    EXPECT_EQ(pool.acquire(256).capacity(), 256u);
+    EXPECT_EQ(pool.acquire(257).capacity(), 512u);
+    EXPECT_EQ(pool.acquire(5000).capacity(), 8192u);
+    EXPECT_EQ(pool.acquire(65536).capacity(), 65536u);
+
+    auto big = pool.acquire(70000);
+    EXPECT_EQ(big.capacity(), 70000u);
+    EXPECT_EQ(pool.stats().oversized, 1u);
+    big.release();
+    EXPECT_EQ(pool.stats().oversized, 0u);
+    EXPECT_EQ(big.data(), nullptr);
+
+    EXPECT_THROW(pool.stats(70000), std::invalid_argument);
+}
+
+
+TEST(BufferPool, ReuseAndStats)
+{
+    BufferPool pool(8);
+
+    const char *first = nullptr;
+    {
+        auto buf = pool.acquire(100);
+        first    = buf.data();
+        EXPECT_EQ(buf.size(), 0u);
+        buf.resize(1000);
+        EXPECT_EQ(buf.size(), 256u);
+
+        const auto s = pool.stats(100);
+        EXPECT_EQ(s.slabBytes, BufferPool::slabBytes);
+        EXPECT_EQ(s.buffers, 1024u);
+        EXPECT_EQ(s.inUse, 1u);
+        EXPECT_EQ(s.cached, 3u);
+        EXPECT_EQ(s.shared, 1020u);
+    }
+    EXPECT_EQ(pool.acquire(100).data(), first);
+
+    // Returned past the cache limit, half of the cache spills.
+    std::vector<BufferPool::Buffer> bufs;
+    for (auto i = 0; i < 20; ++i) {
+        bufs.push_back(pool.acquire(100));
+    }
+    bufs.clear();
+
+    const auto s = pool.stats();
+    EXPECT_EQ(s.buffers, 1024u);
+    EXPECT_EQ(s.inUse, 0u);
+    EXPECT_LE(s.cached, 8u);
+    EXPECT_EQ(s.cached + s.shared, 1024u);
+}
+
+
+TEST(BufferPool, MoveAndThreads)
+{
+    BufferPool pool;
+
+    auto a = pool.acquire(10);
+    std::memcpy(a.data(), "abc", 3);
+    a.resize(3);
+
+    BufferPool::Buffer b(std::move(a));
+    EXPECT_EQ(a.data(), nullptr);
+    EXPECT_EQ(std::string(b.view().data(), b.size()), "abc");
+
+    a = std::move(b);
+    EXPECT_EQ(a.size(), 3u);
+    EXPECT_EQ(pool.stats().inUse, 1u);
+
+    // A buffer may be returned by another thread, and an exiting thread
+    // hands its cache over to the shared list.
+    std::thread([&pool, &a] {
+        a.release();
+        auto c = pool.acquire(10);
+    }).join();
+
+    const auto s = pool.stats();
+    EXPECT_EQ(s.inUse, 0u);
+    EXPECT_EQ(s.cached + s.shared, s.buffers);
+    EXPECT_GE(s.shared, s.buffers - 32);
+}
+
+
+TEST(Socket, RecvIntoPool)
+{
+    Socket server(Domain::IPv4, Type::TCP);
+    server.setOpt(Opt::REUSEADDR, SockOpt(1));
+    server.start("127.0.0.1", 21160);
+
+    Socket client(Domain::IPv4, Type::TCP);
+    client.connect("127.0.0.1", 21160);
+    const auto peer = server.accept();
+
+    BufferPool pool;
+    client.send("hello");
+    auto buf = peer.recv(pool, 100);
+    ASSERT_EQ(buf.size(), 5u);
+
+    peer.send(buf.view());
+    buf = client.read(pool, 100);
+    EXPECT_EQ(std::string(buf.data(), buf.size()), "hello");
+
+    auto errorNB = false;
+    peer.setNonBlocking();
+    buf = peer.recv(pool, 100, Recv::NONE, &errorNB);
+    EXPECT_TRUE(errorNB);
+    EXPECT_EQ(buf.size(), 0u);
+
+    buf.release();
+    EXPECT_EQ(pool.stats().inUse, 0u);
+}
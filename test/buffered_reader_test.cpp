@@ -0,0 +1,90 @@
+#include "buffered_reader.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+
+using namespace net;
+using namespace std::chrono_literals;
+
+
+TEST(BufferedReader, ReadUntil)
+{
+    Socket server(Domain::IPv4, Type::TCP);
+    server.setOpt(Opt::REUSEADDR, SockOpt(1));
+    server.start("127.0.0.1", 21110);
+
+    Socket client(Domain::IPv4, Type::TCP);
+    client.connect("127.0.0.1", 21110);
+    const auto peer = server.accept();
+    BufferedReader reader(peer);
+
+    client.send("one\ntwo\nthr");
+    std::this_thread::sleep_for(100ms);
+    EXPECT_EQ(reader.readUntil('\n'), "one\n");
+    EXPECT_EQ(reader.readUntil('\n'), "two\n");
+    EXPECT_EQ(reader.buffered(), 3u);
+
+    client.send("ee\r");
+    std::this_thread::sleep_for(100ms);
+
+    // The delimiter arrives split over two receives.
+    auto errorNB = false;
+    peer.setNonBlocking();
+    EXPECT_EQ(reader.readUntil("\r\n", &errorNB), "");
+    EXPECT_TRUE(errorNB);
+
+    client.send("\nrest");
+    std::this_thread::sleep_for(100ms);
+    EXPECT_EQ(reader.readUntil("\r\n", &errorNB), "three\r\n");
+
+    client.stop(Shut::WRITE);
+    std::this_thread::sleep_for(100ms);
+    EXPECT_EQ(reader.readUntil('\n', &errorNB), "");
+    EXPECT_TRUE(reader.eof());
+    EXPECT_EQ(reader.peek(), "rest");
+}
+
+
+TEST(BufferedReader, ReadExactWrapsAround)
+{
+    Socket server(Domain::IPv4, Type::TCP);
+    server.setOpt(Opt::REUSEADDR, SockOpt(1));
+    server.start("127.0.0.1", 21111);
+
+    Socket client(Domain::IPv4, Type::TCP);
+    client.connect("127.0.0.1", 21111);
+    const auto peer = server.accept();
+    BufferedReader reader(peer, 4096);
+    EXPECT_EQ(reader.capacity(), 4096u);
+
+    // Messages of 1000 bytes repeatedly straddle the end of the ring.
+    for (auto i = 0; i < 20; ++i) {
+        const std::string msg(1000, 'a' + i);
+        client.send(msg);
+
+        const auto view = reader.readExact(msg.size());
+        EXPECT_EQ(view, msg);
+    }
+    EXPECT_EQ(reader.buffered(), 0u);
+
+    EXPECT_THROW(reader.readExact(5000), std::invalid_argument);
+}
+
+
+TEST(BufferedReader, DelimiterBeyondCapacity)
+{
+    Socket server(Domain::IPv4, Type::TCP);
+    server.setOpt(Opt::REUSEADDR, SockOpt(1));
+    server.start("127.0.0.1", 21112);
+
+    Socket client(Domain::IPv4, Type::TCP);
+    client.connect("127.0.0.1", 21112);
+    const auto peer = server.accept();
+    BufferedReader reader(peer, 4096);
+
+    client.send(std::string(5000, 'x'));
+    EXPECT_THROW(reader.readUntil('\n'), std::runtime_error);
+
+    reader.consume(reader.buffered());
+    EXPECT_EQ(reader.buffered(), 0u);
+}
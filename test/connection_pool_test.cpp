@@ -0,0 +1,102 @@
+#include "connection_pool.hpp"
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace net;
+using namespace std::chrono_literals;
+
+
+TEST(ConnectionPool, WarmUpAndReuse)
+{
+    Socket server(Domain::IPv4, Type::TCP);
+    server.setOpt(Opt::REUSEADDR, SockOpt(1));
+    server.start("127.0.0.1", 21100);
+    server.setNonBlocking();
+    std::vector<Socket> peers;
+
+    ConnectionPool pool(Domain::IPv4, 2, 3);
+    auto &ep = pool.endpoint("127.0.0.1", 21100);
+    EXPECT_EQ(&pool.endpoint("127.0.0.1", 21100), &ep);
+    EXPECT_EQ(ep.idle(), 2u);
+
+    std::this_thread::sleep_for(100ms);
+    EXPECT_EQ(server.acceptMany(peers), 2u);
+
+    {
+        const auto lease = pool.acquire(ep);
+        EXPECT_TRUE(lease.reused());
+        EXPECT_EQ(ep.idle(), 1u);
+    }
+    EXPECT_EQ(ep.idle(), 2u);
+
+    {
+        std::vector<ConnectionPool::Lease> leases;
+        for (auto i = 0; i < 5; ++i) {
+            leases.push_back(pool.acquire("127.0.0.1", 21100));
+        }
+        EXPECT_TRUE(leases[1].reused());
+        EXPECT_FALSE(leases[2].reused());
+        EXPECT_EQ(ep.idle(), 0u);
+
+        leases.back().discard();
+    }
+    // One lease was discarded and one is beyond the idle maximum.
+    EXPECT_EQ(ep.idle(), 3u);
+
+    std::this_thread::sleep_for(100ms);
+    EXPECT_EQ(server.acceptMany(peers), 3u);
+}
+
+
+TEST(ConnectionPool, DropsDeadConnections)
+{
+    Socket server(Domain::IPv4, Type::TCP);
+    server.setOpt(Opt::REUSEADDR, SockOpt(1));
+    server.start("127.0.0.1", 21101);
+    server.setNonBlocking();
+
+    ConnectionPool pool(Domain::IPv4, 2);
+    auto &ep = pool.endpoint("127.0.0.1", 21101);
+    std::this_thread::sleep_for(100ms);
+
+    std::vector<Socket> peers;
+    ASSERT_EQ(server.acceptMany(peers), 2u);
+
+    // One peer closes its connection, the other sends unsolicited data.
+    peers[0].close();
+    peers[1].send("stale");
+    std::this_thread::sleep_for(100ms);
+
+    const auto lease = pool.acquire(ep);
+    EXPECT_FALSE(lease.reused());
+    EXPECT_EQ(ep.idle(), 0u);
+
+    lease->send("ping");
+    std::this_thread::sleep_for(100ms);
+    ASSERT_EQ(server.acceptMany(peers), 1u);
+
+    char buf[8];
+    EXPECT_EQ(peers.back().recv(buf, sizeof(buf)), 4);
+}
+
+
+TEST(ConnectionPool, FailedWarmUpRegistersNothing)
+{
+    ConnectionPool pool(Domain::IPv4, 2);
+    EXPECT_THROW(pool.endpoint("127.0.0.1", 21102), std::runtime_error);
+
+    Socket server(Domain::IPv4, Type::TCP);
+    server.setOpt(Opt::REUSEADDR, SockOpt(1));
+    server.start("127.0.0.1", 21102);
+    server.setNonBlocking();
+
+    // Warmed up now, rather than handed back cold from the failed attempt.
+    const auto &ep = pool.endpoint("127.0.0.1", 21102);
+    EXPECT_EQ(ep.idle(), 2u);
+
+    std::this_thread::sleep_for(100ms);
+    std::vector<Socket> peers;
+    EXPECT_EQ(server.acceptMany(peers), 2u);
+}
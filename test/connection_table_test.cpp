@@ -0,0 +1,186 @@
+#include "connection_table.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+
+extern "C" {
+#include <fcntl.h>
+}
+
+using namespace net;
+using namespace std::chrono_literals;
+
+
+namespace {
+
+bool isOpen(const int _fd) { return fcntl(_fd, F_GETFD) != -1; }
+
+Connection udp() { return Socket(Domain::IPv4, Type::UDP); }
+}
+
+
+TEST(ConnectionTable, InsertLookupErase)
+{
+    ConnectionTable table;
+    EXPECT_TRUE(table.empty());
+    EXPECT_FALSE(table.contains(ConnectionTable::Id()));
+
+    auto conn     = udp();
+    const auto fd = conn.getSocket();
+    const auto id = table.insert(std::move(conn), 3);
+    EXPECT_EQ(conn.getSocket(), -1);
+    EXPECT_EQ(table.size(), 1u);
+    EXPECT_TRUE(table.contains(id));
+    EXPECT_EQ(table.lookup(fd), id);
+    EXPECT_EQ(table.get(id)->getSocket(), fd);
+    EXPECT_EQ(table.state(id), 3);
+    EXPECT_EQ(ConnectionTable::Id::fromToken(id.token()), id);
+
+    EXPECT_TRUE(table.setState(id, 4));
+    EXPECT_EQ(table.stateAt(0), 4);
+
+    EXPECT_TRUE(table.erase(id));
+    EXPECT_FALSE(isOpen(fd));
+    EXPECT_FALSE(table.contains(id));
+    EXPECT_FALSE(table.erase(id));
+    EXPECT_EQ(table.get(id), nullptr);
+    EXPECT_FALSE(table.setState(id, 5));
+    EXPECT_FALSE(table.touch(id));
+    EXPECT_THROW(table.state(id), std::out_of_range);
+    EXPECT_FALSE(table.contains(table.lookup(fd)));
+
+    // The slot is reused under a new generation, leaving the old Id stale.
+    const auto reused = table.insert(udp());
+    EXPECT_NE(reused, id);
+    EXPECT_FALSE(table.contains(id));
+    EXPECT_TRUE(table.contains(reused));
+
+    EXPECT_THROW(table.insert(Connection()), std::invalid_argument);
+    EXPECT_EQ(table.size(), 1u);
+}
+
+
+TEST(ConnectionTable, ReleaseAndCompaction)
+{
+    ConnectionTable table(2);
+
+    std::vector<ConnectionTable::Id> ids;
+    std::vector<int> fds;
+    for (auto i = 0; i < 10; ++i) {
+        auto conn = udp();
+        fds.push_back(conn.getSocket());
+        ids.push_back(table.insert(std::move(conn), i));
+    }
+
+    // Removing from the middle moves the last entry into the hole.
+    auto conn = table.release(ids[2]);
+    EXPECT_EQ(conn.getSocket(), fds[2]);
+    EXPECT_TRUE(isOpen(fds[2]));
+    EXPECT_TRUE(table.erase(ids[5]));
+    EXPECT_EQ(table.size(), 8u);
+
+    for (auto i = 0; i < 10; ++i) {
+        if (i == 2 || i == 5) {
+            EXPECT_FALSE(table.contains(table.lookup(fds[i])));
+            continue;
+        }
+        EXPECT_EQ(table.lookup(fds[i]), ids[i]);
+        EXPECT_EQ(table.state(ids[i]), i);
+        EXPECT_EQ(table.get(ids[i])->getSocket(), fds[i]);
+    }
+
+    for (std::size_t i = 0; i < table.size(); ++i) {
+        EXPECT_EQ(table.connectionAt(i).getSocket(),
+                  table.get(table.idAt(i))->getSocket());
+    }
+
+    table.clear();
+    EXPECT_TRUE(table.empty());
+    EXPECT_FALSE(table.contains(ids[0]));
+    EXPECT_FALSE(isOpen(fds[0]));
+}
+
+
+TEST(ConnectionTable, Expire)
+{
+    ConnectionTable table;
+    const auto t0 = ConnectionTable::Clock::now();
+
+    std::vector<ConnectionTable::Id> ids;
+    for (auto i = 0; i < 8; ++i) {
+        ids.push_back(table.insert(udp(), 0, t0));
+    }
+    for (auto i = 0; i < 8; i += 2) {
+        EXPECT_TRUE(table.touch(ids[i], t0 + 10s));
+    }
+
+    EXPECT_EQ(table.expire(t0), 0u);
+
+    std::vector<ConnectionTable::Id> expired;
+    const auto count
+      = table.expire(t0 + 5s, [&](ConnectionTable::Id _id, const Connection &_c) {
+            EXPECT_NE(_c.getSocket(), -1);
+            expired.push_back(_id);
+        });
+    EXPECT_EQ(count, 4u);
+    ASSERT_EQ(expired.size(), 4u);
+
+    for (auto i = 0; i < 8; ++i) {
+        const auto found
+          = std::find(expired.begin(), expired.end(), ids[i]) != expired.end();
+        EXPECT_EQ(found, i % 2 == 1);
+        EXPECT_EQ(table.contains(ids[i]), i % 2 == 0);
+    }
+    for (std::size_t i = 0; i < table.size(); ++i) {
+        EXPECT_EQ(table.lastActiveAt(i), t0 + 10s);
+    }
+}
+
+
+TEST(ConnectionTable, EraseClosedHandle)
+{
+    ConnectionTable table;
+
+    auto conn     = udp();
+    const auto fd = conn.getSocket();
+    const auto id = table.insert(std::move(conn));
+    table.insert(udp());
+
+    // Closed behind the back of the table, the handle no longer knows its
+    // descriptor; the table still does.
+    EXPECT_TRUE(table.get(id)->close());
+    EXPECT_EQ(table.lookup(fd), id);
+    EXPECT_TRUE(table.erase(id));
+    EXPECT_FALSE(table.contains(table.lookup(fd)));
+    EXPECT_EQ(table.size(), 1u);
+
+    const auto expired = table.expire(
+      ConnectionTable::Clock::now() + 1s,
+      [](ConnectionTable::Id, const Connection &_c) {
+          EXPECT_NE(_c.getSocket(), -1);
+      });
+    EXPECT_EQ(expired, 1u);
+    EXPECT_TRUE(table.empty());
+}
+
+
+TEST(Socket, MoveAssignment)
+{
+    Socket a(Domain::IPv4, Type::UDP);
+    Socket b(Domain::IPv4, Type::UDP);
+    const auto fdA = a.getSocket();
+    const auto fdB = b.getSocket();
+
+    a = std::move(b);
+    EXPECT_EQ(a.getSocket(), fdB);
+    EXPECT_EQ(b.getSocket(), -1);
+    EXPECT_FALSE(isOpen(fdA));
+    EXPECT_TRUE(isOpen(fdB));
+
+    std::vector<Socket> sockets;
+    sockets.push_back(std::move(a));
+    sockets.emplace_back(Domain::IPv4, Type::UDP);
+    sockets.erase(sockets.begin());
+    EXPECT_FALSE(isOpen(fdB));
+    EXPECT_EQ(sockets.size(), 1u);
+}
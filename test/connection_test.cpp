@@ -0,0 +1,109 @@
+#include "connection.hpp"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <unistd.h>
+}
+
+using namespace net;
+
+
+TEST(Connection, Compact)
+{
+    EXPECT_EQ(sizeof(Connection), 8u);
+
+    Connection empty;
+    EXPECT_EQ(empty.getSocket(), -1);
+    EXPECT_FALSE(empty.close());
+}
+
+
+TEST(Connection, FromAccept)
+{
+    Socket server(Domain::IPv4, Type::TCP);
+    server.setOpt(Opt::REUSEADDR, SockOpt(1));
+    server.start("127.0.0.1", 21170);
+
+    Socket client(Domain::IPv4, Type::TCP);
+    client.connect("127.0.0.1", 21170);
+
+    Connection conn = server.accept();
+    EXPECT_NE(conn.getSocket(), -1);
+    EXPECT_EQ(conn.domain(), Domain::IPv4);
+    EXPECT_EQ(conn.type(), Type::TCP);
+
+    AddrIPv4 local;
+    socklen_t len = sizeof(local);
+    getsockname(client.getSocket(), (sockaddr *) &local, &len);
+    const auto peer = conn.peer();
+    EXPECT_EQ(peer.ss_family, AF_INET);
+    EXPECT_EQ(reinterpret_cast<const AddrIPv4 &>(peer).sin_port,
+              local.sin_port);
+
+    conn.send("hello");
+    EXPECT_EQ(client.recv(5), "hello");
+
+    // Calls through a view leave the descriptor open.
+    conn.view().setOpt(Opt::RCVTIMEO, SockOpt(1L, 0L));
+    client.send("again");
+    char buf[8];
+    EXPECT_EQ(conn.recv(buf, sizeof(buf)), 5);
+
+    const auto s = conn.toSocket();
+    EXPECT_EQ(conn.getSocket(), -1);
+    s.send("bye");
+    EXPECT_EQ(client.recv(3), "bye");
+}
+
+
+TEST(Connection, AcceptManyAndMove)
+{
+    Socket server(Domain::IPv4, Type::TCP);
+    server.setOpt(Opt::REUSEADDR, SockOpt(1));
+    server.start("127.0.0.1", 21171);
+    server.setNonBlocking();
+
+    std::vector<Socket> clients;
+    for (auto i = 0; i < 3; ++i) {
+        clients.emplace_back(Domain::IPv4, Type::TCP);
+        clients.back().connect("127.0.0.1", 21171);
+    }
+    usleep(100000);
+
+    std::vector<Connection> conns;
+    EXPECT_EQ(server.acceptMany(conns, false), 3u);
+    ASSERT_EQ(conns.size(), 3u);
+
+    auto moved = std::move(conns[0]);
+    EXPECT_EQ(conns[0].getSocket(), -1);
+    conns[0] = std::move(conns[1]);
+    EXPECT_EQ(conns[1].getSocket(), -1);
+    EXPECT_NE(conns[0].getSocket(), -1);
+
+    moved.trySend("x");
+    char c;
+    EXPECT_EQ(clients[0].recv(&c, 1), 1);
+
+    EXPECT_TRUE(moved.close());
+    EXPECT_EQ(clients[0].recv(&c, 1), 0);
+}
+
+
+TEST(Socket, MovedFromKeepsUnixPath)
+{
+    const char path[] = "/tmp/netMovedSocketTest";
+    ::unlink(path);
+
+    {
+        std::unique_ptr<Socket> a(new Socket(Domain::UNIX, Type::TCP));
+        a->start(path);
+
+        Socket b(std::move(*a));
+        a.reset();
+        EXPECT_EQ(::access(path, F_OK), 0);
+    }
+    EXPECT_NE(::access(path, F_OK), 0);
+}
@@ -0,0 +1,225 @@
+#include "executor.hpp"
+#include <gtest/gtest.h>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace net;
+using namespace std::chrono_literals;
+
+
+namespace executorTest {
+
+const std::string msg("executorTest::msg");
+
+// Counts the leaves of a binary tree of jobs, every job submitting its two
+// children from its worker.
+void spawn(Executor &_executor, const int _depth, std::atomic<int> &_leaves)
+{
+    if (_depth == 0) {
+        ++_leaves;
+        return;
+    }
+    for (auto i = 0; i < 2; ++i) {
+        _executor.submit(
+          [&, _depth] { spawn(_executor, _depth - 1, _leaves); });
+    }
+}
+}
+
+
+TEST(WorkStealingDeque, OwnerAndThief)
+{
+    WorkStealingDeque<int> deque(2);
+    int items[100];
+
+    EXPECT_TRUE(deque.empty());
+    EXPECT_EQ(deque.pop(), nullptr);
+    EXPECT_EQ(deque.steal(), nullptr);
+
+    // Grows past its initial capacity.
+    for (auto &i : items) {
+        deque.push(&i);
+    }
+    EXPECT_FALSE(deque.empty());
+
+    // The owner takes the newest, thieves the oldest.
+    EXPECT_EQ(deque.pop(), &items[99]);
+    EXPECT_EQ(deque.steal(), &items[0]);
+    EXPECT_EQ(deque.steal(), &items[1]);
+    for (auto i = 98; i >= 2; --i) {
+        EXPECT_EQ(deque.pop(), &items[i]);
+    }
+    EXPECT_EQ(deque.pop(), nullptr);
+    EXPECT_TRUE(deque.empty());
+}
+
+
+TEST(WorkStealingDeque, ConcurrentThieves)
+{
+    const auto count = 200000;
+    std::vector<int> items(count);
+    std::vector<std::atomic<int>> taken(count);
+    for (auto &t : taken) {
+        t = 0;
+    }
+
+    WorkStealingDeque<int> deque;
+    std::atomic<bool> done(false);
+    auto take = [&](int *_item) { ++taken[_item - items.data()]; };
+
+    std::vector<std::thread> thieves;
+    for (auto t = 0; t < 3; ++t) {
+        thieves.emplace_back([&] {
+            while (!done || !deque.empty()) {
+                if (const auto item = deque.steal()) {
+                    take(item);
+                }
+            }
+        });
+    }
+
+    // The owner pops now and then, racing the thieves for the last items.
+    for (auto i = 0; i < count; ++i) {
+        deque.push(&items[i]);
+        if (i % 3 == 0) {
+            if (const auto item = deque.pop()) {
+                take(item);
+            }
+        }
+    }
+    done = true;
+    for (auto &t : thieves) {
+        t.join();
+    }
+
+    for (const auto &t : taken) {
+        ASSERT_EQ(t, 1);
+    }
+}
+
+
+TEST(Executor, RunsEverything)
+{
+    std::atomic<int> ran(0);
+    std::atomic<int> leaves(0);
+    {
+        Executor executor(4);
+        EXPECT_EQ(executor.size(), 4u);
+
+        std::vector<std::thread> submitters;
+        for (auto t = 0; t < 2; ++t) {
+            submitters.emplace_back([&] {
+                for (auto i = 0; i < 10000; ++i) {
+                    executor.submit([&] { ++ran; });
+                }
+            });
+        }
+        for (auto &t : submitters) {
+            t.join();
+        }
+
+        executor.submit([&] { executorTest::spawn(executor, 12, leaves); });
+
+        // Move-only jobs.
+        auto owned = std::make_unique<int>(1);
+        executor.submit([ owned = std::move(owned), &ran ] { ran += *owned; });
+    }
+
+    EXPECT_EQ(ran, 20001);
+    EXPECT_EQ(leaves, 1 << 12);
+}
+
+
+TEST(Executor, SleepsAndWakes)
+{
+    Executor executor(2);
+    std::atomic<int> ran(0);
+
+    for (auto round = 0; round < 5; ++round) {
+        std::this_thread::sleep_for(10ms);
+        executor.submit([&] { ++ran; });
+        for (auto i = 0; i < 200 && ran <= round; ++i) {
+            std::this_thread::sleep_for(5ms);
+        }
+        EXPECT_EQ(ran, round + 1);
+    }
+}
+
+
+TEST(Executor, Sockets)
+{
+    std::atomic<int> echoed(0);
+
+    Socket server(Domain::IPv4, Type::TCP);
+    server.setOpt(Opt::REUSEADDR, SockOpt(1));
+    server.start("127.0.0.1", 21140);
+
+    std::vector<std::thread> clients;
+    for (auto i = 0; i < 8; ++i) {
+        clients.emplace_back([&] {
+            Socket s(Domain::IPv4, Type::TCP);
+            s.connect("127.0.0.1", 21140);
+            s.send(executorTest::msg);
+            if (s.recv(executorTest::msg.size()) == executorTest::msg) {
+                ++echoed;
+            }
+        });
+    }
+
+    {
+        Executor executor(3);
+        for (auto i = 0; i < 8; ++i) {
+            executor.submit(server.accept(), [](Socket &_peer) {
+                _peer.send(_peer.recv(executorTest::msg.size()));
+            });
+        }
+    }
+
+    for (auto &c : clients) {
+        c.join();
+    }
+    EXPECT_EQ(echoed, 8);
+}
+
+
+TEST(Executor, JobExceptions)
+{
+    std::mutex mutex;
+    std::vector<std::string> errors;
+    std::atomic<int> ran(0);
+    {
+        Executor executor(2, [&](std::exception_ptr _error) {
+            try {
+                std::rethrow_exception(_error);
+            } catch (std::exception &e) {
+                std::lock_guard<std::mutex> lock(mutex);
+                errors.emplace_back(e.what());
+            }
+        });
+
+        for (auto i = 0; i < 100; ++i) {
+            executor.submit([&, i] {
+                if (i % 10 == 0) {
+                    throw std::runtime_error("executorTest::error");
+                }
+                ++ran;
+            });
+        }
+    }
+
+    // The workers outlive the failed jobs and run the rest.
+    EXPECT_EQ(ran, 90);
+    ASSERT_EQ(errors.size(), 10u);
+    EXPECT_EQ(errors[0], "executorTest::error");
+
+    // Without a handler the exception is dropped.
+    {
+        Executor executor(1);
+        executor.submit([] { throw std::runtime_error("dropped"); });
+        executor.submit([&] { ++ran; });
+    }
+    EXPECT_EQ(ran, 91);
+}
@@ -0,0 +1,157 @@
+#include "framing.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace net;
+using namespace std::chrono_literals;
+
+
+TEST(Framing, RoundTrip)
+{
+    Socket server(Domain::IPv4, Type::TCP);
+    server.setOpt(Opt::REUSEADDR, SockOpt(1));
+    server.start("127.0.0.1", 21120);
+
+    Socket client(Domain::IPv4, Type::TCP);
+    client.connect("127.0.0.1", 21120);
+    const auto peer = server.accept();
+
+    const std::vector<std::string> frames{
+      "hello", "", std::string(1000, 'x'), std::string(70000, 'y'), "bye"};
+
+    std::thread writerThread([&] {
+        FrameWriter writer(client, 4096);
+        writer.write(frames[0]);
+        writer.write(frames[1]);
+        EXPECT_EQ(writer.pending(), 4u + 5 + 4);
+
+        for (std::size_t i = 2; i < frames.size(); ++i) {
+            writer.write(frames[i]);
+        }
+        EXPECT_EQ(writer.pending(), 4u + 3);
+        EXPECT_TRUE(writer.flush());
+        EXPECT_EQ(writer.pending(), 0u);
+    });
+
+    FrameReader reader(peer);
+    for (const auto &f : frames) {
+        StringView payload;
+        ASSERT_TRUE(reader.read(payload));
+        EXPECT_EQ(payload, f);
+    }
+    writerThread.join();
+
+    client.close();
+    StringView payload;
+    EXPECT_FALSE(reader.read(payload));
+    EXPECT_TRUE(reader.eof());
+}
+
+
+TEST(Framing, MaxFrameSize)
+{
+    Socket server(Domain::IPv4, Type::TCP);
+    server.setOpt(Opt::REUSEADDR, SockOpt(1));
+    server.start("127.0.0.1", 21121);
+
+    Socket client(Domain::IPv4, Type::TCP);
+    client.connect("127.0.0.1", 21121);
+    const auto peer = server.accept();
+
+    FrameWriter small(client, 4096, 16);
+    EXPECT_THROW(small.write(std::string(17, 'a')), std::invalid_argument);
+
+    FrameWriter writer(client);
+    writer.write(std::string(17, 'a'));
+    writer.flush();
+
+    FrameReader reader(peer, 16);
+    StringView payload;
+    EXPECT_THROW(reader.read(payload), std::runtime_error);
+}
+
+
+TEST(Framing, NonBlockingPartialFrame)
+{
+    Socket server(Domain::IPv4, Type::TCP);
+    server.setOpt(Opt::REUSEADDR, SockOpt(1));
+    server.start("127.0.0.1", 21122);
+
+    Socket client(Domain::IPv4, Type::TCP);
+    client.connect("127.0.0.1", 21122);
+    const auto peer = server.accept();
+    peer.setNonBlocking();
+
+    // Length prefix of 6 followed by only part of the payload.
+    client.send(std::string("\0\0\0\6fra", 7));
+    std::this_thread::sleep_for(100ms);
+
+    FrameReader reader(peer);
+    StringView payload;
+    auto errorNB = false;
+    EXPECT_FALSE(reader.read(payload, &errorNB));
+    EXPECT_TRUE(errorNB);
+
+    client.send("me!");
+    std::this_thread::sleep_for(100ms);
+    ASSERT_TRUE(reader.read(payload, &errorNB));
+    EXPECT_EQ(payload, "frame!");
+}
+
+
+TEST(Framing, SeqpacketWholeFrames)
+{
+    const char path[] = "/tmp/netFramingSeqpacketTest";
+    ::unlink(path);
+
+    Socket server(Domain::UNIX, Type::SEQPACKET);
+    server.start(path);
+
+    Socket client(Domain::UNIX, Type::SEQPACKET);
+    client.connect(path);
+    const auto peer = server.accept();
+
+    // Batched together the frames outgrow the reader's buffer, so the
+    // writer has to split them into packets at frame boundaries.
+    const std::size_t maxFrame = 12284;
+    const std::vector<std::string> frames{
+      std::string(6000, 'a'), "", std::string(6000, 'b'),
+      std::string(maxFrame, 'c'), "d", std::string(300, 'e')};
+
+    FrameWriter writer(client, 65536, maxFrame);
+    for (const auto &f : frames) {
+        writer.write(f);
+    }
+    EXPECT_TRUE(writer.flush());
+
+    FrameReader reader(peer, maxFrame);
+    for (const auto &f : frames) {
+        StringView payload;
+        ASSERT_TRUE(reader.read(payload));
+        EXPECT_EQ(payload, f);
+    }
+}
+
+
+TEST(Framing, SeqpacketTruncated)
+{
+    const char path[] = "/tmp/netFramingTruncatedTest";
+    ::unlink(path);
+
+    Socket server(Domain::UNIX, Type::SEQPACKET);
+    server.start(path);
+
+    Socket client(Domain::UNIX, Type::SEQPACKET);
+    client.connect(path);
+    const auto peer = server.accept();
+
+    FrameWriter writer(client);
+    writer.write(std::string(20000, 'x'));
+    EXPECT_TRUE(writer.flush());
+
+    FrameReader reader(peer, 12284);
+    StringView payload;
+    EXPECT_THROW(reader.read(payload), std::runtime_error);
+}
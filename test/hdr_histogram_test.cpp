@@ -0,0 +1,109 @@
+#include "hdr_histogram.hpp"
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace net;
+
+
+TEST(HdrHistogram, RelativeError)
+{
+    HdrHistogram hist;
+    EXPECT_EQ(hist.percentile(50), 0u);
+
+    for (std::uint64_t v = 1; v <= 1000000; ++v) {
+        hist.record(v);
+    }
+    EXPECT_EQ(hist.count(), 1000000u);
+    EXPECT_EQ(hist.maximum(), 1000000u);
+
+    for (const auto p : {10.0, 50.0, 90.0, 99.0, 99.9}) {
+        const auto exact = p / 100 * 1000000;
+        EXPECT_NEAR(hist.percentile(p), exact, exact / 64) << p;
+    }
+    EXPECT_EQ(hist.percentile(100), 1000000u);
+}
+
+
+TEST(HdrHistogram, SmallAndHugeValues)
+{
+    HdrHistogram hist(6, 20);
+    EXPECT_EQ(hist.bucketCount(), 15u * 64);
+    EXPECT_EQ(HdrHistogram().bucketCount(), 35u * 64);
+    hist.record(0);
+    hist.record(63, 2);
+    EXPECT_EQ(hist.percentile(0), 0u);
+    EXPECT_EQ(hist.percentile(50), 63u);
+
+    // Clamped into the last bucket, though the maximum stays exact.
+    hist.record(UINT64_MAX);
+    EXPECT_EQ(hist.maximum(), UINT64_MAX);
+    EXPECT_EQ(hist.percentile(99), (1u << 20) - 1);
+
+    HdrHistogram full(4, 64);
+    full.record(UINT64_MAX);
+    EXPECT_EQ(full.percentile(50), UINT64_MAX);
+
+    EXPECT_THROW(HdrHistogram(8, 8), std::invalid_argument);
+    EXPECT_THROW(HdrHistogram(4, 65), std::invalid_argument);
+}
+
+
+TEST(HdrHistogram, MergePerThread)
+{
+    HdrHistogram a, b;
+    std::thread ta([&a] {
+        for (auto i = 0; i < 100000; ++i) {
+            a.record(1000);
+        }
+    });
+    std::thread tb([&b] {
+        for (auto i = 0; i < 100000; ++i) {
+            b.record(100000);
+        }
+    });
+    ta.join();
+    tb.join();
+
+    HdrHistogram sum;
+    sum.merge(a);
+    sum.merge(b);
+    EXPECT_EQ(sum.count(), 200000u);
+    EXPECT_EQ(sum.maximum(), 100000u);
+    EXPECT_NEAR(sum.percentile(25), 1000, 1000 / 64);
+    EXPECT_NEAR(sum.percentile(75), 100000, 100000 / 64);
+
+    EXPECT_THROW(sum.merge(HdrHistogram(5, 40)), std::invalid_argument);
+
+    sum.reset();
+    EXPECT_EQ(sum.count(), 0u);
+    EXPECT_EQ(sum.maximum(), 0u);
+}
+
+
+TEST(HdrHistogram, Serialize)
+{
+    HdrHistogram hist;
+    for (std::uint64_t v = 1; v < 1000000; v *= 3) {
+        hist.record(v, v % 7 + 1);
+    }
+
+    const auto data = hist.serialize();
+    EXPECT_LT(data.size(), 100u);
+
+    const auto copy = HdrHistogram::deserialize(data);
+    EXPECT_EQ(copy.count(), hist.count());
+    EXPECT_EQ(copy.maximum(), hist.maximum());
+    for (const auto p : {0.0, 33.0, 50.0, 90.0, 100.0}) {
+        EXPECT_EQ(copy.percentile(p), hist.percentile(p));
+    }
+    EXPECT_EQ(copy.serialize(), data);
+
+    EXPECT_THROW(HdrHistogram::deserialize(""), std::invalid_argument);
+    EXPECT_THROW(HdrHistogram::deserialize("x"), std::invalid_argument);
+    EXPECT_THROW(HdrHistogram::deserialize(data.substr(0, data.size() - 1)),
+                 std::invalid_argument);
+    EXPECT_THROW(HdrHistogram::deserialize(data + std::string(1, '\x7f')),
+                 std::invalid_argument);
+}
@@ -0,0 +1,161 @@
+#include "http_parser.hpp"
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace net;
+
+
+namespace httpParserTest {
+
+const std::string get("GET /index.html?q=1 HTTP/1.1\r\n"
+                      "Host: example.com\r\n"
+                      "User-Agent:  test agent \t\r\n"
+                      "Accept: */*\r\n"
+                      "\r\n");
+
+const std::string post("POST /form HTTP/1.0\r\n"
+                       "Content-Length: 5\r\n"
+                       "Connection: keep-alive\r\n"
+                       "\r\n"
+                       "a=b&c");
+}
+
+
+TEST(HttpParser, Complete)
+{
+    HttpParser parser;
+    HttpRequest req;
+
+    ASSERT_EQ(parser.parse(httpParserTest::get, req), HttpStatus::COMPLETE);
+    EXPECT_EQ(req.method(), "GET");
+    EXPECT_EQ(req.target(), "/index.html?q=1");
+    EXPECT_EQ(req.version(), 1);
+    EXPECT_EQ(req.size(), 3u);
+    EXPECT_EQ(req.headLength(), httpParserTest::get.size());
+    EXPECT_EQ(req.contentLength(), 0u);
+    EXPECT_TRUE(req.keepAlive());
+
+    EXPECT_EQ(req.begin()->name, "Host");
+    EXPECT_EQ(req.header("host"), "example.com");
+    EXPECT_EQ(req.header("USER-AGENT"), "test agent");
+    EXPECT_EQ(req.header("Cookie"), "");
+}
+
+
+TEST(HttpParser, Incremental)
+{
+    HttpParser parser;
+    HttpRequest req;
+    const auto &msg = httpParserTest::get;
+
+    // Fed one more byte at a time, as if every recv returned a single byte.
+    for (std::size_t len = 0; len < msg.size(); ++len) {
+        ASSERT_EQ(parser.parse(StringView(msg.data(), len), req),
+                  HttpStatus::PARTIAL);
+    }
+    ASSERT_EQ(parser.parse(msg, req), HttpStatus::COMPLETE);
+    EXPECT_EQ(req.header("Accept"), "*/*");
+}
+
+
+TEST(HttpParser, Pipelined)
+{
+    HttpParser parser;
+    HttpRequest req;
+    const auto buf = httpParserTest::post + httpParserTest::get;
+
+    ASSERT_EQ(parser.parse(buf, req), HttpStatus::COMPLETE);
+    EXPECT_EQ(req.method(), "POST");
+    EXPECT_EQ(req.version(), 0);
+    EXPECT_TRUE(req.keepAlive());
+    EXPECT_EQ(req.contentLength(), 5u);
+
+    const auto next = req.headLength() + req.contentLength();
+    EXPECT_EQ(buf.substr(req.headLength(), 5), "a=b&c");
+
+    ASSERT_EQ(parser.parse(StringView(buf.data() + next, buf.size() - next),
+                           req),
+              HttpStatus::COMPLETE);
+    EXPECT_EQ(req.method(), "GET");
+}
+
+
+TEST(HttpParser, Invalid)
+{
+    const std::string requests[] = {
+      "GET  / HTTP/1.1\r\n\r\n",
+      "GET / HTTP/2.0\r\n\r\n",
+      "GET /\r\n\r\n",
+      "G(T / HTTP/1.1\r\n\r\n",
+      "GET / HTTP/1.1\r\nNo colon\r\n\r\n",
+      "GET / HTTP/1.1\r\nA: 1\r\n folded\r\n\r\n",
+      "GET / HTTP/1.1\r\nContent-Length: 1x\r\n\r\n",
+      "GET / HTTP/1.1\r\nContent-Length: 1\r\nContent-Length: 2\r\n\r\n",
+      "GET / HTTP/1.1\r\nA: bare\rcr\r\n\r\n",
+    };
+
+    for (const auto &r : requests) {
+        HttpParser parser;
+        HttpRequest req;
+        EXPECT_EQ(parser.parse(r, req), HttpStatus::INVALID) << r;
+    }
+
+    std::string many("GET / HTTP/1.1\r\n");
+    for (std::size_t i = 0; i <= HttpRequest::maxHeaders; ++i) {
+        many += "A: b\r\n";
+    }
+    many += "\r\n";
+
+    HttpParser parser;
+    HttpRequest req;
+    EXPECT_EQ(parser.parse(many, req), HttpStatus::INVALID);
+}
+
+
+TEST(HttpParser, TransferEncoding)
+{
+    HttpParser parser;
+    HttpRequest req;
+
+    // Both framings at once, in either order, is the smuggling shape.
+    const std::string both[] = {
+      "POST / HTTP/1.1\r\nContent-Length: 5\r\n"
+      "Transfer-Encoding: chunked\r\n\r\n",
+      "POST / HTTP/1.1\r\ntransfer-encoding: chunked\r\n"
+      "Content-Length: 5\r\n\r\n",
+    };
+    for (const auto &r : both) {
+        EXPECT_EQ(parser.parse(r, req), HttpStatus::INVALID) << r;
+    }
+
+    const std::string chunked[] = {
+      "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n"
+      "5\r\nhello\r\n0\r\n\r\n",
+      "POST / HTTP/1.1\r\nTransfer-Encoding: gzip, chunked\r\n\r\n",
+    };
+    for (const auto &r : chunked) {
+        EXPECT_EQ(parser.parse(r, req), HttpStatus::UNSUPPORTED) << r;
+    }
+}
+
+
+TEST(HttpParser, LongValues)
+{
+    // Control characters at every offset of values longer than the vector
+    // width, so they are found in vectors and in the remainder alike.
+    const std::string value(100, 'v');
+
+    for (std::size_t i = 0; i <= value.size(); ++i) {
+        auto bad = value;
+        bad.insert(i, 1, '\x01');
+
+        HttpParser parser;
+        HttpRequest req;
+        const auto ok = "GET / HTTP/1.1\r\nX: " + value + "\tend\r\n\r\n";
+        ASSERT_EQ(parser.parse(ok, req), HttpStatus::COMPLETE);
+        EXPECT_EQ(req.header("x"), value + "\tend");
+
+        const auto r = "GET /" + bad + " HTTP/1.1\r\nX: " + bad + "\r\n\r\n";
+        EXPECT_EQ(parser.parse(r, req), HttpStatus::INVALID);
+    }
+}
@@ -0,0 +1,176 @@
+#include "reactor.hpp"
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <string>
+#include <unordered_map>
+
+using namespace net;
+using namespace std::chrono_literals;
+
+
+namespace reactorTest {
+
+const std::string msg1("reactorTest::msg1");
+const std::string msg2("reactorTest::msg2");
+
+void startEchoServerIPv4(Reactor &_reactor, std::size_t &_served)
+{
+    std::unordered_map<int, Socket> peers;
+
+    Socket server(Domain::IPv4, Type::TCP);
+    server.start("127.0.0.1", 21050);
+    server.setNonBlocking();
+
+    _reactor.add(server, Event::READ, [&](Event ev) {
+        EXPECT_TRUE(hasEvent(ev, Event::READ));
+
+        auto errorNB = false;
+        auto peer    = server.accept(&errorNB);
+        if (errorNB) {
+            return;
+        }
+
+        const auto fd = peer.getSocket();
+        peer.setNonBlocking();
+        peers.emplace(fd, std::move(peer));
+
+        // Level-triggered, so one read per wakeup is enough.
+        _reactor.add(fd, Event::READ, [&, fd](Event) {
+            char buf[64];
+            auto errorNB     = false;
+            const auto recvd = peers.at(fd).recv(buf, sizeof(buf), Recv::NONE,
+                                                 &errorNB);
+            if (errorNB) {
+                return;
+            }
+            if (recvd <= 0) {
+                _reactor.remove(fd);
+                peers.erase(fd);
+                ++_served;
+                return;
+            }
+            peers.at(fd).send(buf, recvd, Send::NONE, &errorNB);
+            EXPECT_FALSE(errorNB);
+        });
+    });
+
+    EXPECT_EQ(_reactor.size(), 1u);
+    _reactor.run();
+    EXPECT_EQ(_reactor.size(), 1u);
+}
+}
+
+
+TEST(Reactor, EchoServer)
+{
+    Reactor reactor;
+    std::size_t served = 0;
+    std::thread serverThread(reactorTest::startEchoServerIPv4,
+                             std::ref(reactor), std::ref(served));
+    std::this_thread::sleep_for(1s);
+
+    {
+        Socket client1(Domain::IPv4, Type::TCP);
+        Socket client2(Domain::IPv4, Type::TCP);
+        client1.connect("127.0.0.1", 21050);
+        client2.connect("127.0.0.1", 21050);
+
+        client1.send(reactorTest::msg1);
+        client2.send(reactorTest::msg2);
+
+        char buf[64];
+        auto recvd
+          = client2.recv(buf, reactorTest::msg2.size(), Recv::WAITALL);
+        EXPECT_EQ(std::string(buf, recvd), reactorTest::msg2);
+        recvd = client1.recv(buf, reactorTest::msg1.size(), Recv::WAITALL);
+        EXPECT_EQ(std::string(buf, recvd), reactorTest::msg1);
+    }
+    std::this_thread::sleep_for(1s);
+
+    reactor.stop();
+    serverThread.join();
+    EXPECT_EQ(served, 2u);
+}
+
+
+TEST(Reactor, EdgeTriggered)
+{
+    Reactor reactor;
+    std::size_t wakeups = 0;
+
+    Socket server(Domain::IPv4, Type::TCP);
+    server.start("127.0.0.1", 21051);
+    Socket client(Domain::IPv4, Type::TCP);
+    client.connect("127.0.0.1", 21051);
+    const auto peer = server.accept();
+
+    reactor.add(peer, Event::READ | Event::EDGE, [&](Event) { ++wakeups; });
+    EXPECT_EQ(reactor.poll(0), 0u);
+
+    client.send(reactorTest::msg1);
+    EXPECT_EQ(reactor.poll(1000), 1u);
+
+    // Not drained, yet no new data means no new edge.
+    EXPECT_EQ(reactor.poll(100), 0u);
+    EXPECT_EQ(wakeups, 1u);
+
+    reactor.modify(peer, Event::READ);
+    EXPECT_EQ(reactor.poll(0), 1u);
+    EXPECT_EQ(reactor.poll(0), 1u);
+    EXPECT_EQ(wakeups, 3u);
+
+    reactor.remove(peer);
+    EXPECT_EQ(reactor.size(), 0u);
+    EXPECT_EQ(reactor.poll(0), 0u);
+
+    // Close the client side first to keep the server port out of TIME_WAIT.
+    client.stop(Shut::READWRITE);
+    std::this_thread::sleep_for(100ms);
+}
+
+
+TEST(Reactor, DescriptorReusedInBatch)
+{
+    Reactor reactor;
+
+    std::unique_ptr<Socket> sockets[2];
+    for (auto i = 0; i < 2; ++i) {
+        sockets[i] = std::make_unique<Socket>(Domain::IPv4, Type::UDP);
+        sockets[i]->start("127.0.0.1", 21052 + i);
+    }
+
+    // Whichever callback runs first closes the other Socket and registers
+    // a new one, which gets the same descriptor.
+    auto fired    = 0;
+    auto reopened = 0;
+    for (auto i = 0; i < 2; ++i) {
+        reactor.add(*sockets[i], Event::READ, [&, i](Event) {
+            if (fired++ > 0) {
+                return;
+            }
+
+            auto &other   = sockets[1 - i];
+            const auto fd = other->getSocket();
+            reactor.remove(*other);
+            other.reset();
+            other = std::make_unique<Socket>(Domain::IPv4, Type::UDP);
+            EXPECT_EQ(other->getSocket(), fd);
+            reactor.add(*other, Event::READ, [&](Event) { ++reopened; });
+        });
+    }
+
+    Socket client(Domain::IPv4, Type::UDP);
+    for (auto i = 0; i < 2; ++i) {
+        client.send(reactorTest::msg1, [i](AddrIPv4 &s) {
+            return methods::construct(s, "127.0.0.1", 21052 + i);
+        });
+    }
+    std::this_thread::sleep_for(50ms);
+
+    // The event of the closed Socket is not handed to the new one.
+    EXPECT_EQ(reactor.poll(1000), 1u);
+    EXPECT_EQ(fired, 1);
+    EXPECT_EQ(reopened, 0);
+    EXPECT_EQ(reactor.size(), 2u);
+}
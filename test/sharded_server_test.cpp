@@ -0,0 +1,68 @@
+#include "sharded_server.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <string>
+
+using namespace net;
+using namespace std::chrono_literals;
+
+
+namespace shardedServerTest {
+
+const std::string msg("shardedServerTest::msg");
+const auto clients = 20;
+
+std::atomic<int> accepted(0);
+std::atomic<int> shardsSetUp(0);
+}
+
+
+TEST(ShardedServer, AcceptOnAllShards)
+{
+    ShardedServer server(Domain::IPv4, "127.0.0.1", 21070, 2);
+    EXPECT_EQ(server.size(), 2u);
+
+    std::thread serverThread([&] {
+        server.run([](Reactor &r, Socket &s, std::size_t) {
+            ++shardedServerTest::shardsSetUp;
+            r.add(s, Event::READ, [&s](Event) {
+                auto errorNB    = false;
+                const auto peer = s.accept(&errorNB);
+                if (!errorNB) {
+                    ++shardedServerTest::accepted;
+                    peer.send(shardedServerTest::msg);
+                }
+            });
+        });
+    });
+    std::this_thread::sleep_for(1s);
+    EXPECT_EQ(shardedServerTest::shardsSetUp, 2);
+
+    for (auto i = 0; i < shardedServerTest::clients; ++i) {
+        Socket client(Domain::IPv4, Type::TCP);
+        client.connect("127.0.0.1", 21070);
+
+        char buf[64];
+        const auto recvd = client.recv(buf, shardedServerTest::msg.size(),
+                                       Recv::WAITALL);
+        EXPECT_EQ(std::string(buf, recvd), shardedServerTest::msg);
+    }
+    EXPECT_EQ(shardedServerTest::accepted, shardedServerTest::clients);
+
+    server.stop();
+    serverThread.join();
+}
+
+
+TEST(ShardedServer, WorkerErrorStopsAll)
+{
+    ShardedServer server(Domain::IPv4, "127.0.0.1", 21071, 3, false);
+
+    const auto setup = [](Reactor &, Socket &, std::size_t i) {
+        if (i == 1) {
+            throw std::runtime_error("shard failed");
+        }
+    };
+    EXPECT_THROW(server.run(setup), std::runtime_error);
+}
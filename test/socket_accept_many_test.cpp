@@ -0,0 +1,64 @@
+#include "socket.hpp"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include <fcntl.h>
+}
+
+using namespace net;
+using namespace std::chrono_literals;
+
+
+TEST(Socket, AcceptMany)
+{
+    Socket server(Domain::IPv4, Type::TCP);
+    server.start("127.0.0.1", 21080);
+    server.setNonBlocking();
+
+    std::vector<Socket> peers;
+    EXPECT_EQ(server.acceptMany(peers), 0u);
+
+    std::vector<Socket> clients;
+    for (auto i = 0; i < 5; ++i) {
+        clients.emplace_back(Domain::IPv4, Type::TCP);
+        clients.back().connect("127.0.0.1", 21080);
+    }
+    std::this_thread::sleep_for(100ms);
+
+    EXPECT_EQ(server.acceptMany(peers, true, 2), 2u);
+    EXPECT_EQ(server.acceptMany(peers, false), 3u);
+    ASSERT_EQ(peers.size(), 5u);
+
+    for (const auto &p : peers) {
+        const auto fd = p.getSocket();
+        EXPECT_TRUE(fcntl(fd, F_GETFL) & O_NONBLOCK);
+        EXPECT_TRUE(fcntl(fd, F_GETFD) & FD_CLOEXEC);
+
+        char buf[8];
+        auto errorNB = false;
+        p.recv(buf, sizeof(buf), Recv::NONE, &errorNB);
+        EXPECT_TRUE(errorNB);
+    }
+
+    clients[0].send("ping");
+    std::this_thread::sleep_for(100ms);
+
+    // Every client is paired with exactly one of the peers.
+    auto recvd = 0;
+    for (const auto &p : peers) {
+        char buf[8];
+        auto errorNB = false;
+        if (p.recv(buf, sizeof(buf), Recv::NONE, &errorNB) == 4) {
+            ++recvd;
+        }
+    }
+    EXPECT_EQ(recvd, 1);
+
+    // Close the client side first to keep the server port out of TIME_WAIT.
+    for (const auto &c : clients) {
+        c.stop(Shut::READWRITE);
+    }
+    std::this_thread::sleep_for(100ms);
+}
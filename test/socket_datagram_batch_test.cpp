@@ -0,0 +1,67 @@
+#include "socket.hpp"
+#include <gtest/gtest.h>
+#include <thread>
+#include <string>
+#include <vector>
+
+using namespace net;
+using namespace std::chrono_literals;
+
+
+namespace batchTest {
+
+const auto numMsgs = 8u;
+
+void startUDPServerIPv4()
+{
+    Socket server(Domain::IPv4, Type::UDP);
+    server.start("127.0.0.1", 21030);
+
+    DatagramBatch<AddrIPv4> batch(16, 64);
+    std::vector<std::string> recvd;
+
+    while (recvd.size() < numMsgs) {
+        server.recvmmsg(batch);
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            recvd.push_back(batch.payload(i).str());
+            EXPECT_EQ(batch.addr(i).sin_port, htons(21031));
+            EXPECT_EQ(batch.addr(i).sin_addr.s_addr, htonl(INADDR_LOOPBACK));
+        }
+    }
+
+    for (auto i = 0u; i < numMsgs; ++i) {
+        EXPECT_EQ(recvd[i], "msg" + std::to_string(i));
+    }
+}
+}
+
+
+TEST(Socket, DatagramBatch)
+{
+    std::thread serverThread(batchTest::startUDPServerIPv4);
+    std::this_thread::sleep_for(1s);
+
+    Socket client(Domain::IPv4, Type::UDP);
+    client.start("127.0.0.1", 21031);
+
+    std::vector<std::string> msgs;
+    for (auto i = 0u; i < batchTest::numMsgs; ++i) {
+        msgs.push_back("msg" + std::to_string(i));
+    }
+
+    DatagramBatch<AddrIPv4> batch(batchTest::numMsgs);
+    for (const auto &msg : msgs) {
+        EXPECT_TRUE(batch.push(msg, [](AddrIPv4 &s) {
+            return methods::construct(s, "127.0.0.1", 21030);
+        }));
+    }
+    EXPECT_FALSE(batch.push(msgs[0], batch.addr(0)));
+    EXPECT_THROW(DatagramBatch<AddrIPv4>(1).push(msgs[0], [](AddrIPv4 &s) {
+        return methods::construct(s, "not an ip", 21030);
+    }),
+                 std::invalid_argument);
+
+    EXPECT_EQ(client.sendmmsg(batch), batchTest::numMsgs);
+
+    serverThread.join();
+}
@@ -298,3 +298,37 @@ TEST(SocketOptions, NODELAY)
     const auto opt2 = s.getOpt(Opt::NODELAY);
     ASSERT_EQ(0, opt2);
 }
+
+
+TEST(SocketOptions, REUSEADDR)
+{
+    // Shares its number with TCP_MAXSEG, but is a SOL_SOCKET option.
+    Socket s(Domain::IPv4, Type::TCP);
+
+    int optval;
+    socklen_t optlen = sizeof(optval);
+
+    SockOpt opt(1);
+    s.setOpt(Opt::REUSEADDR, opt);
+    ASSERT_EQ(
+      0, getsockopt(s.getSocket(), SOL_SOCKET, SO_REUSEADDR, &optval, &optlen));
+    ASSERT_EQ(1, optval);
+
+    const auto opt2 = s.getOpt(Opt::REUSEADDR);
+    ASSERT_EQ(1, opt2);
+}
+
+
+TEST(SocketOptions, REUSEPORT)
+{
+    Socket s(Domain::IPv4, Type::TCP);
+
+    int optval;
+    socklen_t optlen = sizeof(optval);
+
+    SockOpt opt(1);
+    s.setOpt(Opt::REUSEPORT, opt);
+    ASSERT_EQ(
+      0, getsockopt(s.getSocket(), SOL_SOCKET, SO_REUSEPORT, &optval, &optlen));
+    ASSERT_EQ(1, optval);
+}
@@ -0,0 +1,110 @@
+#include "socket.hpp"
+#include <gtest/gtest.h>
+#include <thread>
+#include <string>
+#include <array>
+
+using namespace net;
+using namespace std::chrono_literals;
+
+
+namespace recvBufferTest {
+
+const std::string msg1("recvBufferTest::msg1");
+const std::string msg2("recvBufferTest::msg2");
+const std::string unixServerPath("/tmp/unixServerPath30");
+const std::string unixClientPath("/tmp/unixClientPath30");
+
+void startTCPServerIPv4()
+{
+    Socket server(Domain::IPv4, Type::TCP);
+    server.start("127.0.0.1", 21000);
+    const auto peer = server.accept();
+
+    std::array<char, 64> buf;
+    auto recvd = peer.recv(buf.data(), msg1.size());
+    EXPECT_EQ(std::string(buf.data(), recvd), msg1);
+
+    std::string reused;
+    recvd = peer.read(reused, msg2.size());
+    EXPECT_EQ(recvd, static_cast<ssize_t>(msg2.size()));
+    EXPECT_EQ(reused, msg2);
+
+    peer.write(msg1);
+    peer.write(msg2);
+    std::this_thread::sleep_for(1s);
+}
+
+void startUDPServerIPv4()
+{
+    Socket server(Domain::IPv4, Type::UDP);
+    server.start("127.0.0.1", 21000);
+
+    std::array<char, 64> buf;
+    const auto recvd
+      = server.recv(buf.data(), buf.size(), [](AddrIPv4 &s) {
+            EXPECT_EQ(s.sin_addr.s_addr, htonl(INADDR_LOOPBACK));
+        });
+    EXPECT_EQ(std::string(buf.data(), recvd), msg1);
+}
+
+void startUNIXServerUDP()
+{
+    Socket server(Domain::UNIX, Type::UDP);
+    server.start(unixServerPath.c_str());
+
+    std::string reused;
+    reused.reserve(64);
+    const auto capacity = reused.capacity();
+
+    const auto recvd = server.recv(reused, 64, [](AddrUnix &s) {
+        EXPECT_EQ(std::string(s.sun_path), unixClientPath);
+    });
+    EXPECT_EQ(recvd, static_cast<ssize_t>(msg2.size()));
+    EXPECT_EQ(reused, msg2);
+    EXPECT_EQ(reused.capacity(), capacity);
+}
+}
+
+
+TEST(Socket, RecvIntoBuffer)
+{
+    std::thread tcpServerThread(recvBufferTest::startTCPServerIPv4);
+    std::thread udpServerThread(recvBufferTest::startUDPServerIPv4);
+    std::thread unixServerThread(recvBufferTest::startUNIXServerUDP);
+    std::this_thread::sleep_for(1s);
+
+    Socket tcpClient(Domain::IPv4, Type::TCP);
+    tcpClient.connect("127.0.0.1", 21000);
+    tcpClient.send(recvBufferTest::msg1);
+    std::this_thread::sleep_for(100ms);
+    tcpClient.send(recvBufferTest::msg2);
+
+    std::string reused;
+    reused.reserve(64);
+    const auto capacity = reused.capacity();
+
+    EXPECT_EQ(tcpClient.recv(reused, recvBufferTest::msg1.size()),
+              static_cast<ssize_t>(recvBufferTest::msg1.size()));
+    EXPECT_EQ(reused, recvBufferTest::msg1);
+    EXPECT_EQ(tcpClient.recv(reused, recvBufferTest::msg2.size()),
+              static_cast<ssize_t>(recvBufferTest::msg2.size()));
+    EXPECT_EQ(reused, recvBufferTest::msg2);
+    EXPECT_EQ(reused.capacity(), capacity);
+
+    Socket udpClient(Domain::IPv4, Type::UDP);
+    EXPECT_NO_THROW(udpClient.send(recvBufferTest::msg1, [](AddrIPv4 &s) {
+        return methods::construct(s, "127.0.0.1", 21000);
+    }));
+
+    Socket unixClient(Domain::UNIX, Type::UDP);
+    unixClient.start(recvBufferTest::unixClientPath.c_str());
+    EXPECT_NO_THROW(unixClient.send(recvBufferTest::msg2, [](AddrUnix &s) {
+        return methods::construct(s, recvBufferTest::unixServerPath.c_str());
+    }));
+
+    tcpServerThread.join();
+    udpServerThread.join();
+    unixServerThread.join();
+}
+
@@ -82,6 +82,24 @@ void startTCPServerIPv4()
     tcpServerProcessing(myServerSocket);
 }
 
+void startBufferServerIPv4()
+{
+    Socket myServerSocket(Domain::IPv4, Type::TCP);
+    myServerSocket.start("127.0.0.1", 21010);
+    const auto peer = myServerSocket.accept();
+
+    std::string recvd;
+    std::string msg;
+    while (recvd.size() < 3 * sendTest::msgLen) {
+        peer.read(msg, 4096);
+        recvd += msg;
+    }
+    EXPECT_EQ(recvd, sendTest::someString + sendTest::someString
+                + sendTest::someString);
+    peer.write("ok");
+    std::this_thread::sleep_for(1s);
+}
+
 void startUDPServerIPv6()
 {
     Socket myServerSocket(Domain::IPv6, Type::UDP);
@@ -153,4 +171,21 @@ TEST(Socket, IPv6Send)
     tcpServerThreadIPv6.join();
     udpServerThreadIPv6.join();
 }
+
+TEST(Socket, SendBuffer)
+{
+    std::thread tcpServerThread(startBufferServerIPv4);
+    std::this_thread::sleep_for(1s);
+
+    const auto &str = sendTest::someString;
+
+    Socket tcpClient(Domain::IPv4, Type::TCP);
+    tcpClient.connect("127.0.0.1", 21010);
+    EXPECT_NO_THROW(tcpClient.write(str.data(), str.size()));
+    EXPECT_NO_THROW(tcpClient.send(str.data(), str.size(), Send::NOSIGNAL));
+    EXPECT_NO_THROW(tcpClient.send(StringView(str.data(), str.size())));
+    EXPECT_EQ(tcpClient.read(2), "ok");
+
+    tcpServerThread.join();
+}
 }
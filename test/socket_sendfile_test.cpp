@@ -0,0 +1,129 @@
+#include "socket.hpp"
+#include <gtest/gtest.h>
+#include <thread>
+#include <string>
+#include <cstdlib>
+
+using namespace net;
+using namespace std::chrono_literals;
+
+
+namespace sendFileTest {
+
+const std::string unixServerPath("/tmp/unixServerPath50");
+const std::string unixProxyPath("/tmp/unixServerPath51");
+
+std::string content()
+{
+    std::string str(3 * 1024 * 1024 + 17, ' ');
+    for (std::size_t i = 0; i < str.size(); ++i) {
+        str[i] = 'a' + (i * 7) % 26;
+    }
+    return str;
+}
+
+int tempFile()
+{
+    char path[] = "/tmp/netSendFileXXXXXX";
+    const auto fd = mkstemp(path);
+    ::unlink(path);
+    return fd;
+}
+
+std::string readAll(const Socket &_peer, const std::size_t _len)
+{
+    std::string res, chunk;
+    while (res.size() < _len && _peer.read(chunk, 65536) > 0) {
+        res += chunk;
+    }
+    return res;
+}
+
+std::string readFile(const int _fd, const std::size_t _len)
+{
+    std::string res(_len, ' ');
+    EXPECT_EQ(pread(_fd, &res[0], _len, 0), static_cast<ssize_t>(_len));
+    return res;
+}
+
+void startUNIXServerTCP()
+{
+    const auto str = content();
+
+    Socket server(Domain::UNIX, Type::TCP);
+    server.start(unixServerPath.c_str());
+
+    // sendFile: the client receives the file sent from an offset.
+    const auto peer1 = server.accept();
+    EXPECT_EQ(readAll(peer1, str.size() - 10), str.substr(10));
+
+    // splice socket to file.
+    const auto peer2 = server.accept();
+    const auto out   = tempFile();
+    Pipe pipe;
+    std::size_t moved = 0;
+    while (moved < str.size()) {
+        const auto res = peer2.splice(pipe, out, str.size() - moved);
+        if (res == 0) {
+            break;
+        }
+        moved += res;
+    }
+    EXPECT_EQ(moved, str.size());
+    EXPECT_EQ(pipe.pending(), 0u);
+    EXPECT_EQ(readFile(out, str.size()), str);
+    ::close(out);
+
+    // splice socket to socket.
+    const auto peer3 = server.accept();
+    Socket proxy(Domain::UNIX, Type::TCP);
+    proxy.connect(unixProxyPath.c_str());
+    moved = 0;
+    while (moved < str.size()) {
+        moved += peer3.splice(pipe, proxy, str.size() - moved);
+    }
+    EXPECT_EQ(moved, str.size());
+    std::this_thread::sleep_for(1s);
+}
+
+void startUNIXProxyTarget()
+{
+    const auto str = content();
+
+    Socket server(Domain::UNIX, Type::TCP);
+    server.start(unixProxyPath.c_str());
+    const auto peer = server.accept();
+    EXPECT_EQ(readAll(peer, str.size()), str);
+}
+}
+
+
+TEST(Socket, SendFileAndSplice)
+{
+    const auto str = sendFileTest::content();
+    const auto fd  = sendFileTest::tempFile();
+    ASSERT_EQ(::write(fd, str.data(), str.size()),
+              static_cast<ssize_t>(str.size()));
+
+    std::thread serverThread(sendFileTest::startUNIXServerTCP);
+    std::thread proxyThread(sendFileTest::startUNIXProxyTarget);
+    std::this_thread::sleep_for(1s);
+
+    Socket client1(Domain::UNIX, Type::TCP);
+    client1.connect(sendFileTest::unixServerPath.c_str());
+    EXPECT_EQ(client1.sendFile(fd, 10, str.size()), str.size() - 10);
+    client1.close();
+
+    Socket client2(Domain::UNIX, Type::TCP);
+    client2.connect(sendFileTest::unixServerPath.c_str());
+    EXPECT_EQ(client2.sendFile(fd, 0, str.size()), str.size());
+    client2.close();
+
+    Socket client3(Domain::UNIX, Type::TCP);
+    client3.connect(sendFileTest::unixServerPath.c_str());
+    client3.write(str);
+
+    serverThread.join();
+    proxyThread.join();
+    ::close(fd);
+}
@@ -0,0 +1,155 @@
+#include "socket.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+
+using namespace net;
+using namespace std::chrono_literals;
+
+
+TEST(SocketStats, Record)
+{
+    SocketStats stats;
+    stats.record(StatOp::WRITE, 10, 0, true, 200ns);
+    stats.record(StatOp::WRITE, -1, EAGAIN, false, 100ns);
+    stats.record(StatOp::CONNECT, -1, EINPROGRESS, false, 100ns);
+    stats.record(StatOp::ACCEPT, 7, 0, false, 100ns);
+    stats.record(StatOp::READ, -1, ECONNRESET, false, 100ns);
+
+    const auto &w = stats[StatOp::WRITE];
+    EXPECT_EQ(w.calls.get(), 2u);
+    EXPECT_EQ(w.bytes.get(), 10u);
+    EXPECT_EQ(w.wouldBlock.get(), 1u);
+    EXPECT_EQ(w.partial.get(), 1u);
+    EXPECT_EQ(w.latency.count(), 2u);
+
+    EXPECT_EQ(stats[StatOp::CONNECT].wouldBlock.get(), 1u);
+    EXPECT_EQ(stats[StatOp::ACCEPT].bytes.get(), 0u);
+    EXPECT_EQ(stats[StatOp::READ].errors.get(), 1u);
+
+    SocketStats copy(stats);
+    copy.merge(stats);
+    EXPECT_EQ(copy[StatOp::WRITE].calls.get(), 4u);
+
+    stats.reset();
+    EXPECT_EQ(stats[StatOp::WRITE].calls.get(), 0u);
+}
+
+
+#ifdef NET_SOCKET_STATS
+
+TEST(SocketStats, CountsSocketCalls)
+{
+    SocketStats::local().reset();
+
+    Socket server(Domain::IPv4, Type::TCP);
+    server.setOpt(Opt::REUSEADDR, SockOpt(1));
+    server.start("127.0.0.1", 21150);
+
+    SocketStats clientStats;
+    Socket client(Domain::IPv4, Type::TCP);
+    client.attachStats(&clientStats);
+    client.connect("127.0.0.1", 21150);
+
+    const auto peer = server.accept();
+    client.send("hello");
+
+    char buf[16];
+    EXPECT_EQ(peer.recv(buf, sizeof(buf)), 5);
+
+    auto errorNB = false;
+    peer.setNonBlocking();
+    peer.recv(buf, sizeof(buf), Recv::NONE, &errorNB);
+    EXPECT_TRUE(errorNB);
+
+    const auto &local = SocketStats::local();
+    EXPECT_EQ(local[StatOp::CONNECT].calls.get(), 1u);
+    EXPECT_EQ(local[StatOp::ACCEPT].calls.get(), 1u);
+    EXPECT_EQ(local[StatOp::WRITE].bytes.get(), 5u);
+    EXPECT_EQ(local[StatOp::READ].calls.get(), 2u);
+    EXPECT_EQ(local[StatOp::READ].bytes.get(), 5u);
+    EXPECT_EQ(local[StatOp::READ].wouldBlock.get(), 1u);
+    EXPECT_EQ(local[StatOp::READ].latency.count(), 2u);
+
+    // Only the calls of the client.
+    EXPECT_EQ(clientStats[StatOp::CONNECT].calls.get(), 1u);
+    EXPECT_EQ(clientStats[StatOp::WRITE].calls.get(), 1u);
+    EXPECT_EQ(clientStats[StatOp::READ].calls.get(), 0u);
+}
+
+
+TEST(SocketStats, CountsBatchedCalls)
+{
+    SocketStats serverStats;
+    Socket server(Domain::IPv4, Type::UDP);
+    server.attachStats(&serverStats);
+    server.setOpt(Opt::REUSEADDR, SockOpt(1));
+    server.start("127.0.0.1", 21152);
+
+    SocketStats clientStats;
+    Socket client(Domain::IPv4, Type::UDP);
+    client.attachStats(&clientStats);
+
+    AddrIPv4 to{};
+    to.sin_family      = AF_INET;
+    to.sin_port        = htons(21152);
+    to.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    DatagramBatch<AddrIPv4> out(4);
+    for (const auto msg : {"ab", "cde", "f"}) {
+        out.push(msg, to);
+    }
+    EXPECT_EQ(client.sendmmsg(out), 3u);
+    EXPECT_EQ(clientStats[StatOp::WRITE].calls.get(), 1u);
+    EXPECT_EQ(clientStats[StatOp::WRITE].bytes.get(), 6u);
+
+    DatagramBatch<AddrIPv4> in(4, 64);
+    EXPECT_EQ(server.recvmmsg(in), 3u);
+    EXPECT_EQ(serverStats[StatOp::READ].calls.get(), 1u);
+    EXPECT_EQ(serverStats[StatOp::READ].bytes.get(), 6u);
+
+    char buf[8];
+    iovec iov{buf, sizeof(buf)};
+    auto errorNB = false;
+    server.setNonBlocking();
+    server.readv(&iov, 1, &errorNB);
+    EXPECT_TRUE(errorNB);
+    server.recvmsg(&iov, 1, Recv::NONE, &errorNB);
+    EXPECT_EQ(serverStats[StatOp::READ].calls.get(), 3u);
+    EXPECT_EQ(serverStats[StatOp::READ].wouldBlock.get(), 2u);
+}
+
+
+TEST(SocketStats, TotalKeepsExitedThreads)
+{
+    const auto before = SocketStats::total()[StatOp::WRITE].calls.get();
+
+    Socket server(Domain::IPv4, Type::UDP);
+    server.setOpt(Opt::REUSEADDR, SockOpt(1));
+    server.start("127.0.0.1", 21151);
+
+    std::thread([] {
+        Socket s(Domain::IPv4, Type::UDP);
+        s.connect("127.0.0.1", 21151);
+        s.send("x");
+        s.send("y");
+    }).join();
+
+    EXPECT_EQ(SocketStats::total()[StatOp::WRITE].calls.get(), before + 2);
+}
+
+#else
+
+TEST(SocketStats, DisabledRecordsNothing)
+{
+    Socket s(Domain::IPv4, Type::UDP);
+    SocketStats stats;
+    s.attachStats(&stats);
+    s.connect("127.0.0.1", 21151);
+    s.send("x");
+
+    EXPECT_EQ(SocketStats::total()[StatOp::WRITE].calls.get(), 0u);
+    EXPECT_EQ(stats[StatOp::WRITE].calls.get(), 0u);
+}
+
+#endif
@@ -0,0 +1,99 @@
+#include "socket.hpp"
+#include <gtest/gtest.h>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace net;
+using namespace std::chrono_literals;
+
+
+TEST(IoResult, Outcome)
+{
+    const IoResult sent(5);
+    EXPECT_TRUE(sent.ok());
+    EXPECT_EQ(sent.bytes(), 5u);
+    EXPECT_EQ(sent.errorNumber(), 0);
+    EXPECT_FALSE(sent.error());
+
+    const auto failed = IoResult::fromErrno(ECONNRESET);
+    EXPECT_FALSE(failed);
+    EXPECT_EQ(failed.bytes(), 0u);
+    EXPECT_FALSE(failed.wouldBlock());
+    EXPECT_EQ(failed.error(), std::errc::connection_reset);
+
+    EXPECT_TRUE(IoResult::fromErrno(EAGAIN).wouldBlock());
+    EXPECT_TRUE(IoResult::fromErrno(EINPROGRESS).inProgress());
+}
+
+
+TEST(Socket, TryCalls)
+{
+    Socket server(Domain::IPv4, Type::TCP);
+    server.start("127.0.0.1", 21090);
+    server.setNonBlocking();
+
+    IoResult res;
+    const auto none = server.tryAccept(res);
+    EXPECT_TRUE(res.wouldBlock());
+    EXPECT_EQ(none.getSocket(), -1);
+
+    Socket client(Domain::IPv4, Type::TCP);
+    EXPECT_TRUE(client.tryConnect("127.0.0.1", 21090));
+    std::this_thread::sleep_for(100ms);
+
+    const auto peer = server.tryAccept(res);
+    ASSERT_TRUE(res);
+    EXPECT_NE(peer.getSocket(), -1);
+
+    char buf[16];
+    peer.setNonBlocking();
+    EXPECT_TRUE(peer.tryRecv(buf, sizeof(buf)).wouldBlock());
+
+    EXPECT_EQ(client.trySend("hello").bytes(), 5u);
+    std::this_thread::sleep_for(100ms);
+
+    res = peer.tryRecv(buf, sizeof(buf));
+    ASSERT_EQ(res.bytes(), 5u);
+    EXPECT_EQ(std::string(buf, res.bytes()), "hello");
+
+    client.stop(Shut::READWRITE);
+    std::this_thread::sleep_for(100ms);
+    res = peer.tryRecv(buf, sizeof(buf));
+    EXPECT_TRUE(res.ok());
+    EXPECT_EQ(res.bytes(), 0u);
+}
+
+
+TEST(Socket, TryConnectErrors)
+{
+    Socket s(Domain::IPv4, Type::TCP);
+    EXPECT_EQ(s.tryConnect("127.0.0.1", 21091).error(),
+              std::errc::connection_refused);
+
+    Socket t(Domain::IPv4, Type::TCP);
+    EXPECT_EQ(t.tryConnect("not an address", 21091).error(),
+              std::errc::invalid_argument);
+
+    char buf[4];
+    EXPECT_EQ(t.tryRecv(buf, sizeof(buf)).error(), std::errc::not_connected);
+}
+
+
+TEST(Methods, GetErrorMsgConcurrent)
+{
+    const auto expected = std::string(std::strerror(ECONNRESET));
+
+    std::vector<std::thread> threads;
+    for (auto i = 0; i < 4; ++i) {
+        threads.emplace_back([&] {
+            for (auto j = 0; j < 1000; ++j) {
+                EXPECT_EQ(net::methods::getErrorMsg(ECONNRESET), expected);
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+}
@@ -0,0 +1,159 @@
+#include "socket.hpp"
+#include <gtest/gtest.h>
+#include <thread>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+using namespace net;
+using namespace std::chrono_literals;
+
+
+namespace vectoredTest {
+
+const std::string header("HDR:");
+const std::string body(4 * 1024 * 1024, 'b');
+const std::string trailer("END");
+const std::string unixServerPath("/tmp/unixServerPath40");
+
+// Buffers left to write once _done bytes of _bufs are written.
+std::vector<StringView> remaining(const std::vector<StringView> &_bufs,
+                                  std::size_t _done)
+{
+    std::vector<StringView> left;
+    for (const auto &b : _bufs) {
+        if (_done >= b.size()) {
+            _done -= b.size();
+            continue;
+        }
+        left.push_back(b.substr(_done, b.size() - _done));
+        _done = 0;
+    }
+
+    return left;
+}
+
+void startUNIXServerTCP()
+{
+    Socket server(Domain::UNIX, Type::TCP);
+    server.start(unixServerPath.c_str());
+    const auto peer = server.accept();
+
+    // Read slowly so that the writer sees partial writes.
+    std::this_thread::sleep_for(200ms);
+
+    std::string recvd;
+    std::string chunk;
+    const auto total = 2 * (header.size() + body.size() + trailer.size());
+    while (recvd.size() < total) {
+        const auto left = std::min<std::size_t>(total - recvd.size(), 65536);
+        if (peer.read(chunk, left) <= 0) {
+            break;
+        }
+        recvd += chunk;
+    }
+
+    const auto expected = header + body + trailer;
+    EXPECT_EQ(recvd, expected + expected);
+
+    char hdr[4];
+    char rest[5];
+    const auto recvdMsg = peer.recvmsg({ { hdr, sizeof(hdr) },
+                                         { rest, sizeof(rest) } },
+                                       Recv::WAITALL);
+    EXPECT_EQ(recvdMsg, 4 + 5);
+    EXPECT_EQ(std::string(hdr, sizeof(hdr)), header);
+    EXPECT_EQ(std::string(rest, 5), "hello");
+
+    peer.writev({ header, "", "world" });
+    std::this_thread::sleep_for(1s);
+}
+}
+
+
+TEST(Socket, VectoredIO)
+{
+    std::thread serverThread(vectoredTest::startUNIXServerTCP);
+    std::this_thread::sleep_for(1s);
+
+    Socket client(Domain::UNIX, Type::TCP);
+    client.connect(vectoredTest::unixServerPath.c_str());
+
+    const auto size = vectoredTest::header.size() + vectoredTest::body.size()
+      + vectoredTest::trailer.size();
+    EXPECT_EQ(client.writev({ vectoredTest::header, vectoredTest::body,
+                              vectoredTest::trailer }),
+              size);
+
+    std::vector<StringView> bufs{ vectoredTest::header, vectoredTest::body,
+                                  StringView(), vectoredTest::trailer };
+    EXPECT_EQ(client.sendmsg(bufs.data(), bufs.size(), Send::NOSIGNAL), size);
+
+    EXPECT_EQ(client.sendmsg({ vectoredTest::header, "hel", "lo" }), 9u);
+
+    char hdr[4];
+    char rest[5];
+    std::this_thread::sleep_for(100ms);
+    EXPECT_EQ(client.readv({ { hdr, sizeof(hdr) }, { rest, sizeof(rest) } }),
+              9);
+    EXPECT_EQ(std::string(hdr, sizeof(hdr)) + std::string(rest, sizeof(rest)),
+              "HDR:world");
+
+    serverThread.join();
+}
+
+
+TEST(Socket, VectoredIONonBlocking)
+{
+    Socket server(Domain::IPv4, Type::TCP);
+    server.setOpt(Opt::REUSEADDR, SockOpt(1));
+    server.start("127.0.0.1", 21011);
+
+    Socket client(Domain::IPv4, Type::TCP);
+    client.setOpt(Opt::SNDBUF, SockOpt(64 * 1024));
+    client.connect("127.0.0.1", 21011);
+    const auto peer = server.accept();
+    client.setNonBlocking();
+
+    std::string body(vectoredTest::body.size(), '\0');
+    for (std::size_t i = 0; i < body.size(); ++i) {
+        body[i] = static_cast<char>(i % 251);
+    }
+    const std::vector<StringView> bufs{ vectoredTest::header, body,
+                                        vectoredTest::trailer };
+    const auto expected = vectoredTest::header + body + vectoredTest::trailer;
+
+    // Nothing is read yet, so the send buffer fills part way through.
+    bool errorNB = false;
+    auto written = client.writev(bufs.data(), bufs.size(), &errorNB);
+    EXPECT_TRUE(errorNB);
+    EXPECT_GT(written, 0u);
+    EXPECT_LT(written, expected.size());
+
+    std::string recvd;
+    std::thread reader([&] {
+        std::string chunk;
+        while (recvd.size() < expected.size()) {
+            if (peer.read(chunk, 65536) <= 0) {
+                break;
+            }
+            recvd += chunk;
+        }
+    });
+
+    // Resumed from the reported offset, alternating the two calls.
+    for (auto round = 0; written < expected.size(); ++round) {
+        const auto left = vectoredTest::remaining(bufs, written);
+        errorNB         = false;
+        written += (round % 2 == 0)
+          ? client.sendmsg(left.data(), left.size(), Send::NONE, &errorNB)
+          : client.writev(left.data(), left.size(), &errorNB);
+        if (errorNB) {
+            std::this_thread::sleep_for(1ms);
+        }
+    }
+    reader.join();
+
+    EXPECT_EQ(written, expected.size());
+    EXPECT_TRUE(recvd == expected);
+}
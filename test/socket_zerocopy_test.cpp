@@ -0,0 +1,126 @@
+#include "socket.hpp"
+#include <gtest/gtest.h>
+#include <thread>
+#include <string>
+
+using namespace net;
+using namespace std::chrono_literals;
+
+
+namespace zeroCopyTest {
+
+const std::string small("zeroCopyTest::small");
+const std::string large(64 * 1024, 'z');
+
+void startTCPServerIPv4()
+{
+    Socket server(Domain::IPv4, Type::TCP);
+    server.start("127.0.0.1", 21040);
+    const auto peer = server.accept();
+
+    std::string recvd(small.size() + large.size(), '\0');
+    std::size_t total = 0;
+    while (total < recvd.size()) {
+        const auto res = peer.read(&recvd[total], recvd.size() - total);
+        if (res <= 0) {
+            break;
+        }
+        total += res;
+    }
+    EXPECT_EQ(recvd, small + large);
+}
+}
+
+
+TEST(Socket, SendZeroCopy)
+{
+    std::thread tcpServerThread(zeroCopyTest::startTCPServerIPv4);
+    std::this_thread::sleep_for(1s);
+
+    Socket tcpClient(Domain::IPv4, Type::TCP);
+    tcpClient.connect("127.0.0.1", 21040);
+    EXPECT_NO_THROW(tcpClient.setOpt(Opt::ZEROCOPY, SockOpt(1)));
+
+    ZeroCopy zc;
+    EXPECT_EQ(zc.pending(), 0u);
+
+    const auto smallId = tcpClient.sendZeroCopy(zc, zeroCopyTest::small);
+    EXPECT_TRUE(zc.isComplete(smallId));
+    EXPECT_EQ(zc.pending(), 0u);
+
+    const auto largeId = tcpClient.sendZeroCopy(zc, zeroCopyTest::large);
+    EXPECT_GT(zc.pending(), 0u);
+
+    for (auto i = 0; i < 100 && !zc.isComplete(largeId); ++i) {
+        tcpClient.pollZeroCopy(zc);
+        std::this_thread::sleep_for(10ms);
+    }
+    EXPECT_TRUE(zc.isComplete(largeId));
+    EXPECT_EQ(zc.pending(), 0u);
+
+    tcpServerThread.join();
+}
+
+
+TEST(Socket, SendZeroCopyNonBlockingResume)
+{
+    std::string msg(4 * 1024 * 1024, '\0');
+    for (std::size_t i = 0; i < msg.size(); ++i) {
+        msg[i] = static_cast<char>(i % 251);
+    }
+
+    Socket server(Domain::IPv4, Type::TCP);
+    server.setOpt(Opt::REUSEADDR, SockOpt(1));
+    server.start("127.0.0.1", 21041);
+
+    Socket client(Domain::IPv4, Type::TCP);
+    client.setOpt(Opt::SNDBUF, SockOpt(64 * 1024));
+    client.connect("127.0.0.1", 21041);
+    client.setOpt(Opt::ZEROCOPY, SockOpt(1));
+    const auto peer = server.accept();
+    client.setNonBlocking();
+
+    // Nothing is read yet, so the send buffer fills part way through.
+    ZeroCopy zc(0);
+    bool errorNB     = false;
+    std::size_t sent = 0;
+    client.sendZeroCopy(zc, msg, Send::NONE, &errorNB, &sent);
+    EXPECT_TRUE(errorNB);
+    EXPECT_GT(sent, 0u);
+    EXPECT_LT(sent, msg.size());
+
+    std::string recvd;
+    std::thread reader([&] {
+        char buf[65536];
+        while (recvd.size() < msg.size()) {
+            const auto res = peer.read(buf, sizeof(buf));
+            if (res <= 0) {
+                break;
+            }
+            recvd.append(buf, res);
+        }
+    });
+
+    auto offset = sent;
+    while (offset < msg.size()) {
+        errorNB = false;
+        sent    = 0;
+        client.sendZeroCopy(zc, StringView(msg).substr(offset), Send::NONE,
+                            &errorNB, &sent);
+        offset += sent;
+        if (errorNB) {
+            client.pollZeroCopy(zc);
+            std::this_thread::sleep_for(1ms);
+        }
+    }
+    reader.join();
+    EXPECT_EQ(offset, msg.size());
+    EXPECT_TRUE(recvd == msg);
+
+    // A copied send names a send complete already.
+    ZeroCopy copying(-1);
+    const auto id
+      = client.sendZeroCopy(copying, "x", Send::NONE, &errorNB, &sent);
+    EXPECT_TRUE(copying.isComplete(id));
+    EXPECT_EQ(sent, 1u);
+}
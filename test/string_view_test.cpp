@@ -0,0 +1,39 @@
+#include "string_view.hpp"
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace net;
+
+
+TEST(StringView, Construct)
+{
+    const std::string str("hello world");
+    const char buf[] = { 'a', 'b', '\0', 'c' };
+
+    StringView fromString(str);
+    StringView fromCStr("hello");
+    StringView fromBuffer(buf, sizeof(buf));
+    StringView empty;
+
+    EXPECT_EQ(fromString.data(), str.data());
+    EXPECT_EQ(fromString.size(), str.size());
+    EXPECT_EQ(fromCStr.size(), 5u);
+    EXPECT_EQ(fromBuffer.size(), 4u);
+    EXPECT_EQ(fromBuffer[3], 'c');
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.str(), "");
+}
+
+
+TEST(StringView, SubstrAndCompare)
+{
+    const std::string str("hello world");
+    StringView view(str);
+
+    EXPECT_TRUE(view.substr(6) == StringView("world"));
+    EXPECT_TRUE(view.substr(0, 5) == StringView("hello"));
+    EXPECT_TRUE(view.substr(6, 100) == StringView("world"));
+    EXPECT_TRUE(view.substr(100).empty());
+    EXPECT_TRUE(view != StringView("hello"));
+    EXPECT_EQ(view.str(), str);
+}
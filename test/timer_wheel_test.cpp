@@ -0,0 +1,186 @@
+#include "reactor.hpp"
+#include "timer_wheel.hpp"
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+using namespace net;
+using namespace std::chrono_literals;
+
+
+TEST(TimerWheel, ExpiresInOrder)
+{
+    TimerWheel wheel;
+    std::vector<int> fired;
+
+    // Due in the first level, across the second and in the third.
+    const std::uint64_t delays[] = {70000, 1, 300, 255, 256, 65536, 5};
+    std::vector<std::unique_ptr<Timer>> timers;
+    for (const auto d : delays) {
+        timers.emplace_back(std::make_unique<Timer>(
+          [&fired, d] { fired.push_back(static_cast<int>(d)); }));
+        wheel.scheduleTicks(*timers.back(), d);
+    }
+    EXPECT_EQ(wheel.size(), 7u);
+
+    // Every timer fires exactly at its tick.
+    std::uint64_t now = 0;
+    for (const auto d : {1, 5, 255, 256, 300, 65536, 70000}) {
+        EXPECT_EQ(wheel.advance(d - now - 1), 0u) << d;
+        EXPECT_EQ(wheel.advance(1), 1u) << d;
+        ASSERT_FALSE(fired.empty());
+        EXPECT_EQ(fired.back(), d);
+        now = d;
+    }
+
+    EXPECT_EQ(fired.size(), 7u);
+    EXPECT_EQ(wheel.size(), 0u);
+    for (const auto &t : timers) {
+        EXPECT_FALSE(t->pending());
+    }
+}
+
+
+TEST(TimerWheel, CancelAndReschedule)
+{
+    TimerWheel wheel;
+    auto count = 0;
+    Timer a([&] { ++count; });
+    Timer b([&] { ++count; });
+
+    wheel.scheduleTicks(a, 10);
+    wheel.scheduleTicks(b, 1000);
+    EXPECT_TRUE(a.pending());
+
+    a.cancel();
+    EXPECT_FALSE(a.pending());
+    EXPECT_EQ(wheel.size(), 1u);
+    a.cancel();
+
+    // Rescheduling moves the timer, here from the second level to the first.
+    wheel.scheduleTicks(b, 20);
+    EXPECT_EQ(wheel.size(), 1u);
+    EXPECT_EQ(wheel.advance(19), 0u);
+    EXPECT_EQ(wheel.advance(1), 1u);
+    EXPECT_EQ(count, 1);
+    EXPECT_EQ(wheel.advance(2000), 0u);
+
+    {
+        Timer c([&] { ++count; });
+        wheel.scheduleTicks(c, 5);
+        EXPECT_EQ(wheel.size(), 1u);
+    }
+    EXPECT_EQ(wheel.size(), 0u);
+    EXPECT_EQ(wheel.advance(10), 0u);
+    EXPECT_EQ(count, 1);
+
+    // A zero delay still waits for the next tick.
+    wheel.scheduleTicks(a, 0);
+    EXPECT_EQ(wheel.advance(1), 1u);
+    EXPECT_EQ(count, 2);
+}
+
+
+TEST(TimerWheel, CallbacksReschedule)
+{
+    TimerWheel wheel;
+    auto count = 0;
+
+    Timer periodic;
+    periodic.setCallback([&] {
+        if (++count < 5) {
+            wheel.scheduleTicks(periodic, 100);
+        }
+    });
+    wheel.scheduleTicks(periodic, 100);
+    EXPECT_EQ(wheel.advance(1000), 5u);
+    EXPECT_EQ(count, 5);
+    EXPECT_FALSE(periodic.pending());
+
+    // A callback cancelling a timer due in the same tick, and one destroying
+    // its own timer.
+    Timer second([&] { ++count; });
+    Timer first;
+    first.setCallback([&] { second.cancel(); });
+    auto owned = std::make_unique<Timer>();
+    owned->setCallback([&] { owned.reset(); });
+
+    wheel.scheduleTicks(first, 3);
+    wheel.scheduleTicks(second, 3);
+    wheel.scheduleTicks(*owned, 3);
+    EXPECT_EQ(wheel.advance(3), 2u);
+    EXPECT_EQ(count, 5);
+    EXPECT_EQ(owned, nullptr);
+    EXPECT_EQ(wheel.size(), 0u);
+
+    // The callback is kept for the next expiry.
+    wheel.scheduleTicks(second, 1);
+    EXPECT_EQ(wheel.advance(1), 1u);
+    EXPECT_EQ(count, 6);
+}
+
+
+TEST(TimerWheel, DestroyedFirst)
+{
+    Timer t;
+    {
+        TimerWheel wheel;
+        wheel.scheduleTicks(t, 1);
+        EXPECT_TRUE(t.pending());
+    }
+    EXPECT_FALSE(t.pending());
+}
+
+
+TEST(TimerWheel, Reactor)
+{
+    Reactor reactor;
+    TimerWheel wheel(1ms);
+
+    const auto start = std::chrono::steady_clock::now();
+    auto elapsed     = std::chrono::steady_clock::duration::zero();
+
+    Timer idle([&] {
+        elapsed = std::chrono::steady_clock::now() - start;
+        reactor.stop();
+    });
+    wheel.schedule(idle, 20ms);
+
+    auto wakeups = 0;
+    reactor.add(wheel.fd(), Event::READ, [&](Event) {
+        ++wakeups;
+        wheel.expire();
+    });
+    reactor.run();
+
+    EXPECT_FALSE(idle.pending());
+    EXPECT_GE(elapsed, 19ms);
+    EXPECT_LT(elapsed, 1s);
+
+    // Armed for the deadline, not every tick.
+    EXPECT_EQ(wakeups, 1);
+}
+
+
+TEST(TimerWheel, WakesOnlyWhenDue)
+{
+    Reactor reactor;
+    TimerWheel wheel(1ms);
+
+    // Due past the first level, so the wheel wakes to cascade it as well.
+    Timer late([&] { reactor.stop(); });
+    wheel.schedule(late, 300ms);
+
+    auto wakeups = 0;
+    reactor.add(wheel.fd(), Event::READ, [&](Event) {
+        ++wakeups;
+        wheel.expire();
+    });
+
+    const auto start = std::chrono::steady_clock::now();
+    reactor.run();
+
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 299ms);
+    EXPECT_LE(wakeups, 3);
+    EXPECT_EQ(wheel.size(), 0u);
+}
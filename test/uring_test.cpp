@@ -0,0 +1,96 @@
+#include "uring.hpp"
+#include <gtest/gtest.h>
+#include <thread>
+#include <string>
+
+using namespace net;
+using namespace std::chrono_literals;
+
+
+namespace uringTest {
+
+const std::string msg1("uringTest::msg1");
+const std::string msg2("uringTest::msg2");
+
+enum : std::uint64_t { ACCEPT, RECV, SEND, CLOSE };
+
+void startEchoServerIPv4()
+{
+    Socket server(Domain::IPv4, Type::TCP);
+    server.start("127.0.0.1", 21060);
+
+    Uring ring(64);
+    ring.provideBuffers(8, 256);
+    ring.accept(server, ACCEPT);
+
+    auto fd     = -1;
+    auto closed = false;
+    std::string echoed;
+
+    while (!closed) {
+        ring.submit(1);
+        ring.complete([&](const Uring::Completion &c) {
+            switch (c.data) {
+                case ACCEPT:
+                    ASSERT_GE(c.res, 0);
+                    EXPECT_TRUE(c.more());
+                    fd = c.res;
+                    ring.recv(fd, RECV);
+                    break;
+
+                case RECV:
+                    if (c.res <= 0) {
+                        EXPECT_EQ(c.res, 0);
+                        ring.close(fd, CLOSE);
+                        break;
+                    }
+                    EXPECT_TRUE(c.hasBuffer());
+                    EXPECT_TRUE(c.more());
+                    echoed.assign(ring.buffer(c).data(), c.res);
+                    ring.recycle(c);
+                    ring.send(fd, echoed.data(), echoed.size(), SEND);
+                    break;
+
+                case SEND: EXPECT_GT(c.res, 0); break;
+
+                case CLOSE:
+                    EXPECT_EQ(c.res, 0);
+                    closed = true;
+                    break;
+            }
+        });
+    }
+}
+}
+
+
+TEST(Uring, EchoServer)
+{
+    std::thread serverThread(uringTest::startEchoServerIPv4);
+    std::this_thread::sleep_for(1s);
+
+    {
+        Socket client(Domain::IPv4, Type::TCP);
+        client.connect("127.0.0.1", 21060);
+
+        char buf[64];
+        client.send(uringTest::msg1);
+        auto recvd = client.recv(buf, uringTest::msg1.size(), Recv::WAITALL);
+        EXPECT_EQ(std::string(buf, recvd), uringTest::msg1);
+
+        client.send(uringTest::msg2);
+        recvd = client.recv(buf, uringTest::msg2.size(), Recv::WAITALL);
+        EXPECT_EQ(std::string(buf, recvd), uringTest::msg2);
+    }
+
+    serverThread.join();
+}
+
+
+TEST(Uring, ProvideBuffers)
+{
+    Uring ring;
+    EXPECT_THROW(ring.provideBuffers(3, 256), std::invalid_argument);
+    EXPECT_NO_THROW(ring.provideBuffers(4, 256));
+    EXPECT_THROW(ring.provideBuffers(4, 256), std::invalid_argument);
+}